@@ -0,0 +1,253 @@
+//! \file string_bench.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_STRING_BENCH_CPP_
+
+#include <scratch/random.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+
+namespace {
+
+// ScratchMUD types.
+using String = Scratch::String;
+using StringHashCi = Scratch::Algorithm::StringHashCi;
+using StringSetCi = Scratch::StringSetCi;
+template<class ValueT>
+using StringMapCi = Scratch::StringMapCi<ValueT>;
+template<class ValueT>
+using StringUnorderedMapCi = Scratch::StringUnorderedMapCi<ValueT>;
+
+//! The number of keys per suite.
+const std::size_t Keys = 1000;
+
+//! The number of passes over the keys per measurement.
+const std::size_t Passes = 2000;
+
+//! The number of keys held by the lookup tables.
+const std::size_t TableKeys = 200;
+
+//! Compares strings the way the scalar implementation did.
+//! \param left the first string to compare
+//! \param right the second string to compare
+//! \return < 0, 0, or > 0 as \p left orders before, with, or after
+//!     \p right
+//! \remark Reference for the vectorized StringCompareCi.
+int ScalarCompareCi(
+	const String& left,
+	const String& right) {
+    auto cmp = 0;
+    auto leftIt = std::begin(left), leftEnd = std::end(left);
+    auto rightIt = std::begin(right), rightEnd = std::end(right);
+    for (; !cmp && leftIt != leftEnd && rightIt != rightEnd; ++leftIt, ++rightIt) {
+	cmp = std::tolower(*leftIt) - std::tolower(*rightIt);
+    }
+    if (cmp)
+	return cmp;
+    if (leftIt == leftEnd && rightIt != rightEnd)
+	return -1;
+    if (leftIt != leftEnd && rightIt == rightEnd)
+	return +1;
+    return 0;
+}
+
+//! Tests a prefix the way the scalar implementation did.
+//! \param str the string to test
+//! \param prefix the prefix
+//! \remark Reference for the vectorized StringStartsWithCi.
+bool ScalarStartsWithCi(
+	const String& str,
+	const String& prefix) {
+    if (prefix.size() > str.size())
+	return false;
+    return ScalarCompareCi(str.substr(0, prefix.size()), prefix) == 0;
+}
+
+//! Case-insensitive weak order on the scalar reference.
+struct ScalarLessCi {
+    bool operator()(
+	const String& left,
+	const String& right) const {
+	return ScalarCompareCi(left, right) < 0;
+    }
+};
+
+//! Picks a value from zero to \p maximum inclusive.
+//! \param random the RNG state
+//! \param maximum the largest value to return
+std::size_t Pick(
+	Scratch::Math::Random& random,
+	const std::size_t maximum) {
+    return static_cast<std::size_t>(
+	random.Next(0, static_cast<int>(maximum)));
+}
+
+//! Makes \p count keys shaped like permission and preference names.
+//! \param random the RNG state
+//! \param count the number of keys
+std::vector<String> MakeKeys(
+	Scratch::Math::Random& random,
+	const std::size_t count) {
+    std::vector<String> keys;
+    keys.reserve(count);
+    for (std::size_t n = 0; n < count; ++n) {
+	String key("Permission.Category.Name_");
+	const auto length = Pick(random, 40);
+	for (std::size_t c = 0; c < length; ++c)
+	    key.push_back(static_cast<char>('a' + Pick(random, 25)));
+	keys.push_back(std::move(key));
+    }
+    return keys;
+}
+
+//! Returns \p keys with ASCII letters swapped to the other case.
+//! \param keys the keys
+std::vector<String> SwapCase(const std::vector<String>& keys) {
+    auto swapped = keys;
+    for (auto& key: swapped) {
+	for (auto& c: key) {
+	    if (std::isupper(static_cast<unsigned char>(c)))
+		c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+	    else
+		c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+	}
+    }
+    return swapped;
+}
+
+//! Times \p body over every key pair and prints the mean cost.
+//! \param label the row label
+//! \param body the measured call; returns a value folded into a sink
+//!     so it cannot be optimized away
+template <typename BodyT>
+void Measure(
+	const char* label,
+	BodyT body) {
+    long sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t pass = 0; pass < Passes; ++pass) {
+	for (std::size_t n = 0; n < Keys; ++n)
+	    sink += body(n);
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(
+	std::chrono::steady_clock::now() - start);
+    const auto ns = elapsed.count() / (Passes * Keys);
+    std::printf("  %-40s %8.1f ns  (%ld)\n", label, ns, sink);
+}
+
+//! Checks the vectorized primitives against the scalar reference.
+//! \param random the RNG state
+//! \return the number of disagreements
+std::size_t Verify(Scratch::Math::Random& random) {
+    // Bytes around the letter ranges, plus non-ASCII; 0xff is left out
+    // since std::tolower treats it as EOF.
+    static const char alphabet[] = "aAbBzZ@[`{\x80\xfe\xc3 09";
+    std::size_t failures = 0;
+    for (std::size_t n = 0; n < 200000; ++n) {
+	String left, right;
+	const auto leftSize = Pick(random, 70);
+	const auto rightSize = Pick(random, 70);
+	for (std::size_t c = 0; c < leftSize; ++c)
+	    left.push_back(alphabet[Pick(random, 15)]);
+	right = left.substr(0, std::min(leftSize, rightSize));
+	for (auto& c: right) {
+	    if (Pick(random, 3) == 0 &&
+		    std::isalpha(static_cast<unsigned char>(c)))
+		c = static_cast<char>(c ^ 0x20);
+	}
+	if (!right.empty() && Pick(random, 2) == 0)
+	    right[Pick(random, right.size() - 1)] =
+		alphabet[Pick(random, 15)];
+	while (right.size() < rightSize)
+	    right.push_back(alphabet[Pick(random, 15)]);
+
+	const auto expected = ScalarCompareCi(left, right);
+	if (expected != Scratch::Algorithm::StringCompareCi(left, right))
+	    ++failures;
+	if (ScalarStartsWithCi(left, right) !=
+		Scratch::Algorithm::StringStartsWithCi(left, right))
+	    ++failures;
+	if (!expected && StringHashCi()(left) != StringHashCi()(right))
+	    ++failures;
+    }
+    return failures;
+}
+
+} // namespace
+
+//! Program entry point.
+//! \return zero if the vectorized primitives match the scalar reference
+int main() {
+    // Fixed seed, so runs compare like for like.
+    Scratch::Math::Random random;
+    random.Seed(2026);
+
+    // Correctness first; a fast wrong answer is not a result.
+    const auto failures = Verify(random);
+    std::printf("verify: %zu disagreements with the scalar reference\n",
+	failures);
+    if (failures)
+	return EXIT_FAILURE;
+
+    const auto keys = MakeKeys(random, Keys);
+    const auto swapped = SwapCase(keys);
+
+    std::printf("compare, equal keys in opposite case:\n");
+    Measure("scalar StringCompareCi", [&](const std::size_t n) {
+	return ScalarCompareCi(keys[n], swapped[n]);
+    });
+    Measure("StringCompareCi", [&](const std::size_t n) {
+	return Scratch::Algorithm::StringCompareCi(keys[n], swapped[n]);
+    });
+
+    std::printf("prefix test, whole key:\n");
+    Measure("scalar StringStartsWithCi", [&](const std::size_t n) {
+	return ScalarStartsWithCi(keys[n], swapped[n]) ? 1 : 0;
+    });
+    Measure("StringStartsWithCi", [&](const std::size_t n) {
+	return Scratch::Algorithm::StringStartsWithCi(keys[n], swapped[n]) ?
+	    1 : 0;
+    });
+
+    std::printf("hash:\n");
+    Measure("StringHashCi", [&](const std::size_t n) {
+	return static_cast<long>(StringHashCi()(swapped[n]) & 1);
+    });
+
+    std::printf("lookup among %zu keys:\n", TableKeys);
+    std::map<String, int, ScalarLessCi> scalarMap;
+    StringMapCi<int> orderedMap;
+    StringUnorderedMapCi<int> unorderedMap;
+    for (std::size_t n = 0; n < TableKeys; ++n) {
+	scalarMap[keys[n]] = static_cast<int>(n);
+	orderedMap[keys[n]] = static_cast<int>(n);
+	unorderedMap[keys[n]] = static_cast<int>(n);
+    }
+    Measure("std::map, scalar compare", [&](const std::size_t n) {
+	return static_cast<long>(scalarMap.count(swapped[n]));
+    });
+    Measure("StringMapCi", [&](const std::size_t n) {
+	return static_cast<long>(orderedMap.count(swapped[n]));
+    });
+    Measure("StringUnorderedMapCi", [&](const std::size_t n) {
+	return static_cast<long>(unorderedMap.count(swapped[n]));
+    });
+
+    std::printf("delimiter set lookup by view:\n");
+    const StringSetCi delimiters = {"at", "from", "in", "on", "to", "with"};
+    Measure("StringSetCi, String key", [&](const std::size_t n) {
+	const auto word = Scratch::StringView(swapped[n]).substr(0, 4);
+	return static_cast<long>(
+	    delimiters.count(String(word.data(), word.size())));
+    });
+    Measure("StringSetCi, StringView key", [&](const std::size_t n) {
+	return static_cast<long>(
+	    delimiters.count(Scratch::StringView(swapped[n]).substr(0, 4)));
+    });
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+//! \file main.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_GATEWAY_MAIN_CPP_
+
+#include <scratch/logger.hpp>
+#include <scratch/relay.hpp>
+#include <scratch/scratch.hpp>
+
+namespace {
+
+// Boost types.
+using ErrorCode = boost::system::error_code;
+using IoContext = boost::asio::io_context;
+using SignalSet = boost::asio::signal_set;
+
+// ScratchMUD types.
+using Relay = Scratch::Net::Relay;
+using String = Scratch::String;
+
+//! Prints command line usage.
+//! \param program the program name
+void PrintUsage(const char* program) {
+    std::cerr << "Usage: " << program
+	<< " [--address ADDRESS] [--port PORT] [--channel PATH]" << std::endl;
+}
+
+} // namespace
+
+//! Program entry point.
+//! \param argc the number of command line arguments
+//! \param argv an array containing the command line arguments
+//! \return zero for normal program termination; non-zero otherwise
+int main(int argc, const char** argv) {
+    // Startup message.
+    LOGGER_MAIN() << "Starting " << PACKAGE_STRING << " gateway!";
+
+    // Defaults match the game's data/config.dat; the channel path must
+    // match its Network Gateway entry.
+    String address;
+    String channelPath("data/gateway.sock");
+    std::uint16_t port = 6767;
+    for (int n = 1; n < argc; ++n) {
+	const auto* value = n + 1 < argc ? argv[n + 1] : nullptr;
+	if (!std::strcmp(argv[n], "--address") && value) {
+	    address = value;
+	} else if (!std::strcmp(argv[n], "--channel") && value) {
+	    channelPath = value;
+	} else if (!std::strcmp(argv[n], "--port") && value) {
+	    const auto number = std::atoi(value);
+	    if (number < 1 || number > 65535) {
+		PrintUsage(argv[0]);
+		return EXIT_FAILURE;
+	    }
+	    port = static_cast<std::uint16_t>(number);
+	} else {
+	    PrintUsage(argv[0]);
+	    return EXIT_FAILURE;
+	}
+	++n;
+    }
+
+    // Configure relay.
+    IoContext ioContext;
+    auto relay = std::make_shared<Relay>(ioContext, channelPath);
+    SignalSet signals(ioContext, SIGINT, SIGTERM);
+    signals.async_wait([relay](const ErrorCode& errorCode, const int signum) {
+	if (errorCode)
+	    return;
+	LOGGER_MAIN() << "Received " << strsignal(signum) << " signal; shutting down.";
+	relay->Stop();
+    });
+
+    // Run relay.
+    try {
+	relay->StartAcceptor(port, address);
+	relay->Start();
+	ioContext.run();
+    } catch (const std::exception& ex) {
+	LOGGER_MAIN() << ex.what();
+	return EXIT_FAILURE;
+    }
+
+    // Exit.
+    LOGGER_MAIN() << "Exiting.";
+    return EXIT_SUCCESS;
+}
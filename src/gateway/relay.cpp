@@ -0,0 +1,310 @@
+//! \file relay.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_RELAY_CPP_
+
+#include <scratch/logger.hpp>
+#include <scratch/relay.hpp>
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Net {
+
+// Boost types.
+using LocalEndpoint = boost::asio::local::stream_protocol::endpoint;
+using Resolver = boost::asio::ip::tcp::resolver;
+using ResolverIterator = boost::asio::ip::tcp::resolver::iterator;
+using ResolverQuery = boost::asio::ip::tcp::resolver::query;
+using Tcp = boost::asio::ip::tcp;
+
+//! Constructor.
+//! \param ioContext the I/O context
+//! \param channelPath the game's Unix socket path
+Relay::Relay(
+	IoContext& ioContext,
+	const String& channelPath) noexcept :
+	acceptor_(ioContext),
+	channel_(ioContext),
+	channelPath_(channelPath),
+	channelSerial_(0),
+	connected_(false),
+	input_(),
+	ioContext_(ioContext),
+	lastSession_(0),
+	output_(),
+	reader_(),
+	reconnectTimer_(ioContext),
+	sessions_(),
+	stopped_(false),
+	writePending_(false),
+	writing_() {
+    // Nothing.
+}
+
+//! Destructor.
+Relay::~Relay() noexcept {
+    // Nothing.
+}
+
+//! Drops a session from the session table.
+//! \param session the session ID
+void Relay::EraseSession(const std::uint32_t session) noexcept {
+    sessions_.erase(session);
+}
+
+//! Queues frames for the game; dropped while disconnected.
+//! \param type the frame type
+//! \param session the session ID
+//! \param data the payload
+//! \param nBytes the size of \p data
+void Relay::Send(
+	const GatewayFrameType type,
+	const std::uint32_t session,
+	const char* data,
+	const std::size_t nBytes) {
+    if (!connected_)
+	return;
+    AppendGatewayFrames(output_, type, session, data, nBytes);
+    this->InitAsyncWrite();
+}
+
+//! Starts connecting to the game.
+//! \sa #Stop()
+void Relay::Start() {
+    LOGGER_NETWORK() << "Gateway connecting to the game on " << channelPath_ << ".";
+    this->Connect();
+}
+
+//! Starts the TELNET acceptor.
+//! \param port the network port upon which to listen
+//! \param address the network address to bind
+void Relay::StartAcceptor(
+	const std::uint16_t port,
+	const String& address) {
+    Endpoint endpoint(Tcp::v4(), port);
+    if (!address.empty()) {
+	Resolver resolver(ioContext_);
+	ResolverQuery query(address, std::to_string(port));
+	for (auto it = resolver.resolve(query); it != ResolverIterator(); ++it) {
+	    endpoint = it->endpoint();
+	    if (endpoint.address().is_v4())
+		break;
+	}
+    }
+
+    // Configure acceptor.
+    acceptor_.open(endpoint.protocol());
+    acceptor_.set_option(Acceptor::reuse_address(true));
+    acceptor_.bind(endpoint);
+    acceptor_.listen();
+
+    LOGGER_NETWORK() << "Gateway listening on " << acceptor_.local_endpoint() << ".";
+
+    // Accept connections.
+    this->InitAsyncAccept();
+}
+
+//! Closes the acceptor, the channel and every client.
+//! \sa #Start()
+void Relay::Stop() {
+    stopped_ = true;
+    ErrorCode errorCode;
+    acceptor_.close(errorCode);
+    reconnectTimer_.cancel();
+    this->CloseChannel();
+
+    // Closing erases from sessions_, so walk a copy.
+    const auto sessions = sessions_;
+    for (auto& entry: sessions)
+	entry.second->Close(false);
+}
+
+//! Closes the channel and schedules a reconnect.
+void Relay::CloseChannel() {
+    // Completions still queued for the old channel see a new serial.
+    ++channelSerial_;
+    const bool wasConnected = connected_;
+    connected_ = false;
+    if (channel_.is_open()) {
+	ErrorCode errorCode;
+	channel_.close(errorCode);
+    }
+    reader_.Reset();
+    output_.clear();
+    if (stopped_)
+	return;
+
+    // Keep clients; they are reopened on the next channel.
+    if (wasConnected) {
+	LOGGER_NETWORK() << "Gateway lost the game; holding " << sessions_.size() << " session(s).";
+	for (auto& entry: sessions_)
+	    entry.second->OnChannelLost();
+    }
+    this->InitReconnect();
+}
+
+//! Connects to the game.
+void Relay::Connect() {
+    const auto self = this->shared_from_this();
+    const auto serial = channelSerial_;
+    channel_.async_connect(LocalEndpoint(channelPath_),
+	[self, serial](const ErrorCode& errorCode) {
+	    if (self->stopped_ || serial != self->channelSerial_)
+		return;
+	    if (errorCode) {
+		// The game is not up yet; try again shortly.
+		ErrorCode closeError;
+		self->channel_.close(closeError);
+		self->InitReconnect();
+		return;
+	    }
+
+	    self->connected_ = true;
+	    LOGGER_NETWORK() << "Gateway connected; opening " << self->sessions_.size() << " session(s).";
+	    for (auto& entry: self->sessions_) {
+		const auto& address = entry.second->GetAddress();
+		self->Send(GATEWAY_OPEN, entry.first, address.data(), address.size());
+	    }
+	    self->InitAsyncRead();
+	});
+}
+
+//! Configures an asynchronous accept.
+void Relay::InitAsyncAccept() {
+    const auto self = this->shared_from_this();
+    acceptor_.async_accept([self](ErrorCode ec, Socket&& s) {
+	if (ec || self->stopped_) {
+	    if (ec && ec != boost::asio::error::operation_aborted) {
+		LOGGER_NETWORK() << "Error accepting connection.";
+		LOGGER_NETWORK() << " >> " << ec;
+		LOGGER_NETWORK() << " >> " << ec.message();
+	    }
+	    return;
+	}
+
+	// Number sessions; zero is never used.
+	if (++self->lastSession_ == 0)
+	    ++self->lastSession_;
+	const auto id = self->lastSession_;
+	auto session = std::make_shared<RelaySession>(*self, std::move(s), id);
+	LOGGER_NETWORK() << "Received connection from " << session->GetAddress() << " as session " << id << ".";
+	self->sessions_[id] = session;
+	session->Start();
+
+	// Admission is the game's call, so announce every client.
+	const auto& address = session->GetAddress();
+	self->Send(GATEWAY_OPEN, id, address.data(), address.size());
+	self->InitAsyncAccept();
+    });
+}
+
+//! Configures an asynchronous channel read.
+void Relay::InitAsyncRead() {
+    const auto self = this->shared_from_this();
+    const auto serial = channelSerial_;
+    channel_.async_read_some(boost::asio::buffer(input_),
+	[self, serial](const ErrorCode& errorCode, std::size_t nBytes) {
+	    if (serial != self->channelSerial_)
+		return;
+	    if (errorCode) {
+		if (errorCode != boost::asio::error::eof &&
+			errorCode != boost::asio::error::operation_aborted) {
+		    LOGGER_NETWORK() << "Error reading game channel.";
+		    LOGGER_NETWORK() << " >> " << errorCode;
+		    LOGGER_NETWORK() << " >> " << errorCode.message();
+		}
+		self->CloseChannel();
+		return;
+	    }
+
+	    // Dispatch every complete frame.
+	    self->reader_.Feed(self->input_, nBytes);
+	    GatewayFrame frame;
+	    while (serial == self->channelSerial_ && self->reader_.Next(frame))
+		self->OnFrame(frame);
+	    if (serial != self->channelSerial_)
+		return;
+	    if (self->reader_.IsFailed()) {
+		LOGGER_NETWORK() << "Game sent a malformed frame; reconnecting.";
+		self->CloseChannel();
+		return;
+	    }
+
+	    // Configure asynchronous read.
+	    self->InitAsyncRead();
+	});
+}
+
+//! Configures an asynchronous channel write.
+void Relay::InitAsyncWrite() {
+    if (writePending_ || output_.empty() || !connected_)
+	return;
+
+    writePending_ = true;
+    writing_.swap(output_);
+    const auto self = this->shared_from_this();
+    const auto serial = channelSerial_;
+    boost::asio::async_write(channel_, boost::asio::buffer(writing_),
+	[self, serial](const ErrorCode& errorCode, std::size_t) {
+	    self->writePending_ = false;
+	    self->writing_.clear();
+	    if (errorCode && serial == self->channelSerial_) {
+		if (errorCode != boost::asio::error::operation_aborted) {
+		    LOGGER_NETWORK() << "Error writing game channel.";
+		    LOGGER_NETWORK() << " >> " << errorCode;
+		    LOGGER_NETWORK() << " >> " << errorCode.message();
+		}
+		self->CloseChannel();
+		return;
+	    }
+
+	    // Continue draining, possibly to a channel connected since.
+	    self->InitAsyncWrite();
+	});
+}
+
+//! Schedules the next connection attempt.
+void Relay::InitReconnect() {
+    if (stopped_)
+	return;
+
+    const auto self = this->shared_from_this();
+    reconnectTimer_.expires_after(std::chrono::seconds(1));
+    reconnectTimer_.async_wait([self](const ErrorCode& errorCode) {
+	if (!errorCode && !self->stopped_ && !self->connected_)
+	    self->Connect();
+    });
+}
+
+//! Dispatches one frame from the game.
+//! \param frame the frame
+void Relay::OnFrame(const GatewayFrame& frame) {
+    auto it = sessions_.find(frame.session);
+    if (it == sessions_.end())
+	return;
+
+    // Hold the session; closing erases it from sessions_.
+    const auto session = it->second;
+    switch (static_cast<int>(frame.type)) {
+    case GATEWAY_DATA:
+	session->Write(frame.payload.data(), frame.payload.size());
+	break;
+    case GATEWAY_CLOSE:
+	session->Close(false);
+	break;
+    case GATEWAY_CORK:
+	session->SetCork(!frame.payload.empty() && frame.payload[0] != 0);
+	break;
+    default:
+	LOGGER_NETWORK() << "Game sent unexpected frame type " << static_cast<unsigned>(frame.type) << ".";
+	break;
+    }
+}
+
+}; // namespace Net
+}; // namespace Scratch
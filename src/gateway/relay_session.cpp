@@ -0,0 +1,313 @@
+//! \file relay_session.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_RELAY_SESSION_CPP_
+
+#include <scratch/logger.hpp>
+#include <scratch/relay.hpp>
+#include <scratch/scratch.hpp>
+
+#ifndef TELOPT_COMPRESS2
+//! The MCCP2 TELNET option; not assigned in <arpa/telnet.h>.
+#define TELOPT_COMPRESS2 86
+#endif // TELOPT_COMPRESS2
+
+namespace Scratch {
+namespace Net {
+
+//! Constructor.
+//! \param relay the relay
+//! \param socket the client socket
+//! \param session the session ID
+RelaySession::RelaySession(
+	Relay& relay,
+	Socket&& socket,
+	const std::uint32_t session) noexcept :
+	address_(),
+	closed_(false),
+	compressing_(false),
+	input_(),
+	output_(),
+	relay_(relay),
+	session_(session),
+	socket_(std::move(socket)),
+	telnetState_(TELNET_DATA),
+	telnetVerb_(0),
+	writePending_(false),
+	writing_() {
+#ifdef HAVE_LIBZ
+    std::memset(&deflater_, 0, sizeof(deflater_));
+#endif // HAVE_LIBZ
+
+    // Capture remote address.
+    ErrorCode errorCode;
+    address_ = socket_.remote_endpoint(errorCode).address().to_string(errorCode);
+}
+
+//! Destructor.
+RelaySession::~RelaySession() noexcept {
+#ifdef HAVE_LIBZ
+    if (compressing_)
+	deflateEnd(&deflater_);
+#endif // HAVE_LIBZ
+}
+
+//! Ends the session; the socket closes once pending output drains.
+//! \param notify whether to tell the game
+void RelaySession::Close(const bool notify) {
+    if (closed_)
+	return;
+
+    closed_ = true;
+    if (notify)
+	relay_.Send(GATEWAY_CLOSE, session_);
+    if (!writePending_)
+	this->CloseSocket();
+    relay_.EraseSession(session_);
+}
+
+//! Tells the client the game went away and releases any cork.
+void RelaySession::OnChannelLost() {
+    this->SetCork(false);
+    static const char notice[] = "\r\nThe game is restarting; please wait.\r\n";
+    this->Write(notice, sizeof(notice) - 1);
+}
+
+//! Sets or clears \c TCP_CORK.
+//! \param cork whether to cork
+void RelaySession::SetCork(const bool cork) noexcept {
+#ifdef TCP_CORK
+    if (!socket_.is_open())
+	return;
+    const int value = cork ? 1 : 0;
+    if (::setsockopt(socket_.native_handle(), IPPROTO_TCP, TCP_CORK,
+	    &value, sizeof(value)) != 0) {
+	LOGGER_NETWORK() << "Error setting TCP_CORK.";
+	LOGGER_NETWORK() << " >> errno=" << errno;
+    }
+#endif // TCP_CORK
+}
+
+//! Begins asynchronous I/O.
+void RelaySession::Start() {
+    // Corking, not Nagle, batches replies.
+    ErrorCode errorCode;
+    socket_.set_option(boost::asio::ip::tcp::no_delay(true), errorCode);
+
+#ifdef HAVE_LIBZ
+    // Offer MCCP2; the game never sees this option.
+    static const char offer[] = {
+	static_cast<char>(IAC), static_cast<char>(WILL),
+	static_cast<char>(TELOPT_COMPRESS2)
+    };
+    this->Append(offer, sizeof(offer));
+#endif // HAVE_LIBZ
+
+    this->InitAsyncRead();
+}
+
+//! Writes bytes from the game, compressed if MCCP2 is on.
+//! \param data the bytes
+//! \param nBytes the number of bytes
+void RelaySession::Write(
+	const char* data,
+	const std::size_t nBytes) {
+    if (closed_ || !nBytes)
+	return;
+#ifdef HAVE_LIBZ
+    if (compressing_) {
+	// Flush per frame so each reply reaches the client whole.
+	deflater_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+	deflater_.avail_in = static_cast<uInt>(nBytes);
+	char chunk[4096];
+	do {
+	    deflater_.next_out = reinterpret_cast<Bytef*>(chunk);
+	    deflater_.avail_out = sizeof(chunk);
+	    const auto result = deflate(&deflater_, Z_SYNC_FLUSH);
+	    if (result != Z_OK && result != Z_BUF_ERROR) {
+		LOGGER_NETWORK() << "Session " << session_ << " deflate error " << result << ".";
+		this->Close();
+		return;
+	    }
+	    output_.append(chunk, sizeof(chunk) - deflater_.avail_out);
+	} while (deflater_.avail_out == 0);
+	this->InitAsyncWrite();
+	return;
+    }
+#endif // HAVE_LIBZ
+    this->Append(data, nBytes);
+}
+
+//! Appends bytes to the output as they stand.
+//! \param data the bytes
+//! \param nBytes the number of bytes
+void RelaySession::Append(
+	const char* data,
+	const std::size_t nBytes) {
+    output_.append(data, nBytes);
+    this->InitAsyncWrite();
+}
+
+//! Closes the client socket.
+void RelaySession::CloseSocket() noexcept {
+    if (!socket_.is_open())
+	return;
+    ErrorCode errorCode;
+    socket_.close(errorCode);
+}
+
+//! Configures an asynchronous read.
+void RelaySession::InitAsyncRead() {
+    const auto self = this->shared_from_this();
+    socket_.async_read_some(boost::asio::buffer(input_),
+	[self](const ErrorCode& errorCode, std::size_t nBytes) {
+	    if (self->closed_)
+		return;
+	    if (errorCode) {
+		// Log failures. eof is an ordinary hang-up.
+		if (errorCode != boost::asio::error::eof &&
+			errorCode != boost::asio::error::operation_aborted) {
+		    LOGGER_NETWORK() << "Error reading session " << self->session_ << ".";
+		    LOGGER_NETWORK() << " >> " << errorCode;
+		    LOGGER_NETWORK() << " >> " << errorCode.message();
+		}
+		self->Close();
+		return;
+	    }
+
+	    self->Receive(reinterpret_cast<const std::uint8_t*>(self->input_), nBytes);
+	    if (!self->closed_)
+		self->InitAsyncRead();
+	});
+}
+
+//! Configures an asynchronous write.
+void RelaySession::InitAsyncWrite() {
+    if (writePending_ || output_.empty() || !socket_.is_open())
+	return;
+
+    writePending_ = true;
+    writing_.swap(output_);
+    const auto self = this->shared_from_this();
+    boost::asio::async_write(socket_, boost::asio::buffer(writing_),
+	[self](const ErrorCode& errorCode, std::size_t) {
+	    self->writePending_ = false;
+	    self->writing_.clear();
+	    if (errorCode) {
+		if (errorCode != boost::asio::error::operation_aborted) {
+		    LOGGER_NETWORK() << "Error writing session " << self->session_ << ".";
+		    LOGGER_NETWORK() << " >> " << errorCode;
+		    LOGGER_NETWORK() << " >> " << errorCode.message();
+		}
+		self->Close();
+		self->CloseSocket();
+		return;
+	    }
+
+	    // Continue draining, or finish a deferred close.
+	    if (!self->output_.empty())
+		self->InitAsyncWrite();
+	    else if (self->closed_)
+		self->CloseSocket();
+	});
+}
+
+//! Filters MCCP2 negotiation out of client input and relays the rest.
+//! \param bytes the bytes
+//! \param nBytes the number of bytes
+void RelaySession::Receive(
+	const std::uint8_t* bytes,
+	const std::size_t nBytes) {
+    String relayed;
+    relayed.reserve(nBytes);
+    for (std::size_t n = 0; n < nBytes; ++n) {
+	const auto byteReceived = bytes[n];
+	switch (static_cast<int>(telnetState_)) {
+	case TELNET_IAC:
+	    if (byteReceived == DO || byteReceived == DONT) {
+		telnetVerb_ = byteReceived;
+		telnetState_ = TELNET_VERB;
+		break;
+	    }
+	    relayed.push_back(static_cast<char>(IAC));
+	    relayed.push_back(static_cast<char>(byteReceived));
+	    telnetState_ = TELNET_DATA;
+	    break;
+	case TELNET_VERB:
+	    telnetState_ = TELNET_DATA;
+	    if (byteReceived == TELOPT_COMPRESS2) {
+		if (telnetVerb_ == DO)
+		    this->StartCompress();
+		else
+		    this->StopCompress();
+		break;
+	    }
+	    relayed.push_back(static_cast<char>(IAC));
+	    relayed.push_back(static_cast<char>(telnetVerb_));
+	    relayed.push_back(static_cast<char>(byteReceived));
+	    break;
+	default:
+	    if (byteReceived == IAC)
+		telnetState_ = TELNET_IAC;
+	    else
+		relayed.push_back(static_cast<char>(byteReceived));
+	    break;
+	}
+    }
+    if (!relayed.empty())
+	relay_.Send(GATEWAY_DATA, session_, relayed.data(), relayed.size());
+}
+
+//! Starts MCCP2 after the client sends IAC DO COMPRESS2.
+void RelaySession::StartCompress() {
+#ifdef HAVE_LIBZ
+    if (compressing_)
+	return;
+
+    // Everything after IAC SB COMPRESS2 IAC SE is compressed.
+    static const char begin[] = {
+	static_cast<char>(IAC), static_cast<char>(SB),
+	static_cast<char>(TELOPT_COMPRESS2),
+	static_cast<char>(IAC), static_cast<char>(SE)
+    };
+    if (deflateInit(&deflater_, Z_DEFAULT_COMPRESSION) != Z_OK) {
+	LOGGER_NETWORK() << "Error initializing deflate.";
+	return;
+    }
+    this->Append(begin, sizeof(begin));
+    compressing_ = true;
+#endif // HAVE_LIBZ
+}
+
+//! Ends the MCCP2 stream.
+void RelaySession::StopCompress() {
+#ifdef HAVE_LIBZ
+    if (!compressing_)
+	return;
+
+    // Finish the stream so the client returns to plain text.
+    compressing_ = false;
+    char chunk[256];
+    deflater_.next_in = nullptr;
+    deflater_.avail_in = 0;
+    int result = Z_OK;
+    do {
+	deflater_.next_out = reinterpret_cast<Bytef*>(chunk);
+	deflater_.avail_out = sizeof(chunk);
+	result = deflate(&deflater_, Z_FINISH);
+	if (!closed_)
+	    output_.append(chunk, sizeof(chunk) - deflater_.avail_out);
+    } while (result == Z_OK);
+    deflateEnd(&deflater_);
+    if (!closed_)
+	this->InitAsyncWrite();
+#endif // HAVE_LIBZ
+}
+
+}; // namespace Net
+}; // namespace Scratch
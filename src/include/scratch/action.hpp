@@ -83,6 +83,114 @@ private:
 };
 //! \}
 
+//! The compiled action template class. \{
+//! \remark Parses a message template once into literal spans and slot
+//!     property lookups, so expanding it for each recipient is a single
+//!     pass with no string comparisons. \c ${you:other} picks a side by
+//!     whether the recipient is the subject; \c $$ is a literal \c $.
+class ActionTemplate {
+public:
+    //! Constructor.
+    //! \param message the message template
+    explicit ActionTemplate(const String& message);
+
+    //! Copy constructor.
+    ActionTemplate(const ActionTemplate&) = delete;
+
+    //! Destructor.
+    ~ActionTemplate() noexcept;
+
+    //! Copy assignment operator.
+    ActionTemplate& operator=(const ActionTemplate&) = delete;
+
+    //! Expands this template for one recipient.
+    //! \param subject the subject slot
+    //! \param direct the direct slot
+    //! \param indirect the indirect slot
+    //! \param extra the extra slot
+    //! \param recipient the recipient instance
+    String Expand(
+	const ActionParam& subject,
+	const ActionParam& direct,
+	const ActionParam& indirect,
+	const ActionParam& extra,
+	const InstancePtr& recipient) const;
+
+protected:
+    //! The template properties. \{
+    enum Property: std::uint8_t {
+	PROP_LITERAL = 0,	//!< Literal span; no slot.
+	PROP_INVALID,		//!< Malformed macro.
+	PROP_TEXT,		//!< Slot text, or name.
+	PROP_AN,		//!< Indefinite article for the text.
+	PROP_NAME,		//!< Name.
+	PROP_NAME_POSSESSIVE,	//!< Genitive name.
+	PROP_COPULA,		//!< Copula.
+	PROP_DETERMINER,	//!< Possessive determiner.
+	PROP_SUBJECT,		//!< Subject pronoun.
+	PROP_OBJECT,		//!< Object pronoun.
+	PROP_POSSESSIVE,	//!< Possessive pronoun.
+	PROP_REFLEXIVE		//!< Reflexive pronoun.
+    };
+    //! \}
+
+    //! One side of a template segment. \{
+    struct Side {
+	//! The property.
+	Property property = PROP_LITERAL;
+
+	//! Whether you-shift is disabled.
+	bool raw = false;
+
+	//! The slot index: subject, direct, indirect, extra.
+	std::uint8_t slot = 0;
+
+	//! The literal span offset in #literals_.
+	std::size_t offset = 0;
+
+	//! The literal span length.
+	std::size_t length = 0;
+    };
+    //! \}
+
+    //! One template segment. \{
+    struct Segment {
+	//! The side used when the recipient is the subject.
+	Side you;
+
+	//! The side used otherwise.
+	Side other;
+    };
+    //! \}
+
+    //! The literal text every literal span points into.
+    String literals_;
+
+    //! The segments.
+    std::vector<Segment> segments_;
+
+    //! Appends literal text, merging into a trailing literal segment.
+    //! \param text the literal text
+    void AppendLiteral(const String& text);
+
+    //! Compiles one macro side.
+    //! \param text the side text
+    Side CompileSide(const String& text);
+
+    //! Resolves one property side.
+    //! \param side the side
+    //! \param param the slot param
+    //! \param recipient the recipient instance
+    static String Resolve(
+	const Side& side,
+	const ActionParam& param,
+	const InstancePtr& recipient);
+};
+//! \}
+
+//! The type of a shared action template pointer.
+using ActionTemplatePtr = std::shared_ptr<const ActionTemplate>;
+
 }; // namespace Core
 }; // namespace Scratch
 
@@ -0,0 +1,177 @@
+//! \file admission.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_ADMISSION_HPP_
+#define _SCRATCH_ADMISSION_HPP_
+
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+
+namespace Scratch {
+namespace Net {
+
+// Boost types.
+using Address = boost::asio::ip::address;
+
+//! The admission class. \{
+//! \remark Screens accepted sockets before \c Game::MakeDescriptor builds
+//!     a descriptor. Each source address gets a token bucket and a
+//!     concurrent connection count; a CIDR ban list is kept in a binary
+//!     radix tree so lookup costs at most one step per prefix bit.
+class Admission {
+public:
+    //! The admission verdict. \{
+    enum Verdict: unsigned {
+	ADMIT		= 0,	//!< Connection admitted.
+	REJECT_BANNED	= 1,	//!< Address matches a banned prefix.
+	REJECT_LIMIT	= 2,	//!< Too many concurrent connections.
+	REJECT_RATE	= 3	//!< Token bucket empty.
+    };
+    //! \}
+
+    //! Default constructor.
+    Admission() noexcept;
+
+    //! Copy constructor.
+    Admission(const Admission&) = delete;
+
+    //! Destructor.
+    ~Admission() noexcept;
+
+    //! Copy assignment operator.
+    Admission& operator=(const Admission&) = delete;
+
+    //! Screens a connection and, if admitted, counts it against
+    //! \p address.
+    //! \param address the source address
+    //! \return the admission verdict
+    //! \sa #Release(const Address&)
+    Verdict Admit(const Address& address) noexcept;
+
+    //! Counts an already-open connection against \p address without
+    //! screening it.
+    //! \param address the source address
+    //! \remark Used for sessions handed over by a hot reboot.
+    //! \sa #Release(const Address&)
+    void Adopt(const Address& address) noexcept;
+
+    //! Returns the number of banned prefixes.
+    std::size_t GetBanCount() const noexcept {
+	return banCount_;
+    }
+
+    //! Returns whether \p address matches a banned prefix.
+    //! \param address the source address
+    bool IsBanned(const Address& address) const noexcept;
+
+    //! Loads the ban list from the fixed Data file.
+    //! \return \c true if the file was loaded; the previous list is kept
+    //!     otherwise
+    bool LoadBans() noexcept;
+
+    //! Releases a connection admitted for \p address.
+    //! \param address the source address
+    //! \sa #Admit(const Address&)
+    void Release(const Address& address) noexcept;
+
+    //! Sets the per-address limits.
+    //! \param rate the sustained connection rate, per minute
+    //! \param burst the burst allowance
+    //! \param limit the concurrent connection limit, or zero
+    void SetLimits(
+	const double rate,
+	const unsigned burst,
+	const unsigned limit) noexcept;
+
+    //! Returns a verdict name.
+    //! \param verdict the verdict
+    static const char* VerdictToString(const Verdict verdict) noexcept;
+
+protected:
+    //! The address key type; IPv4 is stored IPv4-mapped.
+    using AddressBytes = boost::asio::ip::address_v6::bytes_type;
+
+    //! Per-address admission state. \{
+    struct Bucket {
+	//! The concurrent connection count.
+	unsigned connections = 0;
+
+	//! The rejections since the last admission.
+	unsigned rejected = 0;
+
+	//! The time of the last refill.
+	std::chrono::steady_clock::time_point refilled;
+
+	//! The available tokens.
+	double tokens = 0.0;
+    };
+    //! \}
+
+    //! The ban radix tree node. \{
+    struct BanNode {
+	//! The children, indexed by the next address bit.
+	std::unique_ptr<BanNode> children[2];
+
+	//! Whether the prefix ending here is banned.
+	bool banned = false;
+    };
+    //! \}
+
+    //! Bucket count below which no pruning occurs.
+    static const std::size_t MinPrune = 1024;
+
+    //! The ban tree root.
+    std::unique_ptr<BanNode> banRoot_;
+
+    //! The number of banned prefixes.
+    std::size_t banCount_;
+
+    //! The per-address buckets.
+    std::map<Address, Bucket> buckets_;
+
+    //! The burst allowance.
+    unsigned burst_;
+
+    //! The concurrent connection limit, or zero.
+    unsigned limit_;
+
+    //! The bucket count that triggers the next prune.
+    std::size_t pruneAt_;
+
+    //! The sustained connection rate, per second.
+    double rate_;
+
+    //! Inserts a banned prefix.
+    //! \param root the tree root
+    //! \param cidr the prefix in \c address/length form
+    //! \return \c true if \p cidr was valid
+    static bool InsertBan(
+	BanNode& root,
+	const String& cidr) noexcept;
+
+    //! Erases idle, full buckets.
+    //! \param now the current time
+    void Prune(const std::chrono::steady_clock::time_point now) noexcept;
+
+    //! Refills a bucket.
+    //! \param bucket the bucket
+    //! \param now the current time
+    void Refill(
+	Bucket& bucket,
+	const std::chrono::steady_clock::time_point now) const noexcept;
+
+    //! Returns the tree key for \p address.
+    //! \param address the address
+    static AddressBytes ToBytes(const Address& address) noexcept;
+};
+//! \}
+
+}; // namespace Net
+}; // namespace Scratch
+
+#endif // _SCRATCH_ADMISSION_HPP_
@@ -0,0 +1,80 @@
+//! \file audience.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_AUDIENCE_HPP_
+#define _SCRATCH_AUDIENCE_HPP_
+
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Core {
+
+// Forward declarations.
+class Instance;
+
+// ScratchMUD types.
+using InstancePtr = std::shared_ptr<Instance>;
+
+//! The audience class. \{
+//! \remark A membership set that action messages are delivered to, such
+//!     as a room or channel. Members sit in a flat vector and each
+//!     instance remembers its slot, so joining and leaving are O(1) and
+//!     delivery is one linear pass. An instance belongs to at most one
+//!     audience.
+class Audience {
+public:
+    //! Default constructor.
+    Audience() noexcept;
+
+    //! Copy constructor.
+    Audience(const Audience&) = delete;
+
+    //! Destructor.
+    ~Audience() noexcept;
+
+    //! Copy assignment operator.
+    Audience& operator=(const Audience&) = delete;
+
+    //! Removes every member.
+    void Clear() noexcept;
+
+    //! Returns whether \p instance is a member.
+    //! \param instance the instance
+    bool Contains(const InstancePtr& instance) const noexcept;
+
+    //! Removes a member.
+    //! \param instance the instance to remove
+    //! \remark Moves the last member into the vacated slot.
+    //! \sa #Insert(const InstancePtr&)
+    void Erase(const InstancePtr& instance) noexcept;
+
+    //! Gets the members, in no particular order.
+    const std::vector<InstancePtr>& GetMembers() const noexcept {
+	return members_;
+    }
+
+    //! Adds a member, removing it from any other audience first.
+    //! \param instance the instance to add
+    //! \sa #Erase(const InstancePtr&)
+    void Insert(const InstancePtr& instance) noexcept;
+
+    //! Returns the number of members.
+    std::size_t Size() const noexcept {
+	return members_.size();
+    }
+
+protected:
+    //! The members.
+    std::vector<InstancePtr> members_;
+};
+//! \}
+
+}; // namespace Core
+}; // namespace Scratch
+
+#endif // _SCRATCH_AUDIENCE_HPP_
@@ -12,6 +12,7 @@
 #include <scratch/scratch.hpp>
 #include <scratch/social.hpp>
 #include <scratch/string.hpp>
+#include <scratch/symbol_table.hpp>
 #include <scratch/thing.hpp>
 
 // Forward declarations.
@@ -56,6 +57,7 @@ public:
     //! \sa #SetPermissions(const StringSetCi&)
     void AddPermission(const String& permission) {
 	permissions_.insert(permission);
+	SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
     }
 
     //! Returns whether \p performer may run this command.
@@ -71,6 +73,7 @@ public:
     //! \sa #SetPermissions(const StringSetCi&)
     void ErasePermission(const String& permission) {
 	permissions_.erase(permission);
+	SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
     }
 
     //! Gets the Action hook.
@@ -85,6 +88,12 @@ public:
 	return keywords_;
     }
 
+    //! Gets the permissions as interned symbols.
+    //! \sa SymbolTable::Permissions()
+    const SymbolBits& GetPermissionBits() const noexcept {
+	return permissionBits_;
+    }
+
     //! Gets the permissions.
     //! \sa #SetPermissions(const StringSetCi&)
     StringSetCi GetPermissions() const noexcept {
@@ -106,6 +115,14 @@ public:
 	return permissions_.find(permission) != permissions_.end();
     }
 
+    //! Returns whether the interned permission \p symbol is present.
+    //! \param symbol the permission symbol to test
+    //! \sa #HasPermission(const String&) const
+    //! \sa SymbolTable::Permissions()
+    bool HasPermission(const unsigned symbol) const noexcept {
+	return SymbolTable::Test(permissionBits_, symbol);
+    }
+
     //! Reads this command from a data node.
     //! \param data the data node to read
     //! \sa #WriteData(const DataPtr&) const
@@ -134,6 +151,7 @@ public:
     //! \sa #GetPermissions() const
     void SetPermissions(const StringSetCi& permissions) {
 	permissions_ = permissions;
+	SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
     }
 
     //! Sets the social data.
@@ -169,6 +187,11 @@ protected:
     //! \sa #SetPermissions(const StringSetCi&)
     StringSetCi permissions_;
 
+    //! The interned permissions; names past SymbolTable::MaxSymbols
+    //!     are absent.
+    //! \sa #GetPermissionBits() const
+    SymbolBits permissionBits_;
+
     //! The social data.
     //! \sa #GetSocial() const
     //! \sa #SetSocial(const SocialPtr&)
@@ -79,6 +79,10 @@ public:
     //! Registers Command and Social bindings.
     //! \param lua the Lua facade
     static void Register(Lua& lua);
+
+    //! Registers the \c A action targets table.
+    //! \param lua the Lua facade
+    static void RegisterTargets(Lua& lua);
 };
 //! \}
 
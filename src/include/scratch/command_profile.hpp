@@ -0,0 +1,121 @@
+//! \file command_profile.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_COMMAND_PROFILE_HPP_
+#define _SCRATCH_COMMAND_PROFILE_HPP_
+
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+
+namespace Scratch {
+namespace Core {
+
+//! The command profile class. \{
+//! \remark Per-command dispatch counters with base-2 logarithmic
+//!     histograms: bucket zero counts zero, and bucket \e k counts
+//!     values in [2^(k-1), 2^k). The last bucket also counts everything
+//!     larger. Times are in microseconds, output in wire bytes.
+class CommandProfile {
+public:
+    //! The timed dispatch stages. \{
+    enum Stage {
+	STAGE_PARSE,		//!< Splitting off the command word.
+	STAGE_FIND,		//!< Resolving the command.
+	STAGE_EXECUTE,		//!< Running the Action hook or social.
+	MAX_STAGE
+    };
+    //! \}
+
+    //! The number of histogram buckets.
+    static const unsigned Buckets = 24;
+
+    //! One measured invocation. \{
+    struct Sample {
+	//! The time spent in each stage.
+	std::chrono::microseconds stages[MAX_STAGE];
+
+	//! The wire bytes queued for the performer.
+	std::uint64_t outputBytes;
+    };
+    //! \}
+
+    //! One command's counters. \{
+    struct Stats {
+	//! The number of invocations.
+	std::uint64_t invocations = 0;
+
+	//! The summed wall time.
+	std::chrono::microseconds total = std::chrono::microseconds(0);
+
+	//! The slowest wall time.
+	std::chrono::microseconds max = std::chrono::microseconds(0);
+
+	//! The stage time histograms.
+	std::uint64_t stages[MAX_STAGE][Buckets] = {};
+
+	//! The output byte histogram.
+	std::uint64_t output[Buckets] = {};
+    };
+    //! \}
+
+    //! Default constructor.
+    CommandProfile() noexcept;
+
+    //! Copy constructor.
+    CommandProfile(const CommandProfile&) = delete;
+
+    //! Destructor.
+    ~CommandProfile() noexcept;
+
+    //! Copy assignment operator.
+    CommandProfile& operator=(const CommandProfile&) = delete;
+
+    //! Removes every counter.
+    void Clear() noexcept {
+	stats_.clear();
+    }
+
+    //! Formats the counters as a table, one command per row.
+    //! \return the table, or empty if nothing was recorded
+    String Format() const;
+
+    //! Gets the counters by command name.
+    const StringMapCi<Stats>& GetStats() const noexcept {
+	return stats_;
+    }
+
+    //! Records one invocation.
+    //! \param command the command name
+    //! \param sample the measurements
+    //! \return the wall time of \p sample
+    std::chrono::microseconds Record(
+	const String& command,
+	const Sample& sample);
+
+    //! Returns the histogram bucket for \p value.
+    //! \param value the measured value
+    static unsigned Bucket(const std::uint64_t value) noexcept;
+
+    //! Returns the upper bound of the bucket holding a percentile.
+    //! \param histogram the histogram
+    //! \param percent the percentile, 1 to 100
+    //! \return the exclusive upper bound, or zero if \p histogram is empty
+    static std::uint64_t Percentile(
+	const std::uint64_t (&histogram)[Buckets],
+	const unsigned percent) noexcept;
+
+protected:
+    //! The counters by command name.
+    StringMapCi<Stats> stats_;
+};
+//! \}
+
+}; // namespace Core
+}; // namespace Scratch
+
+#endif // _SCRATCH_COMMAND_PROFILE_HPP_
@@ -0,0 +1,124 @@
+//! \file command_trie.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_COMMAND_TRIE_HPP_
+#define _SCRATCH_COMMAND_TRIE_HPP_
+
+#include <scratch/command.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+#include <scratch/symbol_table.hpp>
+
+namespace Scratch {
+namespace Core {
+
+//! The command abbreviation trie class. \{
+//! \remark Compiled from the keyword command index. Each node is a typed
+//!     prefix and lists the commands it abbreviates, shortest keyword
+//!     first, with a copy of each command's interned permission bits;
+//!     resolving a word is one walk of its characters and a bitset test
+//!     per candidate. #Insert and #Erase patch single keywords, so a
+//!     live command edit does not rebuild the trie.
+class CommandTrie {
+public:
+    //! Default constructor.
+    CommandTrie() noexcept;
+
+    //! Copy constructor.
+    CommandTrie(const CommandTrie&) = delete;
+
+    //! Destructor.
+    ~CommandTrie() noexcept;
+
+    //! Copy assignment operator.
+    CommandTrie& operator=(const CommandTrie&) = delete;
+
+    //! Rebuilds the trie.
+    //! \param index the keyword command index
+    void Build(const StringMapCi<CommandPtr>& index);
+
+    //! Removes every node.
+    void Clear() noexcept;
+
+    //! Removes one keyword of \p command.
+    //! \param keyword the keyword
+    //! \param command the command indexed under \p keyword
+    //! \remark Emptied nodes stay until the next #Build.
+    //! \sa #Insert(const String&, const CommandPtr&)
+    void Erase(
+	const String& keyword,
+	const CommandPtr& command) noexcept;
+
+    //! Finds the shortest keyword \p word abbreviates that \p performer
+    //! may use.
+    //! \param word the typed word
+    //! \param performer the performing instance
+    //! \return the matched command, or \c nullptr
+    CommandPtr Find(
+	const String& word,
+	const InstancePtr& performer) const noexcept;
+
+    //! Adds one keyword of \p command.
+    //! \param keyword the keyword
+    //! \param command the command to index under \p keyword
+    //! \remark Candidates keep the order #Build gives them.
+    //! \sa #Erase(const String&, const CommandPtr&)
+    void Insert(
+	const String& keyword,
+	const CommandPtr& command);
+
+protected:
+    //! One candidate command. \{
+    struct Entry {
+	//! The command.
+	CommandPtr command;
+
+	//! The keyword.
+	String keyword;
+
+	//! The keyword length.
+	std::size_t length = 0;
+
+	//! The interned permission bits.
+	SymbolBits mask;
+
+	//! Whether the command has no permissions.
+	bool open = false;
+
+	//! Whether a permission could not be interned.
+	//! \remark Such candidates fall back to Command::Allows.
+	bool overflow = false;
+    };
+    //! \}
+
+    //! One trie node. \{
+    struct Node {
+	//! The child node indices by folded character.
+	std::vector<std::pair<char, std::uint32_t>> children;
+
+	//! The candidates, shortest keyword first.
+	std::vector<Entry> entries;
+    };
+    //! \}
+
+    //! The nodes; the root is first.
+    std::vector<Node> nodes_;
+
+    //! Makes the candidate for one keyword of \p command.
+    //! \param keyword the keyword
+    //! \param command the command
+    static Entry MakeEntry(
+	const String& keyword,
+	const CommandPtr& command);
+};
+//! \}
+
+}; // namespace Core
+}; // namespace Scratch
+
+#endif // _SCRATCH_COMMAND_TRIE_HPP_
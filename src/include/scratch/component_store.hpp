@@ -0,0 +1,285 @@
+//! \file component_store.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_COMPONENT_STORE_HPP_
+#define _SCRATCH_COMPONENT_STORE_HPP_
+
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+
+namespace Scratch {
+namespace Utility {
+
+//! The type of a component store handle.
+//! \remark The high 32 bits are the slot generation and the low 32 bits
+//!     the slot index. Zero is never issued.
+using SlotHandle = std::uint64_t;
+
+//! The component store class. \{
+//! \remark Generational structure-of-arrays store: each component type
+//!     is its own dense column, all columns share one dense order, and
+//!     a handle names a slot whose generation changes on erase so stale
+//!     handles never alias a later entity. Insert, erase, and lookup are
+//!     O(1); erase moves the last entity into the vacated position of
+//!     every column. Component types must be distinct; the type list is
+//!     the component registry and columns are looked up by type.
+template <typename... Components>
+class ComponentStore {
+public:
+    //! Default constructor.
+    ComponentStore() noexcept :
+	    columns_(),
+	    free_(),
+	    owners_(),
+	    slots_() {
+	// Nothing.
+    }
+
+    //! Copy constructor.
+    ComponentStore(const ComponentStore&) = delete;
+
+    //! Destructor.
+    ~ComponentStore() noexcept {
+	// Nothing.
+    }
+
+    //! Copy assignment operator.
+    ComponentStore& operator=(const ComponentStore&) = delete;
+
+    //! Removes every entity; outstanding handles become stale.
+    void Clear() noexcept {
+	for (const auto index: owners_)
+	    this->Retire(index);
+	owners_.clear();
+	this->ClearColumns(std::index_sequence_for<Components...>());
+    }
+
+    //! Returns whether \p handle names a live entity.
+    //! \param handle the handle
+    bool Contains(const SlotHandle handle) const noexcept {
+	return this->Locate(handle) != NoDense;
+    }
+
+    //! Removes the entity for \p handle.
+    //! \param handle the handle
+    //! \return \c false if \p handle is stale or invalid
+    bool Erase(const SlotHandle handle) noexcept {
+	const auto dense = this->Locate(handle);
+	if (dense == NoDense)
+	    return false;
+
+	// Move last entity into vacated position.
+	if (dense + 1 != owners_.size()) {
+	    this->MoveLast(dense, std::index_sequence_for<Components...>());
+	    owners_[dense] = owners_.back();
+	    slots_[owners_[dense]].dense = static_cast<std::uint32_t>(dense);
+	}
+	this->PopColumns(std::index_sequence_for<Components...>());
+	owners_.pop_back();
+	this->Retire(static_cast<std::uint32_t>(handle));
+	return true;
+    }
+
+    //! Finds one component of the entity for \p handle.
+    //! \param handle the handle
+    //! \return the component, or \c nullptr if \p handle is stale or
+    //!     invalid
+    template <typename T>
+    T* Find(const SlotHandle handle) noexcept {
+	const auto dense = this->Locate(handle);
+	return dense != NoDense ? &this->GetColumnData<T>()[dense] : nullptr;
+    }
+
+    //! Finds one component of the entity for \p handle.
+    //! \param handle the handle
+    //! \return the component, or \c nullptr if \p handle is stale or
+    //!     invalid
+    template <typename T>
+    const T* Find(const SlotHandle handle) const noexcept {
+	const auto dense = this->Locate(handle);
+	return dense != NoDense ? &this->GetColumn<T>()[dense] : nullptr;
+    }
+
+    //! Gets one component column, densely packed in entity order.
+    //! \remark Invalidated by #Insert and #Erase.
+    template <typename T>
+    const std::vector<T>& GetColumn() const noexcept {
+	return std::get<std::vector<T>>(columns_);
+    }
+
+    //! Gets the handle of the entity at a dense position.
+    //! \param dense the dense position
+    SlotHandle GetHandle(const std::size_t dense) const noexcept {
+	const auto index = owners_[dense];
+	return (static_cast<SlotHandle>(slots_[index].generation) << 32) |
+	    index;
+    }
+
+    //! Inserts an entity.
+    //! \param components the components, one per column
+    //! \return the handle
+    SlotHandle Insert(Components... components) {
+	std::uint32_t index;
+	if (!free_.empty()) {
+	    index = free_.back();
+	    free_.pop_back();
+	} else {
+	    index = static_cast<std::uint32_t>(slots_.size());
+	    slots_.push_back(Slot());
+	}
+
+	auto& slot = slots_[index];
+	slot.dense = static_cast<std::uint32_t>(owners_.size());
+	this->PushColumns(std::index_sequence_for<Components...>(),
+	    std::move(components)...);
+	owners_.push_back(index);
+	return (static_cast<SlotHandle>(slot.generation) << 32) | index;
+    }
+
+    //! Returns the number of entities.
+    std::size_t Size() const noexcept {
+	return owners_.size();
+    }
+
+    //! Parses a handle from its name.
+    //! \param name the base-36 name
+    //! \return the handle, or zero if \p name is malformed
+    //! \sa #ToName(SlotHandle)
+    static SlotHandle FromName(const String& name) noexcept {
+	if (name.empty() || name.size() > 13)
+	    return 0;
+	SlotHandle handle = 0;
+	for (const auto c: name) {
+	    unsigned digit;
+	    if (c >= '0' && c <= '9')
+		digit = c - '0';
+	    else if (c >= 'a' && c <= 'z')
+		digit = c - 'a' + 10;
+	    else if (c >= 'A' && c <= 'Z')
+		digit = c - 'A' + 10;
+	    else
+		return 0;
+	    if (handle > (std::numeric_limits<SlotHandle>::max() - digit) / 36)
+		return 0;
+	    handle = handle * 36 + digit;
+	}
+	return handle;
+    }
+
+    //! Formats a handle as a name.
+    //! \param handle the handle
+    //! \return the lowercase base-36 name
+    //! \sa #FromName(const String&)
+    static String ToName(SlotHandle handle) {
+	String name;
+	do {
+	    const auto digit = static_cast<char>(handle % 36);
+	    name.push_back(digit < 10 ? '0' + digit : 'a' + digit - 10);
+	} while (handle /= 36);
+	std::reverse(std::begin(name), std::end(name));
+	return name;
+    }
+
+protected:
+    //! The dense position returned for a stale or invalid handle.
+    static const std::size_t NoDense = ~std::size_t(0);
+
+    //! The slot record. \{
+    struct Slot {
+	//! The generation, bumped on erase; starts at one so that no
+	//! handle is zero.
+	std::uint32_t generation = 1;
+
+	//! The dense position of the entity.
+	std::uint32_t dense = 0;
+    };
+    //! \}
+
+    //! The component columns.
+    std::tuple<std::vector<Components>...> columns_;
+
+    //! The free slot indices.
+    std::vector<std::uint32_t> free_;
+
+    //! The slot index owning each dense position.
+    std::vector<std::uint32_t> owners_;
+
+    //! The slots.
+    std::vector<Slot> slots_;
+
+    //! Gets one component column for writing.
+    template <typename T>
+    std::vector<T>& GetColumnData() noexcept {
+	return std::get<std::vector<T>>(columns_);
+    }
+
+    //! Resolves a handle to its dense position.
+    //! \param handle the handle
+    //! \return the dense position, or #NoDense
+    std::size_t Locate(const SlotHandle handle) const noexcept {
+	const auto index = static_cast<std::uint32_t>(handle);
+	const auto generation = static_cast<std::uint32_t>(handle >> 32);
+	if (index >= slots_.size())
+	    return NoDense;
+	const auto& slot = slots_[index];
+	if (slot.generation != generation ||
+		slot.dense >= owners_.size() ||
+		owners_[slot.dense] != index)
+	    return NoDense;
+	return slot.dense;
+    }
+
+    //! Bumps a slot generation and frees the slot.
+    //! \param index the slot index
+    void Retire(const std::uint32_t index) {
+	auto& slot = slots_[index];
+	if (++slot.generation == 0)
+	    slot.generation = 1;
+	free_.push_back(index);
+    }
+
+    //! Empties every column.
+    template <std::size_t... I>
+    void ClearColumns(std::index_sequence<I...>) noexcept {
+	using Expand = int[];
+	(void) Expand{0, (std::get<I>(columns_).clear(), 0)...};
+    }
+
+    //! Moves the last entity of every column to \p dense.
+    template <std::size_t... I>
+    void MoveLast(
+	    const std::size_t dense,
+	    std::index_sequence<I...>) noexcept {
+	using Expand = int[];
+	(void) Expand{0, (std::get<I>(columns_)[dense] =
+	    std::move(std::get<I>(columns_).back()), 0)...};
+    }
+
+    //! Removes the last entity of every column.
+    template <std::size_t... I>
+    void PopColumns(std::index_sequence<I...>) noexcept {
+	using Expand = int[];
+	(void) Expand{0, (std::get<I>(columns_).pop_back(), 0)...};
+    }
+
+    //! Appends one component to every column.
+    template <std::size_t... I>
+    void PushColumns(
+	    std::index_sequence<I...>,
+	    Components&&... components) {
+	using Expand = int[];
+	(void) Expand{0, (std::get<I>(columns_).push_back(
+	    std::move(components)), 0)...};
+    }
+};
+//! \}
+
+}; // namespace Utility
+}; // namespace Scratch
+
+#endif // _SCRATCH_COMPONENT_STORE_HPP_
@@ -41,6 +41,31 @@ public:
 	return bootstrapState_;
     }
 
+    //! Gets the connection burst allowance per address.
+    //! \sa #SetConnectBurst(const unsigned)
+    unsigned GetConnectBurst() const noexcept {
+	return connectBurst_;
+    }
+
+    //! Gets the concurrent connection limit per address.
+    //! \sa #SetConnectLimit(const unsigned)
+    unsigned GetConnectLimit() const noexcept {
+	return connectLimit_;
+    }
+
+    //! Gets the sustained connection rate per address, per minute.
+    //! \sa #SetConnectRate(const double)
+    double GetConnectRate() const noexcept {
+	return connectRate_;
+    }
+
+    //! Gets the \c scratch-gateway channel socket path, or empty if the
+    //! game listens for TELNET itself.
+    //! \sa #SetGateway(const String&)
+    String GetGateway() const noexcept {
+	return gateway_;
+    }
+
     //! Gets the house metacolor map.
     //! \sa #SetMetaColor(Color::ColorEnum, Color::ColorEnum)
     const std::map<Color::ColorEnum, Color::ColorEnum>& GetMetaColors() const noexcept {
@@ -53,6 +78,42 @@ public:
 	return port_;
     }
 
+    //! Gets the game pulse rate, in pulses per second.
+    //! \sa #SetPulseRate(const unsigned)
+    unsigned GetPulseRate() const noexcept {
+	return pulseRate_;
+    }
+
+    //! Gets the number of instance shards for parallel pulse hooks.
+    //! \sa #SetPulseShards(const unsigned)
+    unsigned GetPulseShards() const noexcept {
+	return pulseShards_;
+    }
+
+    //! Gets the number of pulse worker threads besides the game thread.
+    //! \sa #SetPulseThreads(const unsigned)
+    unsigned GetPulseThreads() const noexcept {
+	return pulseThreads_;
+    }
+
+    //! Gets the slow command threshold, in milliseconds.
+    //! \sa #SetSlowCommand(const unsigned)
+    unsigned GetSlowCommand() const noexcept {
+	return slowCommand_;
+    }
+
+    //! Gets whether descriptors cork output until the prompt.
+    //! \sa #SetTcpCork(const bool)
+    bool GetTcpCork() const noexcept {
+	return tcpCork_;
+    }
+
+    //! Gets the WebSocket listen port, or zero if disabled.
+    //! \sa #SetWebSocketPort(const std::uint16_t)
+    std::uint16_t GetWebSocketPort() const noexcept {
+	return webSocketPort_;
+    }
+
     //! Loads configuration from the fixed Data file.
     //! \return true if the file was loaded successfully
     //! \sa #Save() const
@@ -75,6 +136,31 @@ public:
 	bootstrapState_ = bootstrapState;
     }
 
+    //! Sets the connection burst allowance per address.
+    //! \sa #GetConnectBurst() const
+    void SetConnectBurst(const unsigned connectBurst) {
+	connectBurst_ = connectBurst;
+    }
+
+    //! Sets the concurrent connection limit per address.
+    //! \sa #GetConnectLimit() const
+    void SetConnectLimit(const unsigned connectLimit) {
+	connectLimit_ = connectLimit;
+    }
+
+    //! Sets the sustained connection rate per address, per minute.
+    //! \sa #GetConnectRate() const
+    void SetConnectRate(const double connectRate) {
+	connectRate_ = connectRate;
+    }
+
+    //! Sets the \c scratch-gateway channel socket path, or empty to
+    //! listen for TELNET directly.
+    //! \sa #GetGateway() const
+    void SetGateway(const String& gateway) {
+	gateway_ = gateway;
+    }
+
     //! Sets a house metacolor.
     //! \param meta the metacolor
     //! \param color the real color
@@ -90,6 +176,44 @@ public:
 	port_ = port;
     }
 
+    //! Sets the game pulse rate, in pulses per second.
+    //! \sa #GetPulseRate() const
+    void SetPulseRate(const unsigned pulseRate) {
+	pulseRate_ = pulseRate;
+    }
+
+    //! Sets the number of instance shards for parallel pulse hooks.
+    //! \sa #GetPulseShards() const
+    void SetPulseShards(const unsigned pulseShards) {
+	pulseShards_ = pulseShards;
+    }
+
+    //! Sets the number of pulse worker threads besides the game thread,
+    //! or zero to run every shard on the game thread.
+    //! \sa #GetPulseThreads() const
+    void SetPulseThreads(const unsigned pulseThreads) {
+	pulseThreads_ = pulseThreads;
+    }
+
+    //! Sets the slow command threshold, in milliseconds, or zero to
+    //! disable the Slow log.
+    //! \sa #GetSlowCommand() const
+    void SetSlowCommand(const unsigned slowCommand) {
+	slowCommand_ = slowCommand;
+    }
+
+    //! Sets whether descriptors cork output until the prompt.
+    //! \sa #GetTcpCork() const
+    void SetTcpCork(const bool tcpCork) {
+	tcpCork_ = tcpCork;
+    }
+
+    //! Sets the WebSocket listen port, or zero to disable.
+    //! \sa #GetWebSocketPort() const
+    void SetWebSocketPort(const std::uint16_t webSocketPort) {
+	webSocketPort_ = webSocketPort;
+    }
+
 protected:
     //! Network bind address.
     //! \sa #GetAddress() const
@@ -99,6 +223,25 @@ protected:
     //! \sa #GetBootstrapState() const
     String bootstrapState_;
 
+    //! Connection burst allowance per address.
+    //! \sa #GetConnectBurst() const
+    unsigned connectBurst_;
+
+    //! Concurrent connection limit per address; zero disables the limit.
+    //! \sa #GetConnectLimit() const
+    unsigned connectLimit_;
+
+    //! Sustained connection rate per address, per minute.
+    //! \sa #GetConnectRate() const
+    double connectRate_;
+
+    //! \c scratch-gateway channel socket path; empty listens for TELNET
+    //! directly.
+    //! \remark When set, the gateway owns the TELNET port and \ref port_
+    //!     is not bound.
+    //! \sa #GetGateway() const
+    String gateway_;
+
     //! House metacolor map.
     //! \sa #GetMetaColors() const
     std::map<Color::ColorEnum, Color::ColorEnum> metaColors_;
@@ -106,6 +249,31 @@ protected:
     //! Network listen port.
     //! \sa #GetPort() const
     std::uint16_t port_;
+
+    //! Game pulse rate, in pulses per second.
+    //! \sa #GetPulseRate() const
+    unsigned pulseRate_;
+
+    //! Number of instance shards for parallel pulse hooks.
+    //! \sa #GetPulseShards() const
+    unsigned pulseShards_;
+
+    //! Number of pulse worker threads besides the game thread.
+    //! \sa #GetPulseThreads() const
+    unsigned pulseThreads_;
+
+    //! Slow command threshold, in milliseconds; zero disables the Slow log.
+    //! \sa #GetSlowCommand() const
+    unsigned slowCommand_;
+
+    //! Whether descriptors cork output until the prompt.
+    //! \remark Uses \c TCP_CORK where available.
+    //! \sa #GetTcpCork() const
+    bool tcpCork_;
+
+    //! WebSocket listen port; zero disables the listener.
+    //! \sa #GetWebSocketPort() const
+    std::uint16_t webSocketPort_;
 };
 //! \}
 
@@ -9,7 +9,9 @@
 #ifndef _SCRATCH_DESCRIPTOR_HPP_
 #define _SCRATCH_DESCRIPTOR_HPP_
 
+#include <scratch/protocol.hpp>
 #include <scratch/scratch.hpp>
+#include <scratch/timer_wheel.hpp>
 #include <deque>
 
 // Forward declarations.
@@ -23,6 +25,9 @@ class Player;
 class State;
 class User;
 }; // namespace Core
+namespace Utility {
+class Data;
+}; // namespace Utility
 }; // namespace Scratch
 
 namespace Scratch {
@@ -31,9 +36,10 @@ namespace Net {
 // Forward declarations.
 class Editor;
 class Menu;
-class Protocol;
+class Transport;
 
 // Boost types.
+using Address = boost::asio::ip::address;
 using ErrorCode = boost::system::error_code;
 using MutableBuffersType = boost::asio::streambuf::mutable_buffers_type;
 using Socket = boost::asio::ip::tcp::socket;
@@ -42,6 +48,7 @@ using StreamBuf = boost::asio::streambuf;
 // ScratchMUD types.
 using Command = Scratch::Core::Command;
 using CommandPtr = std::shared_ptr<Command>;
+using DataPtr = std::shared_ptr<Scratch::Utility::Data>;
 using EditorPtr = std::shared_ptr<Editor>;
 using Enumeration = Scratch::Core::Enumeration;
 using EnumerationPtr = std::shared_ptr<Enumeration>;
@@ -53,25 +60,50 @@ using Player = Scratch::Core::Player;
 using PlayerPtr = std::shared_ptr<Player>;
 using State = Scratch::Core::State;
 using StatePtr = std::shared_ptr<State>;
+using Timer = Scratch::Utility::TimerWheel::Timer;
 using User = Scratch::Core::User;
 using UserPtr = std::shared_ptr<User>;
 
+//! The output priority classes. \{
+enum OutputClass: unsigned {
+    OUT_PROMPT = 0,	//!< Prompt; redrawn after skipped output.
+    OUT_REPLY,		//!< Direct reply; never dropped.
+    OUT_ACTION,		//!< Action or social seen by others.
+    OUT_BROADCAST,	//!< Game-wide broadcast.
+    MAX_OUTPUT_CLASS	//!< Number of output classes.
+};
+//! \}
+
 //! The descriptor class. \{
 class Descriptor: public std::enable_shared_from_this<Descriptor> {
+    friend class Scratch::Core::Game;
+
 public:
     //! Constructor.
     //! \param game the game state
     //! \param socket the Boost socket
+    //! \param protocolType the wire protocol
+    //! \sa #Descriptor(Game&, std::unique_ptr<Transport>&&, const ProtocolType)
+    Descriptor(
+	Game& game,
+	Socket&& socket,
+	const ProtocolType protocolType = PROTOCOL_TELNET);
+
+    //! Constructor.
+    //! \param game the game state
+    //! \param transport the wire transport
+    //! \param protocolType the wire protocol
     Descriptor(
 	Game& game,
-	Socket&& socket);
+	std::unique_ptr<Transport>&& transport,
+	const ProtocolType protocolType = PROTOCOL_TELNET);
 
     //! Destructor.
     virtual ~Descriptor() noexcept;
 
     //! Writes to the descriptor.
     //! \param value the value to write
-    //! \sa #Write(const String&)
+    //! \sa #Write(const String&, const OutputClass)
     template<class T>
     Descriptor& operator<<(const T& value) {
 	this->Write(boost::lexical_cast<String>(value));
@@ -111,8 +143,18 @@ public:
 
     //! Delivers one application-data byte from the protocol.
     //! \param byteReceived the byte to deliver
+    //! \sa #DeliverBytes(const std::uint8_t*, const std::size_t)
     void DeliverByte(const std::uint8_t byteReceived);
 
+    //! Delivers a run of application-data bytes from the protocol.
+    //! \param bytesReceived the bytes to deliver
+    //! \param nBytes the number of bytes to deliver
+    //! \remark Whole printable lines skip the line buffer; anything else
+    //!     falls back to #DeliverByte(const std::uint8_t).
+    void DeliverBytes(
+	const std::uint8_t* bytesReceived,
+	const std::size_t nBytes);
+
     //! Returns the editor, creating one if needed.
     //! \sa #ClearEditor()
     //! \sa #GetEditor() const
@@ -133,12 +175,37 @@ public:
     //! \sa #SetCharacter(const InstancePtr&)
     void CreateCharacter(const PlayerPtr& player) noexcept;
 
+    //! Gets the remote address.
+    //! \remark Captured at construction; valid after close.
+    Address GetAddress() const noexcept {
+	return address_;
+    }
+
+    //! Gets the number of commands measured for prompt latency.
+    //! \sa #GetCommandWrites() const
+    //! \sa #GetPromptLatencyTotal() const
+    std::size_t GetCommandCount() const noexcept {
+	return commandCount_;
+    }
+
+    //! Gets the number of wire writes issued for measured commands.
+    //! \remark Each write is at least one TCP segment.
+    //! \sa #GetCommandCount() const
+    std::size_t GetCommandWrites() const noexcept {
+	return commandWrites_;
+    }
+
     //! Gets the color bit.
     //! \sa #SetColorBit(const bool)
     bool GetColorBit() const noexcept {
 	return colorBit_;
     }
 
+    //! Gets the game state.
+    Game& GetGame() noexcept {
+	return game_;
+    }
+
     //! Gets the command being edited.
     //! \sa #SetEditCommand(const CommandPtr&)
     CommandPtr GetEditCommand() const noexcept {
@@ -203,12 +270,56 @@ public:
 	return name_;
     }
 
+    //! Gets the number of input lines received.
+    //! \sa #GetInputPackets() const
+    std::size_t GetInputLines() const noexcept {
+	return inputLines_;
+    }
+
+    //! Gets the number of socket reads completed.
+    //! \remark One read per packet for interactive clients.
+    //! \sa #GetInputLines() const
+    std::size_t GetInputPackets() const noexcept {
+	return inputPackets_;
+    }
+
+    //! Gets the number of wire bytes queued.
+    //! \sa #WriteRaw(const String&)
+    std::uint64_t GetOutputBytes() const noexcept {
+	return outputBytes_;
+    }
+
+    //! Gets the number of messages dropped under backpressure.
+    //! \param outputClass the output class
+    //! \sa #WriteRaw(const String&)
+    std::size_t GetOutputDrops(const OutputClass outputClass) const noexcept {
+	return outputClass < MAX_OUTPUT_CLASS ? outputDrops_[outputClass] : 0;
+    }
+
+    //! Gets the slowest command-to-prompt latency.
+    //! \sa #GetPromptLatencyTotal() const
+    std::chrono::microseconds GetPromptLatencyMax() const noexcept {
+	return promptLatencyMax_;
+    }
+
+    //! Gets the summed command-to-prompt latency.
+    //! \sa #GetCommandCount() const
+    //! \sa #GetPromptLatencyMax() const
+    std::chrono::microseconds GetPromptLatencyTotal() const noexcept {
+	return promptLatencyTotal_;
+    }
+
     //! Gets the prompt bit.
     //! \sa #SetPromptBit(const bool)
     bool GetPromptBit() const noexcept {
 	return promptBit_;
     }
 
+    //! Gets the wire protocol type.
+    ProtocolType GetProtocolType() const noexcept {
+	return protocolType_;
+    }
+
     //! Gets the connection state.
     //! \sa #SetState(const StatePtr&)
     //! \sa #SetStateByName(const String&)
@@ -259,11 +370,14 @@ public:
 
     //! Writes to the descriptor.
     //! \param message the message to print
-    void Print(const String& message) noexcept;
+    //! \param outputClass the output priority class
+    void Print(
+	const String& message,
+	const OutputClass outputClass = OUT_REPLY) noexcept;
 
     //! Writes cells in a column-major fold.
     //! \param cells the pre-rendered cell strings
-    //! \sa #Print(const String&)
+    //! \sa #Print(const String&, const OutputClass)
     //! \sa #GetWindowWidth() const
     void PrintColumns(const std::vector<String>& cells) noexcept;
 
@@ -330,6 +444,12 @@ public:
 	editUser_ = editUser;
     }
 
+    //! Sends a GMCP message out of band.
+    //! \param package the GMCP package and message name
+    //! \param json the JSON payload, or empty
+    //! \return \c true if the protocol carried the message
+    bool SendGmcp(const String& package, const String& json);
+
     //! Sets the attached character.
     //! \param instance the instance, or null to clear
     //! \remark Does not erase the live instance.
@@ -415,26 +535,70 @@ public:
 	windowHeight_ = height;
     }
 
+    //! Restores a handed-off session and begins asynchronous I/O.
+    //! \param data the handoff record
+    //! \remark Replaces #Start() after a hot reboot. The state stack is
+    //!     restored without running Focus hooks.
+    //! \sa #SaveHandoff(const DataPtr&)
+    void Resume(const DataPtr& data);
+
+    //! Records the session for a hot reboot.
+    //! \param data the handoff record
+    //! \return \c false if the transport cannot be handed off
+    //! \sa #Resume(const DataPtr&)
+    bool SaveHandoff(const DataPtr& data);
+
     //! Begins asynchronous I/O after the descriptor is indexed by the game.
     void Start();
 
     //! Writes application output through the protocol.
     //! \param message the message to write
-    void Write(const String& message);
+    //! \param outputClass the output priority class
+    void Write(
+	const String& message,
+	const OutputClass outputClass = OUT_REPLY);
 
     //! Writes the prompt.
     void WritePrompt();
 
     //! Writes raw bytes to the wire.
     //! \param message the message to write
+    //! \remark Tagged with the output class of the enclosing #Write.
+    //!     Over \c MaxOutput, prompts, actions, and broadcasts are dropped;
+    //!     over \c MaxOutputHard, or over \c MaxOutput for longer than
+    //!     \c MaxOutputStall seconds, the descriptor is closed.
     void WriteRaw(const String& message);
 
 protected:
+    //! The remote address.
+    //! \sa #GetAddress() const
+    Address address_;
+
     //! The color bit.
     //! \sa #GetColorBit() const
     //! \sa #SetColorBit(const bool)
     bool colorBit_;
 
+    //! The number of commands measured for prompt latency.
+    //! \sa #GetCommandCount() const
+    std::size_t commandCount_;
+
+    //! Whether a command's output is still being produced.
+    //! \sa #BeginCommand()
+    //! \sa #EndCommand()
+    bool commandPending_;
+
+    //! When the pending command was received.
+    std::chrono::steady_clock::time_point commandStarted_;
+
+    //! The number of wire writes issued for measured commands.
+    //! \sa #GetCommandWrites() const
+    std::size_t commandWrites_;
+
+    //! Whether the transport is corked.
+    //! \sa #SetCork(const bool)
+    bool corked_;
+
     //! The command being edited.
     //! \sa #GetEditCommand() const
     //! \sa #SetEditCommand(const CommandPtr&)
@@ -475,10 +639,22 @@ protected:
     //! The game state.
     Game& game_;
 
+    //! The idle disconnect timer.
+    //! \remark Re-armed on every input line.
+    Timer idleTimer_;
+
     //! The input buffer.
     //! \remark Used by \ref boost::asio::async_read().
     StreamBuf input_;
 
+    //! The number of input lines received.
+    //! \sa #GetInputLines() const
+    std::size_t inputLines_;
+
+    //! The number of socket reads completed.
+    //! \sa #GetInputPackets() const
+    std::size_t inputPackets_;
+
     //! The line input buffer.
     std::ostringstream lineInput_;
 
@@ -488,6 +664,10 @@ protected:
     //! \sa #GetEditor() const
     EditorPtr editor_;
 
+    //! The login handshake timer.
+    //! \remark Cancelled by #Login(const UserPtr&).
+    Timer loginTimer_;
+
     //! The descriptor-owned menu.
     //! \sa #ClearMenu()
     //! \sa #EnsureMenu()
@@ -502,16 +682,48 @@ protected:
     //! The pending wire output buffer.
     StreamBuf output_;
 
+    //! The number of wire bytes queued.
+    //! \sa #GetOutputBytes() const
+    std::uint64_t outputBytes_;
+
+    //! The output class of the current #Write.
+    //! \remark Raw protocol output outside #Write is \c OUT_REPLY.
+    OutputClass outputClass_;
+
+    //! The number of messages dropped per output class.
+    //! \sa #GetOutputDrops(const OutputClass) const
+    std::size_t outputDrops_[MAX_OUTPUT_CLASS];
+
+    //! The number of messages skipped since the last marker.
+    //! \sa #WriteSkipped()
+    std::size_t outputSkipped_;
+
+    //! When pending output first exceeded \c MaxOutput, or zero.
+    std::time_t outputStallSince_;
+
     //! The prompt bit.
     //! \sa #GetPromptBit() const
     //! \sa #SetPromptBit(const bool)
     bool promptBit_;
 
+    //! The slowest command-to-prompt latency.
+    //! \sa #GetPromptLatencyMax() const
+    std::chrono::microseconds promptLatencyMax_;
+
+    //! The summed command-to-prompt latency.
+    //! \sa #GetPromptLatencyTotal() const
+    std::chrono::microseconds promptLatencyTotal_;
+
+    //! Whether prompt bytes were queued for the pending command.
+    bool promptQueued_;
+
     //! The wire protocol.
     std::unique_ptr<Protocol> protocol_;
 
-    //! The Boost socket.
-    Socket socket_;
+    //! The wire protocol type.
+    //! \sa #GetProtocolType() const
+    ProtocolType protocolType_;
+
 
     //! The connection state.
     //! \remark Mirrors the front of \c stateStack_.
@@ -520,10 +732,25 @@ protected:
     //! \sa #SetStateByName(const String&)
     StatePtr state_;
 
+    //! The state this descriptor is listed under, or \c nullptr.
+    //! \sa Game::IndexDescriptorState(Descriptor&)
+    const State* stateIndexed_;
+
+    //! The next descriptor listed under the same state.
+    //! \sa Game::IndexDescriptorState(Descriptor&)
+    Descriptor* stateNext_;
+
+    //! The previous descriptor listed under the same state.
+    //! \sa Game::IndexDescriptorState(Descriptor&)
+    Descriptor* statePrev_;
+
     //! The connection-state stack.
     //! \remark Front is the current state.
     std::deque<StatePtr> stateStack_;
 
+    //! The wire transport.
+    std::unique_ptr<Transport> transport_;
+
     //! The TELNET terminal type.
     //! \sa #GetTerminalType() const
     //! \sa #SetTerminalType(const String&)
@@ -558,6 +785,22 @@ protected:
     //! Whether an asynchronous write is pending.
     bool writePending_;
 
+    //! Corks the socket while a command's output is produced.
+    //! \sa #EndCommand()
+    void BeginCommand() noexcept;
+
+    //! Uncorks the socket and records prompt latency.
+    //! \remark Called once the prompt has been handed to the socket.
+    //! \sa #BeginCommand()
+    void EndCommand() noexcept;
+
+    //! Ends the command once its handler has run, if it wrote nothing.
+    //! \remark Posted behind any prompt the handler asked for, so a
+    //!     prompt or reply reaches the output buffer first and is left to
+    //!     the write completion.
+    //! \sa #EndCommand()
+    void EndCommandIfIdle();
+
     //! Ends the current line if needed.
     void EndLine();
 
@@ -567,6 +810,12 @@ protected:
     //! Configures an asynchronous write.
     void InitAsyncWrite();
 
+    //! Arms the idle disconnect timer.
+    void InitIdleTimer();
+
+    //! Arms the login disconnect timer.
+    void InitLoginTimer();
+
     //! Processes line input.
     //! \param lineReceived the line input to process
     void ReceiveLine(const String& lineReceived);
@@ -584,6 +833,21 @@ protected:
 	const String& hook,
 	const String& hookName,
 	const String& line = String());
+
+    //! Corks or uncorks the transport.
+    //! \param cork whether to cork
+    //! \remark No-op when the transport cannot cork or corking is disabled
+    //!     in Config.
+    void SetCork(const bool cork) noexcept;
+
+    //! Replaces the current connection state and relists this
+    //! descriptor in the game's state index.
+    //! \param state the new current state, or \c nullptr
+    //! \remark Every write of \ref state_ goes through here.
+    void UpdateState(StatePtr state) noexcept;
+
+    //! Queues the "messages skipped" marker once output has drained.
+    void WriteSkipped();
 };
 //! \}
 
@@ -10,21 +10,33 @@
 #define _SCRATCH_GAME_HPP_
 
 #include <scratch/action.hpp>
+#include <scratch/audience.hpp>
 #include <scratch/command.hpp>
+#include <scratch/command_profile.hpp>
+#include <scratch/command_trie.hpp>
+#include <scratch/component_store.hpp>
 #include <scratch/enumeration.hpp>
 #include <scratch/instance.hpp>
+#include <scratch/parser.hpp>
 #include <scratch/player.hpp>
+#include <scratch/protocol.hpp>
+#include <scratch/pulse.hpp>
 #include <scratch/repository.hpp>
+#include <scratch/slot_map.hpp>
 #include <scratch/scratch.hpp>
+#include <scratch/shard.hpp>
 #include <scratch/state.hpp>
 #include <scratch/string.hpp>
+#include <scratch/timer_wheel.hpp>
 #include <scratch/user.hpp>
+#include <scratch/work_pool.hpp>
 
 // Forward declarations.
 namespace Scratch {
 namespace Net {
 class Descriptor;
 class Server;
+class Transport;
 }; // namespace Net
 namespace Scripting {
 class Lua;
@@ -65,18 +77,38 @@ using LuaPtr = std::unique_ptr<Lua>;
 using PlayerRepository = Scratch::Storage::Repository<
 	Player, Scratch::Storage::MultiFileStorage<Player>>;
 using PlayerRepositoryPtr = std::shared_ptr<PlayerRepository>;
+using ProtocolType = Scratch::Net::ProtocolType;
+using Pulse = Scratch::Utility::Pulse;
 using Server = Scratch::Net::Server;
 using ServerPtr = std::shared_ptr<Server>;
+template <typename T>
+using SlotMap = Scratch::Utility::SlotMap<T>;
 using StateRepository = Scratch::Storage::Repository<
 	State, Scratch::Storage::MultiFileStorage<State>>;
 using StateRepositoryPtr = std::shared_ptr<StateRepository>;
+using TimerWheel = Scratch::Utility::TimerWheel;
+using Transport = Scratch::Net::Transport;
 using UserRepository = Scratch::Storage::Repository<
 	User, Scratch::Storage::MultiFileStorage<User>>;
 using UserRepositoryPtr = std::shared_ptr<UserRepository>;
+using WorkPool = Scratch::Utility::WorkPool;
 
 //! The game class. \{
 class Game {
 public:
+    //! One terminal type's input counters. \{
+    struct TerminalStats {
+	//! The number of sessions closed after sending input.
+	std::uint64_t sessions = 0;
+
+	//! The summed input packets.
+	std::uint64_t packets = 0;
+
+	//! The summed input lines.
+	std::uint64_t lines = 0;
+    };
+    //! \}
+
     //! Default constructor.
     Game();
 
@@ -101,12 +133,39 @@ public:
 	const ActionParam& indirect = ActionParam(),
 	const ActionParam& extra = ActionParam());
 
+    //! Verifies the state index against a full scan of the descriptors.
+    //! \return \c false if a descriptor is missing, stale, or mislinked
+    //! \remark Run after every state change when configured with
+    //!     \c --enable-debug-checks.
+    bool CheckDescriptorIndex() const noexcept;
+
+    //! Verifies the player and keyword indexes against a full scan.
+    //! \return \c false if an entry is missing, stale, or mismatched
+    //! \remark Run after every index update when configured with
+    //!     \c --enable-debug-checks.
+    bool CheckInstanceIndex() const noexcept;
+
     //! Applies Quiet and Prompt bits.
     //! \param state the connection state
     //! \sa #GetDescriptors() const
     //! \sa Descriptor::SetState(const StatePtr&)
     void ApplyStateBits(const StatePtr& state) noexcept;
 
+    //! Compiles an action message template.
+    //! \param message the message template
+    //! \return the compiled template
+    //! \remark Recently used templates are cached by text, so socials and
+    //!     scripted actions are parsed once rather than per recipient.
+    ActionTemplatePtr CompileAction(const String& message);
+
+    //! Schedules a hot reboot that keeps every connection open.
+    //! \remark Sessions are written to a handoff file and the program
+    //!     image is re-executed with the sockets inherited. Unavailable
+    //!     when \c scratch-gateway owns the connections.
+    //! \sa #CopyoverExec()
+    //! \sa #CopyoverResume()
+    void Copyover() noexcept;
+
     //! Dispatches a command line.
     //! \param performer the performing instance
     //! \param line the raw input line
@@ -127,11 +186,33 @@ public:
     //! \param performer the performing instance
     //! \return the matched command, or \c nullptr
     //! \sa Command::Allows(const InstancePtr&) const
-    //! \sa #GetCommandsIndex() const
+    //! \sa #RebuildCommandIndex()
     CommandPtr FindCommand(
 	const String& word,
 	const InstancePtr& performer) const noexcept;
 
+    //! Finds a key of \p command that another command is indexed under.
+    //! \param command the command to test
+    //! \param owner the indexed command \p command would replace, if any
+    //! \return the first conflicting name or keyword, or empty
+    //! \sa #IndexCommand(const CommandPtr&)
+    String FindCommandConflict(
+	const Command& command,
+	const CommandPtr& owner) const;
+
+    //! Gets the world audience.
+    //! \remark Holds every instance under descriptor control that has no
+    //!     narrower audience; actions are delivered by walking it.
+    Audience& GetAudience() noexcept {
+	return audience_;
+    }
+
+    //! Gets the per-command dispatch counters.
+    //! \sa #DispatchCommand(const InstancePtr&, const String&)
+    CommandProfile& GetCommandProfile() noexcept {
+	return commandProfile_;
+    }
+
     //! Gets the command repository.
     CommandRepositoryPtr GetCommands() const noexcept;
 
@@ -150,7 +231,19 @@ public:
     DescriptorPtr GetDescriptor(const String& descriptorName) noexcept;
 
     //! Gets the descriptors.
-    std::set<DescriptorPtr> GetDescriptors() const noexcept;
+    //! \remark A view of the registry; invalidated when a descriptor is
+    //!     made or erased. Erasure is posted, so walks that only print or
+    //!     close are safe.
+    const std::vector<DescriptorPtr>& GetDescriptors() const noexcept {
+	return descriptors_.GetValues();
+    }
+
+    //! Gets the open descriptors whose current state is \p state.
+    //! \param state the connection state
+    //! \return a snapshot, most recently entered first
+    //! \remark Walks only the descriptors listed under \p state.
+    //! \sa #IndexDescriptorState(Descriptor&)
+    std::vector<DescriptorPtr> GetDescriptorsIn(const StatePtr& state) const;
 
     //! Gets the enumeration repository.
     EnumerationRepositoryPtr GetEnumerations() const noexcept;
@@ -163,10 +256,38 @@ public:
     //! Gets the instance for \p player.
     //! \param player the player
     //! \return the instance, or \c nullptr
+    //! \sa #ReindexPlayer(const InstancePtr&, const PlayerPtr&)
     InstancePtr GetInstanceFor(const PlayerPtr& player) noexcept;
 
+    //! Gets the keyword instance index.
+    //! \remark Live instances with a player, keyed by player name; the
+    //!     instances whose keywords start with a prefix are the run from
+    //!     \c lower_bound(prefix).
+    //! \sa Instance::Find(const Game&, const Parser::Phrase&) const
+    const StringMultimapCi<InstancePtr>& GetInstancesIndex() const noexcept {
+	return instancesIndex_;
+    }
+
     //! Gets the instances.
-    std::set<InstancePtr> GetInstances() const noexcept;
+    //! \remark A view of the registry; invalidated when an instance is
+    //!     inserted or erased.
+    const std::vector<InstancePtr>& GetInstances() const noexcept {
+	return instances_.GetColumn<InstancePtr>();
+    }
+
+    //! Gets the instance store.
+    //! \remark Holds the hot fields of registered instances in columns
+    //!     that share the order of #GetInstances() const.
+    InstanceStore& GetInstanceStore() noexcept {
+	return instances_;
+    }
+
+    //! Gets the instance store.
+    //! \remark Holds the hot fields of registered instances in columns
+    //!     that share the order of #GetInstances() const.
+    const InstanceStore& GetInstanceStore() const noexcept {
+	return instances_;
+    }
 
     //! Gets the IO context.
     IoContext& GetIoContext() noexcept;
@@ -177,6 +298,9 @@ public:
     //! Gets the player repository.
     PlayerRepositoryPtr GetPlayers() const noexcept;
 
+    //! Gets the game pulse.
+    Pulse& GetPulse() noexcept;
+
     //! Gets the server.
     Server& GetServer() noexcept;
 
@@ -187,12 +311,31 @@ public:
     //! Gets the connection-state repository.
     StateRepositoryPtr GetStates() const noexcept;
 
+    //! Gets the input counters by terminal type.
+    //! \sa #RecordTerminalStats(const String&, const std::uint64_t, const std::uint64_t)
+    const StringMapCi<TerminalStats>& GetTerminalStats() const noexcept {
+	return terminalStats_;
+    }
+
+    //! Gets the timer wheel.
+    TimerWheel& GetTimers() noexcept;
+
     //! Gets the user repository.
     UserRepositoryPtr GetUsers() const noexcept;
 
+    //! Lists \p d under its current state, moving it off the state it
+    //! was listed under before.
+    //! \param d the descriptor
+    //! \remark Called by the descriptor whenever its current state
+    //!     changes; each state heads an intrusive list threaded through
+    //!     its descriptors.
+    //! \sa #GetDescriptorsIn(const StatePtr&) const
+    void IndexDescriptorState(Descriptor& d) noexcept;
+
     //! Inserts an instance.
     //! \param instance the instance to insert
     //! \return \c true if inserted
+    //! \remark Names the instance after its registry handle.
     bool InsertInstance(const InstancePtr& instance) noexcept;
 
     //! Loads game repositories from disk.
@@ -202,7 +345,18 @@ public:
 
     //! Constructs a descriptor.
     //! \param socket the Boost socket
-    DescriptorPtr MakeDescriptor(Socket&& socket) noexcept;
+    //! \param protocolType the wire protocol
+    DescriptorPtr MakeDescriptor(
+	Socket&& socket,
+	const ProtocolType protocolType = Scratch::Net::PROTOCOL_TELNET) noexcept;
+
+    //! Constructs a descriptor over a transport.
+    //! \param transport the wire transport
+    //! \param protocolType the wire protocol
+    //! \remark Used for sessions multiplexed by \c scratch-gateway.
+    DescriptorPtr MakeDescriptor(
+	std::unique_ptr<Transport>&& transport,
+	const ProtocolType protocolType = Scratch::Net::PROTOCOL_TELNET) noexcept;
 
     //! Parses command line arguments.
     //! \param argc the number of command line arguments
@@ -211,10 +365,41 @@ public:
 	const int argc,
 	const char **argv);
 
-    //! Rebuilds the keyword command index.
-    //! \throw std::runtime_error on keyword conflicts
+    //! Rebuilds the keyword command index and abbreviation trie.
+    //! \param strict whether a keyword conflict throws; otherwise the
+    //!     first command by ID keeps the key and the conflict is logged
+    //! \throw std::runtime_error on keyword conflicts when \p strict
+    //! \remark Needed at startup, and after a repository change whose
+    //!     patch was rejected; otherwise the command repository reports
+    //!     each change to #IndexCommand and #UnindexCommand.
     //! \sa #GetCommandsIndex() const
-    void RebuildCommandIndex();
+    void RebuildCommandIndex(const bool strict = true);
+
+    //! Adds a closed session's input counters to its terminal type and
+    //! logs the running packets per command.
+    //! \param terminalType the TTYPE, or empty if none was reported
+    //! \param packets the input packets read
+    //! \param lines the input lines delivered
+    //! \sa #GetTerminalStats() const
+    void RecordTerminalStats(
+	const String& terminalType,
+	const std::uint64_t packets,
+	const std::uint64_t lines);
+
+    //! Refreshes an indexed command after its keys or permissions change.
+    //! \param command the command
+    //! \return \c false on a conflict, after rebuilding the index;
+    //!     commands not in the index are ignored
+    //! \sa #IndexCommand(const CommandPtr&)
+    bool ReindexCommand(const CommandPtr& command);
+
+    //! Updates the player index after a live instance changes player.
+    //! \param instance the instance
+    //! \param previous the player it had before
+    //! \sa Instance::SetPlayer(const PlayerPtr&)
+    void ReindexPlayer(
+	const InstancePtr& instance,
+	const PlayerPtr& previous) noexcept;
 
     //! Runs the game.
     virtual void Run();
@@ -223,21 +408,64 @@ public:
     //! \param command the command
     //! \param performer the performing instance
     //! \param line the remainder after the matched word
+    //! \sa #RunCommandHook(const CommandPtr&, const InstancePtr&, Parser&)
     void RunCommandHook(
 	const CommandPtr& command,
 	const InstancePtr& performer,
 	const String& line);
 
+    //! Runs a command Action Lua hook on an already tokenized line.
+    //! \param command the command
+    //! \param performer the performing instance
+    //! \param parser the line, with the matched word skipped
+    //! \remark \c line is the parser's remainder; socials reuse its words.
+    void RunCommandHook(
+	const CommandPtr& command,
+	const InstancePtr& performer,
+	Parser& parser);
+
     //! Runs social templates for \p actor.
     //! \param actor the performing instance
     //! \param social the social templates
     //! \param line the remainder after the matched command word
-    //! \sa #RunCommandHook(const CommandPtr&, const InstancePtr&, const String&)
+    //! \sa #RunSocial(const InstancePtr&, const SocialPtr&, Parser&)
     void RunSocial(
 	const InstancePtr& actor,
 	const SocialPtr& social,
 	const String& line);
 
+    //! Runs social templates for \p actor on an already tokenized line.
+    //! \param actor the performing instance
+    //! \param social the social templates
+    //! \param parser the line, with the matched word skipped
+    //! \sa #RunCommandHook(const CommandPtr&, const InstancePtr&, Parser&)
+    void RunSocial(
+	const InstancePtr& actor,
+	const SocialPtr& social,
+	Parser& parser);
+
+    //! Sets or erases a Lua instance pulse hook.
+    //! \param name the hook name, also its Caller identity
+    //! \param every the pulse interval, at least one
+    //! \param source the Lua source, or empty to erase the hook
+    //! \remark The hook runs once per instance on a shard's worker Lua
+    //!     state, with \c pulse, \c name, and \c player set.
+    //! \sa #RunInstancePulseHooks(const std::uint64_t)
+    void SetInstancePulseHook(
+	const String& name,
+	const unsigned every,
+	const String& source);
+
+    //! Sets or erases a Lua pulse hook.
+    //! \param name the hook name, also its Caller identity
+    //! \param every the pulse interval, at least one
+    //! \param source the Lua source, or empty to erase the hook
+    //! \sa #RunPulseHooks(const std::uint64_t)
+    void SetPulseHook(
+	const String& name,
+	const unsigned every,
+	const String& source);
+
     //! Sets the shutdown flag.
     //! \param shutdown the shutdown flag value
     //! \sa #GetShutdown() const
@@ -245,9 +473,17 @@ public:
     void SetShutdown(const bool shutdown) noexcept;
 
 protected:
+    //! Indexes a command under its current name and keywords, replacing
+    //! any keys it was indexed under before.
+    //! \param command the command
+    //! \return \c false on a conflict, leaving the index unchanged
+    //! \remark Patches only the affected index and trie entries.
+    //! \sa #UnindexCommand(const CommandPtr&)
+    bool IndexCommand(const CommandPtr& command);
+
     //! Expands and prints one action message.
     //! \param metacolor the message metacolor
-    //! \param message the message template
+    //! \param compiled the compiled message template
     //! \param subject the subject slot
     //! \param direct the direct slot
     //! \param indirect the indirect slot
@@ -257,7 +493,7 @@ protected:
     //! \sa #Action
     void ActionPerform(
 	const Color::ColorEnum metacolor,
-	const String& message,
+	const ActionTemplate& compiled,
 	const ActionParam& subject,
 	const ActionParam& direct,
 	const ActionParam& indirect,
@@ -265,19 +501,76 @@ protected:
 	const InstancePtr& recipient,
 	Descriptor& to);
 
+    //! Writes the handoff file and re-executes the program.
+    //! \remark Returns only if the hot reboot failed.
+    //! \sa #Copyover()
+    void CopyoverExec() noexcept;
+
+    //! Rebuilds the acceptor and descriptors from the handoff file.
+    //! \return \c true if the handed-off acceptor was adopted
+    //! \sa #Copyover()
+    bool CopyoverResume();
+
     //! Begins waiting for process termination signals.
     void InitSignals();
 
+    //! Runs the Lua instance pulse hooks due on \p pulse across the
+    //! shards, then applies their deferred effects.
+    //! \param pulse the pulse number
+    //! \sa #SetInstancePulseHook(const String&, const unsigned, const String&)
+    void RunInstancePulseHooks(const std::uint64_t pulse);
+
+    //! Runs the Lua pulse hooks due on \p pulse with \c pulse.
+    //! \param pulse the pulse number
+    //! \sa #SetPulseHook(const String&, const unsigned, const String&)
+    void RunPulseHooks(const std::uint64_t pulse);
+
     //! Stops the acceptor, descriptors, and I/O context.
     //! \sa #SetShutdown(const bool)
     void Shutdown() noexcept;
 
+    //! Drops a command from the keyword index and abbreviation trie.
+    //! \param command the command
+    //! \sa #IndexCommand(const CommandPtr&)
+    void UnindexCommand(const CommandPtr& command) noexcept;
+
+    //! Unlinks \p d from the state index.
+    //! \param d the descriptor
+    //! \sa #IndexDescriptorState(Descriptor&)
+    void UnindexDescriptorState(Descriptor& d) noexcept;
+
+    //! Drops \p instance from the player and keyword indexes.
+    //! \param instance the instance
+    //! \param player the player it was indexed under
+    void UnindexPlayer(
+	const InstancePtr& instance,
+	const PlayerPtr& player) noexcept;
+
     //! The IO context.
     //! \sa #GetIoContext() const
     //! \remark Must precede ASIO-dependent members (\ref descriptors_,
-    //!     \ref server_, \ref signals_) so it outlives them on teardown.
+    //!     \ref pulse_, \ref server_, \ref signals_, \ref timers_) so it
+    //!     outlives them
+    //!     on teardown.
     IoContext ioContext_;
 
+    //! The compiled action templates, most recently used first.
+    //! \sa #CompileAction(const String&)
+    std::list<std::pair<String, ActionTemplatePtr>> actionTemplates_;
+
+    //! The compiled action templates by text.
+    //! \sa #CompileAction(const String&)
+    std::map<String, decltype(actionTemplates_)::iterator>
+	actionTemplatesIndex_;
+
+    //! The world audience.
+    //! \sa #GetAudience()
+    Audience audience_;
+
+    //! The per-command dispatch counters.
+    //! \sa #GetCommandProfile()
+    CommandProfile commandProfile_;
+
     //! The command repository.
     //! \sa #GetCommands() const
     CommandRepositoryPtr commands_;
@@ -287,21 +580,50 @@ protected:
     //! \sa #RebuildCommandIndex()
     StringMapCi<CommandPtr> commandsIndex_;
 
+    //! The keys each indexed command holds in \ref commandsIndex_.
+    //! \sa #IndexCommand(const CommandPtr&)
+    std::unordered_map<const Command*, StringSetCi> commandsKeys_;
+
+    //! The command abbreviation trie.
+    //! \sa #FindCommand(const String&, const InstancePtr&) const
+    //! \sa #RebuildCommandIndex()
+    CommandTrie commandsTrie_;
+
     //! The host configuration.
     //! \sa #GetConfig() const
     ConfigPtr config_;
 
+    //! Whether the program was started by a hot reboot.
+    //! \sa #ParseArguments(const int, const char**)
+    bool copyoverBit_;
+
+    //! The head of each state's descriptor list.
+    //! \sa #IndexDescriptorState(Descriptor&)
+    std::unordered_map<const State*, Descriptor*> descriptorsByState_;
+
     //! The descriptors.
     //! \sa #GetDescriptors() const
-    StringMapCi<DescriptorPtr> descriptors_;
+    //! \remark Names are the base-36 handles, so lookup by name is O(1).
+    SlotMap<DescriptorPtr> descriptors_;
 
     //! The enumeration repository.
     //! \sa #GetEnumerations() const
     EnumerationRepositoryPtr enumerations_;
 
-    //! The instances.
+    //! The keyword instance index.
+    //! \sa #GetInstancesIndex() const
+    StringMultimapCi<InstancePtr> instancesIndex_;
+
+    //! The live instances by player.
+    //! \sa #GetInstanceFor(const PlayerPtr&)
+    std::unordered_map<const Player*, InstancePtr> instancesByPlayer_;
+
+    //! The instances, with their name, gender, player, and controlling
+    //!     descriptor in parallel columns so scans stay in contiguous
+    //!     memory.
     //! \sa #GetInstances() const
-    StringMapCi<InstancePtr> instances_;
+    //! \remark Names are the base-36 handles, so lookup by name is O(1).
+    InstanceStore instances_;
 
     //! The Lua facade.
     //! \sa #GetLua()
@@ -311,6 +633,46 @@ protected:
     //! \sa #GetPlayers() const
     PlayerRepositoryPtr players_;
 
+    //! The program path from the command line.
+    //! \sa #CopyoverExec()
+    String programName_;
+
+    //! The game pulse.
+    //! \sa #GetPulse()
+    Pulse pulse_;
+
+    //! One Lua pulse hook. \{
+    struct PulseHook {
+	//! The pulse interval.
+	unsigned every;
+
+	//! The Lua source.
+	String source;
+    };
+    //! \}
+
+    //! The Lua pulse hooks by name.
+    //! \sa #SetPulseHook(const String&, const unsigned, const String&)
+    StringMapCi<PulseHook> pulseHooks_;
+
+    //! The Lua instance pulse hooks by name.
+    //! \sa #SetInstancePulseHook(const String&, const unsigned, const String&)
+    StringMapCi<PulseHook> instancePulseHooks_;
+
+    //! The work pool that runs the shards.
+    //! \remark Built by #Run() from \c PulseThreads.
+    std::unique_ptr<WorkPool> pulsePool_;
+
+    //! The instance shards.
+    //! \remark Built by #Run() from \c PulseShards, and kept until
+    //!     destruction since #Shutdown() may run from a shard's
+    //!     deferred command.
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    //! The dense store positions of each shard's instances.
+    //! \remark Refilled every pulse; kept to reuse the allocations.
+    std::vector<std::vector<std::size_t>> shardPositions_;
+
     //! The server.
     //! \sa #GetServer()
     ServerPtr server_;
@@ -328,6 +690,19 @@ protected:
     //! \sa #GetStates() const
     StateRepositoryPtr states_;
 
+    //! The input counters by terminal type.
+    //! \sa #GetTerminalStats() const
+    StringMapCi<TerminalStats> terminalStats_;
+
+    //! The timer wheel.
+    //! \sa #GetTimers()
+    TimerWheel timers_;
+
+    //! The hot reboot delay timer.
+    //! \remark Must follow \ref timers_.
+    //! \sa #Copyover()
+    TimerWheel::Timer copyoverTimer_;
+
     //! The user repository.
     //! \sa #GetUsers() const
     UserRepositoryPtr users_;
@@ -0,0 +1,161 @@
+//! \file gateway.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_GATEWAY_HPP_
+#define _SCRATCH_GATEWAY_HPP_
+
+#include <scratch/gateway_frame.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/transport.hpp>
+
+// Forward declarations.
+namespace Scratch {
+namespace Core {
+class Game;
+}; // namespace Core
+}; // namespace Scratch
+
+namespace Scratch {
+namespace Net {
+
+// Forward declarations.
+class Admission;
+class GatewayTransport;
+
+// Boost types.
+using LocalAcceptor = boost::asio::local::stream_protocol::acceptor;
+using LocalSocket = boost::asio::local::stream_protocol::socket;
+
+// ScratchMUD types.
+using Game = Scratch::Core::Game;
+
+//! The gateway channel multiplexer. \{
+//! \remark Listens on a Unix socket for \c scratch-gateway and builds a
+//!     descriptor over a GatewayTransport for each session it opens. One
+//!     gateway is served at a time; a new connection replaces the old.
+class Gateway: public std::enable_shared_from_this<Gateway> {
+public:
+    //! Constructor.
+    //! \param game the game state
+    //! \param admission the connection admission control
+    Gateway(
+	Game& game,
+	Admission& admission) noexcept;
+
+    //! Destructor.
+    ~Gateway() noexcept;
+
+    //! Drops a session from the session table.
+    //! \param session the session ID
+    void EraseSession(const std::uint32_t session) noexcept;
+
+    //! Returns whether the channel socket is listening.
+    bool IsListening() const noexcept {
+	return acceptor_.is_open();
+    }
+
+    //! Queues frames for the gateway.
+    //! \param type the frame type
+    //! \param session the session ID
+    //! \param data the payload
+    //! \param nBytes the size of \p data
+    //! \param handler called with \p nBytes once the frames reach the
+    //!     channel, or with an error if the channel is lost first
+    void Send(
+	const GatewayFrameType type,
+	const std::uint32_t session,
+	const char* data = nullptr,
+	const std::size_t nBytes = 0,
+	Transport::Handler handler = Transport::Handler());
+
+    //! Listens for the gateway.
+    //! \param path the Unix socket path
+    //! \remark Removes a stale socket file left at \p path.
+    //! \sa #Stop()
+    void Start(const String& path);
+
+    //! Stops listening and closes the channel and every session.
+    //! \sa #Start(const String&)
+    void Stop();
+
+protected:
+    //! A queued write completion.
+    using PendingWrite = std::pair<Transport::Handler, std::size_t>;
+
+    //! The channel socket listener.
+    LocalAcceptor acceptor_;
+
+    //! The connection admission control.
+    Admission& admission_;
+
+    //! The connected gateway.
+    LocalSocket channel_;
+
+    //! Bumped whenever the channel closes, so completions queued for an
+    //! old channel are dropped.
+    unsigned channelSerial_;
+
+    //! The game state.
+    Game& game_;
+
+    //! Bytes read from the channel.
+    char input_[8192];
+
+    //! Frames queued behind the write in flight.
+    String output_;
+
+    //! Completions for \ref output_.
+    std::vector<PendingWrite> outputHandlers_;
+
+    //! The channel socket path.
+    String path_;
+
+    //! The channel frame decoder.
+    GatewayFrameReader reader_;
+
+    //! Open sessions by ID.
+    std::unordered_map<std::uint32_t, GatewayTransport*> sessions_;
+
+    //! Whether a channel write is in flight.
+    bool writePending_;
+
+    //! Frames in flight.
+    String writing_;
+
+    //! Completions for \ref writing_.
+    std::vector<PendingWrite> writingHandlers_;
+
+    //! Closes the channel and tells every session its client is gone.
+    void CloseChannel();
+
+    //! Configures an asynchronous accept.
+    void InitAsyncAccept();
+
+    //! Configures an asynchronous channel read.
+    void InitAsyncRead();
+
+    //! Configures an asynchronous channel write.
+    void InitAsyncWrite();
+
+    //! Dispatches one frame from the gateway.
+    //! \param frame the frame
+    void OnFrame(const GatewayFrame& frame);
+
+    //! Screens a new session and builds its descriptor.
+    //! \param session the session ID
+    //! \param addressText the remote address reported by the gateway
+    void OpenSession(
+	const std::uint32_t session,
+	const String& addressText);
+};
+//! \}
+
+}; // namespace Net
+}; // namespace Scratch
+
+#endif // _SCRATCH_GATEWAY_HPP_
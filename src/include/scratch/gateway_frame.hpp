@@ -0,0 +1,108 @@
+//! \file gateway_frame.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_GATEWAY_FRAME_HPP_
+#define _SCRATCH_GATEWAY_FRAME_HPP_
+
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Net {
+
+//! The gateway frame types. \{
+//! \remark Every frame is a one-byte type, a four-byte session ID and a
+//!     four-byte payload length, both big-endian, then the payload.
+enum GatewayFrameType: std::uint8_t {
+    GATEWAY_OPEN = 1,		//!< Gateway to game: a session opened; payload is the remote address.
+    GATEWAY_DATA,		//!< Either way: wire bytes for a session.
+    GATEWAY_CLOSE,		//!< Either way: a session closed; no payload.
+    GATEWAY_CORK		//!< Game to gateway: one byte, non-zero to cork.
+};
+//! \}
+
+//! The size of a gateway frame header, in bytes.
+const std::size_t GatewayHeaderSize = 9;
+
+//! The largest gateway frame payload, in bytes.
+const std::size_t GatewayMaxPayload = 65536;
+
+//! One decoded gateway frame. \{
+struct GatewayFrame {
+    //! The frame type.
+    GatewayFrameType type;
+
+    //! The session ID.
+    std::uint32_t session;
+
+    //! The payload.
+    String payload;
+};
+//! \}
+
+//! Appends frames carrying \p data to \p output, splitting \p data at
+//! #GatewayMaxPayload.
+//! \param output the encoded stream
+//! \param type the frame type
+//! \param session the session ID
+//! \param data the payload
+//! \param nBytes the size of \p data
+//! \remark Always appends at least one frame, so an empty payload still
+//!     reaches the peer.
+void AppendGatewayFrames(
+	String& output,
+	const GatewayFrameType type,
+	const std::uint32_t session,
+	const char* data = nullptr,
+	const std::size_t nBytes = 0);
+
+//! The gateway frame decoder. \{
+//! \remark Accepts the stream in arbitrary pieces.
+class GatewayFrameReader {
+public:
+    //! Default constructor.
+    GatewayFrameReader() noexcept;
+
+    //! Appends bytes read from the channel.
+    //! \param data the bytes
+    //! \param nBytes the number of bytes
+    void Feed(
+	const char* data,
+	const std::size_t nBytes);
+
+    //! Returns whether the stream held a malformed frame.
+    bool IsFailed() const noexcept {
+	return failed_;
+    }
+
+    //! Decodes the next complete frame.
+    //! \param frame set to the frame
+    //! \return \c false if no complete frame is buffered or the stream
+    //!     is malformed
+    //! \sa #IsFailed() const
+    bool Next(GatewayFrame& frame);
+
+    //! Discards buffered bytes and clears the failure flag.
+    void Reset() noexcept;
+
+protected:
+    //! Buffered bytes not yet decoded.
+    String buffer_;
+
+    //! Whether the stream held a malformed frame.
+    //! \sa #IsFailed() const
+    bool failed_;
+
+    //! Offset of the first undecoded byte in \ref buffer_.
+    std::size_t position_;
+};
+//! \}
+
+}; // namespace Net
+}; // namespace Scratch
+
+#endif // _SCRATCH_GATEWAY_FRAME_HPP_
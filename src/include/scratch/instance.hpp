@@ -9,6 +9,7 @@
 #ifndef _SCRATCH_INSTANCE_HPP_
 #define _SCRATCH_INSTANCE_HPP_
 
+#include <scratch/component_store.hpp>
 #include <scratch/gender.hpp>
 #include <scratch/parser.hpp>
 #include <scratch/player.hpp>
@@ -25,6 +26,7 @@ namespace Scratch {
 namespace Core {
 
 // Forward declarations.
+class Audience;
 class Game;
 
 // ScratchMUD types.
@@ -33,14 +35,21 @@ using DescriptorPtr = std::shared_ptr<Descriptor>;
 using WeakDescriptorPtr = std::weak_ptr<Descriptor>;
 
 //! The instance class. \{
+//! \remark While registered, the name, gender, player, and controlling
+//!     descriptor live in the game's instance store columns and the
+//!     accessors resolve them through the handle; the members hold them
+//!     only while the instance is unregistered.
 class Instance : public std::enable_shared_from_this<Instance> {
+    friend class Audience;
+    friend class Game;
+
 public:
     //! Default constructor.
     Instance() noexcept;
 
     //! Copy constructor.
     //! \param other the \sa instance to copy
-    //! \remark Controlling descriptor not copied.
+    //! \remark Controlling descriptor, audience, and registry not copied.
     Instance(const Instance& other) noexcept;
 
     //! Destructor.
@@ -48,7 +57,8 @@ public:
 
     //! Default assignment.
     //! \param other the \sa instance to assign
-    //! \remark Controlling descriptor not assigned.
+    //! \remark Controlling descriptor, audience, and registry not
+    //!     assigned.
     Instance& operator=(const Instance& other) noexcept;
 
     //! Finds an instance matching \p line.
@@ -67,27 +77,31 @@ public:
 	const Game& game,
 	const Parser::Phrase& phrase) const noexcept;
 
+    //! Gets the audience this instance belongs to, or \c nullptr.
+    Audience* GetAudience() const noexcept {
+	return audience_;
+    }
+
     //! Gets the controlling descriptor.
     //! \sa #SetDescriptor(const DescriptorPtr&)
     DescriptorPtr GetDescriptor() noexcept;
 
     //! Gets the gender.
     //! \sa #SetGender(Gender::GenderEnum)
-    Gender::GenderEnum GetGender() const noexcept {
-	return gender_;
+    Gender::GenderEnum GetGender() const noexcept;
+
+    //! Gets the registry handle, or zero when unregistered.
+    Scratch::Utility::SlotHandle GetHandle() const noexcept {
+	return handle_;
     }
 
     //! Gets the instance name.
     //! \sa #SetName(const String&)
-    String GetName() const noexcept {
-	return name_;
-    }
+    String GetName() const noexcept;
 
     //! Gets the player.
     //! \sa #SetPlayer(const PlayerPtr&)
-    PlayerPtr GetPlayer() const noexcept {
-	return player_;
-    }
+    PlayerPtr GetPlayer() const noexcept;
 
     //! Matches \p name against this instance.
     //! \param seeker the searching instance, or null
@@ -117,9 +131,7 @@ public:
     //! Sets the instance name.
     //! \param name the instance name
     //! \sa #GetName() const
-    void SetName(const String& name) {
-	name_ = name;
-    }
+    void SetName(const String& name);
 
     //! Sets the player.
     //! \param player the player
@@ -127,31 +139,68 @@ public:
     void SetPlayer(const PlayerPtr& player) noexcept;
 
 protected:
-    //! The controlling descriptor.
+    //! The audience this instance belongs to.
+    //! \sa #GetAudience() const
+    Audience* audience_;
+
+    //! The slot in #audience_ members.
+    std::size_t audienceSlot_;
+
+    //! The controlling descriptor while unregistered.
     //! \sa #GetDescriptor()
     //! \sa #SetDescriptor(const DescriptorPtr&)
     WeakDescriptorPtr descriptor_;
 
-    //! The gender.
+    //! The game this instance is registered with, or \c nullptr.
+    //! \sa Game::InsertInstance(const InstancePtr&)
+    Game* game_;
+
+    //! The gender while unregistered.
     //! \sa #GetGender() const
     //! \sa #SetGender(Gender::GenderEnum)
     Gender::GenderEnum gender_;
 
-    //! The instance name.
+    //! The registry handle, or zero when unregistered.
+    //! \sa Game::InsertInstance(const InstancePtr&)
+    Scratch::Utility::SlotHandle handle_;
+
+    //! The instance name while unregistered.
     //! \sa #GetName() const
     //! \sa #SetName(const String&)
     String name_;
 
-    //! The player.
+    //! The player while unregistered.
     //! \sa #GetPlayer() const
     //! \sa #SetPlayer(const PlayerPtr&)
     PlayerPtr player_;
+
+    //! Moves the fields out of the store columns and unregisters.
+    //! \remark Called by the game just before the store entry is erased.
+    //! \sa Game::EraseInstance(const InstancePtr&)
+    void Detach() noexcept;
+
+    //! Gets a field from its store column while registered.
+    //! \param detached the member holding it while unregistered
+    //! \return the column entry, or \p detached
+    template <typename T>
+    const T& GetField(const T& detached) const noexcept;
+
+    //! Gets a field from its store column while registered.
+    //! \param detached the member holding it while unregistered
+    //! \return the column entry, or \p detached
+    template <typename T>
+    T& GetField(T& detached) noexcept;
 };
 //! \}
 
 //! The type of a shared instance pointer.
 using InstancePtr = std::shared_ptr<Instance>;
 
+//! The type of the instance registry.
+//! \remark One column per hot field, in the order the game scans them.
+using InstanceStore = Scratch::Utility::ComponentStore<
+	InstancePtr, String, Gender::GenderEnum, PlayerPtr, WeakDescriptorPtr>;
+
 }; // namespace Core
 }; // namespace Scratch
 
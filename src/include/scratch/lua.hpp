@@ -59,9 +59,19 @@ public:
     };
     //! \}
 
+    //! The binding sets. \{
+    enum Bindings {
+	BINDINGS_GAME,	//!< Every binding; game thread only.
+	BINDINGS_SHARD	//!< Shard bindings only; safe on a pulse worker.
+    };
+    //! \}
+
     //! Constructor.
     //! \param game the game state
-    explicit Lua(Game& game);
+    //! \param bindings the binding set to register
+    explicit Lua(
+	Game& game,
+	const Bindings bindings = BINDINGS_GAME);
 
     //! Copy constructor.
     Lua(const Lua&) = delete;
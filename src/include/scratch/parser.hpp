@@ -19,8 +19,26 @@ namespace Core {
 using StringSetCi = Scratch::StringSetCi;
 
 //! The parser class. \{
+//! \remark Tokenizes a borrowed line in place: words are kept as offsets
+//!     into the line and counts are read without conversion, so a parse
+//!     of an ordinary command line allocates nothing. The line must
+//!     outlive the parser and every phrase taken from it.
 class Parser {
 public:
+    //! One word of the line. \{
+    struct Span {
+	//! The offset of the first character.
+	std::size_t offset;
+
+	//! The number of characters.
+	std::size_t length;
+    };
+    //! \}
+
+    //! The span list type; short lists are stored inline.
+    template <std::size_t N>
+    using Spans = boost::container::small_vector<Span, N>;
+
     //! The phrase class. \{
     class Phrase {
     public:
@@ -43,9 +61,7 @@ public:
 
 	//! Gets the delimiter that opened this phrase.
 	//! \sa #delimiter_
-	String GetDelimiter() const noexcept {
-	    return delimiter_;
-	}
+	String GetDelimiter() const;
 
 	//! Gets the 1-based ordinal.
 	//! \sa #nth_
@@ -53,12 +69,22 @@ public:
 	    return nth_;
 	}
 
-	//! Gets the name words.
-	//! \sa #words_
-	const std::vector<String>& GetWords() const noexcept {
-	    return words_;
+	//! Gets the name word at \p index.
+	//! \param index the word index
+	//! \return the word, or empty if \p index is out of range
+	//! \sa #GetWordCount() const
+	StringView GetWord(const std::size_t index) const noexcept;
+
+	//! Gets the number of name words.
+	//! \sa #GetWord(const std::size_t) const
+	std::size_t GetWordCount() const noexcept {
+	    return words_.size();
 	}
 
+	//! Gets copies of the name words.
+	//! \sa #GetWord(const std::size_t) const
+	std::vector<String> GetWords() const;
+
     protected:
 	friend class Parser;
 
@@ -66,35 +92,61 @@ public:
 	//! \sa #GetCount() const
 	unsigned count_;
 
-	//! Delimiter that opened this phrase.
+	//! Delimiter that opened this phrase; empty for the first.
 	//! \sa #GetDelimiter() const
-	String delimiter_;
+	Span delimiter_;
+
+	//! The borrowed line.
+	const char* line_;
 
 	//! 1-based ordinal.
 	//! \sa #GetNth() const
 	unsigned nth_;
 
 	//! Name words.
-	//! \sa #GetWords() const
-	std::vector<String> words_;
+	//! \sa #GetWord(const std::size_t) const
+	Spans<4> words_;
     };
     //! \}
 
     //! Default constructor.
     Parser() noexcept;
 
+    //! Copy constructor.
+    //! \remark Phrases keep pointing at the same borrowed line.
+    Parser(const Parser&) = default;
+
+    //! Copy assignment operator.
+    Parser& operator=(const Parser&) = default;
+
     //! Returns the phrase at \p index.
     //! \param index the phrase index
     //! \return the phrase, or an empty phrase if \p index is out of range
     //! \sa #GetSize() const
     const Phrase& GetPhrase(const std::size_t index) const noexcept;
 
+    //! Returns the text from the first unskipped word to the last.
+    //! \sa #Skip(const std::size_t)
+    String GetRemainder() const;
+
     //! Returns the number of phrases.
     //! \sa #GetPhrase(const std::size_t) const
     std::size_t GetSize() const noexcept {
 	return phrases_.size();
     }
 
+    //! Returns the unskipped word at \p index.
+    //! \param index the word index
+    //! \return the word, or empty if \p index is out of range
+    //! \sa #GetTokenCount() const
+    StringView GetToken(const std::size_t index) const noexcept;
+
+    //! Returns the number of unskipped words.
+    //! \sa #GetToken(const std::size_t) const
+    std::size_t GetTokenCount() const noexcept {
+	return tokens_.size() - first_;
+    }
+
     //! Parses \p line with no delimiters.
     //! \param line the targeting line
     //! \return \c true if \p line is valid
@@ -110,21 +162,59 @@ public:
 	const String& line,
 	const StringSetCi& delimiters) noexcept;
 
+    //! Groups the unskipped words into phrases split by \p delimiters.
+    //! \param delimiters caller-supplied function words
+    //! \return \c true if the words are valid
+    //! \sa #Tokenize(const String&)
+    bool ParsePhrases(const StringSetCi& delimiters) noexcept;
+
+    //! Skips the next \p n words, such as a command word already matched.
+    //! \param n the number of words
+    //! \sa #GetRemainder() const
+    void Skip(const std::size_t n) noexcept;
+
+    //! Splits \p line into words without grouping phrases.
+    //! \param line the line to borrow
+    //! \sa #ParsePhrases(const StringSetCi&)
+    void Tokenize(const String& line) noexcept;
+
 protected:
-    //! Fills \p phrase from \p tokens.
-    //! \param tokens the phrase tokens
+    //! Reads \p word as a decimal count.
+    //! \param word the word
+    //! \param value the value read
+    //! \return \c false unless \p word is all digits and fits
+    static bool ParseNumber(
+	const StringView& word,
+	unsigned& value) noexcept;
+
+    //! Fills \p phrase from the unskipped words \p begin to \p end.
+    //! \param begin the first word
+    //! \param end one past the last word
     //! \param delimiter the delimiter that opened this phrase
     //! \param phrase the phrase to fill
-    //! \return \c false if the tokens are illegal
-    static bool ParsePhrase(
-	const std::vector<String>& tokens,
-	const String& delimiter,
-	Phrase& phrase) noexcept;
+    //! \return \c false if the words are illegal
+    bool ParsePhrase(
+	std::size_t begin,
+	std::size_t end,
+	const Span& delimiter,
+	Phrase& phrase) const noexcept;
+
+    //! The index of the first unskipped word.
+    //! \sa #Skip(const std::size_t)
+    std::size_t first_;
+
+    //! The borrowed line.
+    //! \sa #Tokenize(const String&)
+    const char* line_;
 
     //! Parsed phrases.
     //! \sa #GetPhrase(const std::size_t) const
     //! \sa #GetSize() const
-    std::vector<Phrase> phrases_;
+    boost::container::small_vector<Phrase, 2> phrases_;
+
+    //! The words of the line.
+    //! \sa #GetToken(const std::size_t) const
+    Spans<8> tokens_;
 };
 //! \}
 
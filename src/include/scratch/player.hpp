@@ -12,6 +12,7 @@
 #include <scratch/gender.hpp>
 #include <scratch/scratch.hpp>
 #include <scratch/string.hpp>
+#include <scratch/symbol_table.hpp>
 #include <scratch/thing.hpp>
 
 // Forward declarations.
@@ -52,6 +53,7 @@ public:
     //! \sa #SetPermissions(const StringSetCi&)
     void AddPermission(const String& permission) {
 	permissions_.insert(permission);
+	SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
     }
 
     //! Adds a preference.
@@ -61,6 +63,7 @@ public:
     //! \sa #SetPreferences(const StringSetCi&)
     void AddPreference(const String& preference) {
 	preferences_.insert(preference);
+	SymbolTable::Preferences().MakeBits(preferences_, preferenceBits_);
     }
 
     //! Erases a permission.
@@ -70,6 +73,7 @@ public:
     //! \sa #SetPermissions(const StringSetCi&)
     void ErasePermission(const String& permission) {
 	permissions_.erase(permission);
+	SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
     }
 
     //! Erases a preference.
@@ -79,6 +83,7 @@ public:
     //! \sa #SetPreferences(const StringSetCi&)
     void ErasePreference(const String& preference) {
 	preferences_.erase(preference);
+	SymbolTable::Preferences().MakeBits(preferences_, preferenceBits_);
     }
 
     //! Gets the gender.
@@ -93,12 +98,24 @@ public:
 	return owner_;
     }
 
+    //! Gets the permissions as interned symbols.
+    //! \sa SymbolTable::Permissions()
+    const SymbolBits& GetPermissionBits() const noexcept {
+	return permissionBits_;
+    }
+
     //! Gets the permissions.
     //! \sa #SetPermissions(const StringSetCi&)
     StringSetCi GetPermissions() const noexcept {
 	return permissions_;
     }
 
+    //! Gets the preferences as interned symbols.
+    //! \sa SymbolTable::Preferences()
+    const SymbolBits& GetPreferenceBits() const noexcept {
+	return preferenceBits_;
+    }
+
     //! Gets the preferences.
     //! \sa #SetPreferences(const StringSetCi&)
     StringSetCi GetPreferences() const noexcept {
@@ -114,6 +131,14 @@ public:
 	return permissions_.find(permission) != permissions_.end();
     }
 
+    //! Returns whether the interned permission \p symbol is present.
+    //! \param symbol the permission symbol to test
+    //! \sa #HasPermission(const String&) const
+    //! \sa SymbolTable::Permissions()
+    bool HasPermission(const unsigned symbol) const noexcept {
+	return SymbolTable::Test(permissionBits_, symbol);
+    }
+
     //! Returns whether \p preference is present.
     //! \param preference the preference to test
     //! \sa #AddPreference(const String&)
@@ -123,6 +148,14 @@ public:
 	return preferences_.find(preference) != preferences_.end();
     }
 
+    //! Returns whether the interned preference \p symbol is present.
+    //! \param symbol the preference symbol to test
+    //! \sa #HasPreference(const String&) const
+    //! \sa SymbolTable::Preferences()
+    bool HasPreference(const unsigned symbol) const noexcept {
+	return SymbolTable::Test(preferenceBits_, symbol);
+    }
+
     //! Reads this player from a data node.
     //! \param data the data node to read
     //! \sa #WriteData(const DataPtr&) const
@@ -159,6 +192,7 @@ public:
     //! \sa #GetPermissions() const
     void SetPermissions(const StringSetCi& permissions) {
 	permissions_ = permissions;
+	SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
     }
 
     //! Sets the preferences.
@@ -166,6 +200,7 @@ public:
     //! \sa #GetPreferences() const
     void SetPreferences(const StringSetCi& preferences) {
 	preferences_ = preferences;
+	SymbolTable::Preferences().MakeBits(preferences_, preferenceBits_);
     }
 
     //! Writes this player to a data node.
@@ -201,10 +236,20 @@ protected:
     //! \sa #SetPermissions(const StringSetCi&)
     StringSetCi permissions_;
 
+    //! The interned permissions; names past SymbolTable::MaxSymbols
+    //!     are absent.
+    //! \sa #GetPermissionBits() const
+    SymbolBits permissionBits_;
+
     //! The preferences.
     //! \sa #GetPreferences() const
     //! \sa #SetPreferences(const StringSetCi&)
     StringSetCi preferences_;
+
+    //! The interned preferences; names past SymbolTable::MaxSymbols
+    //!     are absent.
+    //! \sa #GetPreferenceBits() const
+    SymbolBits preferenceBits_;
 };
 //! \}
 
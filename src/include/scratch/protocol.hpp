@@ -11,12 +11,29 @@
 
 #include <scratch/scratch.hpp>
 
+// Forward declarations.
+namespace Scratch {
+namespace Utility {
+class Data;
+}; // namespace Utility
+}; // namespace Scratch
+
 namespace Scratch {
 namespace Net {
 
 // Forward declarations.
 class Descriptor;
 
+// ScratchMUD types.
+using DataPtr = std::shared_ptr<Scratch::Utility::Data>;
+
+//! The protocol types. \{
+enum ProtocolType: unsigned {
+    PROTOCOL_TELNET = 0,	//!< TELNET (RFC 854).
+    PROTOCOL_WEBSOCKET		//!< WebSocket (RFC 6455).
+};
+//! \}
+
 //! The protocol interface. \{
 class Protocol {
 public:
@@ -25,6 +42,13 @@ public:
 	// Nothing.
     }
 
+    //! Restores protocol state after a hot reboot.
+    //! \param data the handoff record
+    //! \sa #SaveHandoff(const DataPtr&) const
+    virtual void LoadHandoff(const DataPtr& data) {
+	// Nothing.
+    }
+
     //! Called after an application prompt is written.
     virtual void OnPrompt() {
 	// Nothing.
@@ -39,10 +63,36 @@ public:
     //! \param byteReceived the byte to process
     virtual void Receive(const std::uint8_t byteReceived) = 0;
 
+    //! Processes a run of wire input.
+    //! \param bytesReceived the bytes to process
+    //! \param nBytes the number of bytes to process
+    //! \remark Falls back to #Receive(const std::uint8_t) per byte.
+    virtual void ReceiveBytes(
+	const std::uint8_t* bytesReceived,
+	const std::size_t nBytes) {
+	for (std::size_t n = 0; n < nBytes; ++n)
+	    this->Receive(bytesReceived[n]);
+    }
+
+    //! Records protocol state for a hot reboot.
+    //! \param data the handoff record
+    //! \sa #LoadHandoff(const DataPtr&)
+    virtual void SaveHandoff(const DataPtr& data) const {
+	// Nothing.
+    }
+
     //! Sends application output toward the wire.
     //! \param message the message to send
     virtual void Send(const String& message) = 0;
 
+    //! Sends a GMCP message out of band.
+    //! \param package the GMCP package and message name
+    //! \param json the JSON payload, or empty
+    //! \return \c true if the client accepted GMCP
+    virtual bool SendGmcp(const String& package, const String& json) {
+	return false;
+    }
+
     //! Enables or disables Quiet (server echo / hidden client local echo).
     //! \param quiet whether Quiet is enabled
     virtual void SetQuiet(bool quiet) {
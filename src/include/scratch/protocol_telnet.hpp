@@ -10,10 +10,14 @@
 #define _SCRATCH_PROTOCOL_TELNET_HPP_
 
 #include <scratch/protocol.hpp>
+#include <scratch/timer_wheel.hpp>
 
 namespace Scratch {
 namespace Net {
 
+// ScratchMUD types.
+using Timer = Scratch::Utility::TimerWheel::Timer;
+
 //! Per-option RFC 1143 state. \{
 struct TelnetOptionState {
     //! The RFC 1143 Q-method side state. \{
@@ -49,6 +53,11 @@ public:
     //! Destructor.
     virtual ~TelnetProtocol() noexcept;
 
+    //! Restores negotiated options after a hot reboot.
+    //! \param data the handoff record
+    //! \sa #SaveHandoff(const DataPtr&) const
+    virtual void LoadHandoff(const DataPtr& data) override;
+
     //! Called after an application prompt is written.
     virtual void OnPrompt() override;
 
@@ -59,10 +68,30 @@ public:
     //! \param byteReceived the byte to process
     virtual void Receive(const std::uint8_t byteReceived) override;
 
+    //! Processes a run of wire input.
+    //! \param bytesReceived the bytes to process
+    //! \param nBytes the number of bytes to process
+    //! \remark Delivers runs of application data without TELNET state.
+    virtual void ReceiveBytes(
+	const std::uint8_t* bytesReceived,
+	const std::size_t nBytes) override;
+
+    //! Records negotiated options for a hot reboot.
+    //! \param data the handoff record
+    //! \remark Options still negotiating are recorded as refused.
+    //! \sa #LoadHandoff(const DataPtr&)
+    virtual void SaveHandoff(const DataPtr& data) const override;
+
     //! Sends application output toward the wire.
     //! \param message the message to send
     virtual void Send(const String& message) override;
 
+    //! Sends a GMCP message out of band.
+    //! \param package the GMCP package and message name
+    //! \param json the JSON payload, or empty
+    //! \return \c true if the client accepted GMCP
+    virtual bool SendGmcp(const String& package, const String& json) override;
+
     //! Enables or disables Quiet (server echo / hidden client local echo).
     //! \param quiet whether Quiet is enabled
     virtual void SetQuiet(bool quiet) override;
@@ -71,6 +100,14 @@ protected:
     //! The descriptor.
     Descriptor& descriptor_;
 
+    //! The acknowledged LINEMODE mode mask (RFC 1184).
+    //! \remark Zero until the client acknowledges \c MODE.
+    std::uint8_t linemodeMask_;
+
+    //! The option negotiation timer.
+    //! \sa #InitNegotiationTimer()
+    Timer negotiationTimer_;
+
     //! RFC 1143 state for each TELNET option.
     TelnetOptionState optionState_[256];
 
@@ -92,6 +129,17 @@ protected:
     //! Clears TELNET-SB collection state.
     void ClearTelnetSb();
 
+    //! Settles options still negotiating once the timer expires.
+    //! \remark Pending requests are treated as refused (\c Q_NO).
+    //! \sa #InitNegotiationTimer()
+    void ExpireNegotiation();
+
+    //! Arms the option negotiation timer.
+    //! \remark Called after a request is sent. Requests already
+    //!     outstanding keep their deadline; later ones share it.
+    //! \sa #ExpireNegotiation()
+    void InitNegotiationTimer();
+
     //! Returns whether we support enabling an option on his side.
     //! \param option the TELNET option
     bool SupportsHim(const std::uint8_t option) const noexcept;
@@ -169,6 +217,21 @@ protected:
     //! \param sbByteReceived the TELNET-SB byte to process
     void ReceiveTelnetSbByte(const std::uint8_t sbByteReceived);
 
+    //! Processes a LINEMODE subnegotiation.
+    //! \param sbReceived the TELNET-SB payload
+    void ReceiveLinemode(const String& sbReceived);
+
+    //! Sends a LINEMODE \c MODE subnegotiation.
+    //! \param mask the mode mask to send
+    void SendLinemodeMode(const std::uint8_t mask);
+
+    //! Sends a LINEMODE option subnegotiation (RFC 1184 section 2.2).
+    //! \param command the negotiation command
+    //! \param option the LINEMODE suboption
+    void SendLinemodeNegotiate(
+	const std::uint8_t command,
+	const std::uint8_t option);
+
     //! Processes a NAWS subnegotiation.
     //! \param sbReceived the TELNET-SB payload
     void ReceiveNaws(const String& sbReceived);
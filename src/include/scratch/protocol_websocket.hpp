@@ -0,0 +1,198 @@
+//! \file protocol_websocket.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_PROTOCOL_WEBSOCKET_HPP_
+#define _SCRATCH_PROTOCOL_WEBSOCKET_HPP_
+
+#include <scratch/protocol.hpp>
+
+namespace Scratch {
+namespace Net {
+
+//! The WebSocket protocol. \{
+//! \remark Serves browser clients directly (RFC 6455). The HTTP upgrade
+//!     is answered before any frame is read; output written earlier is
+//!     held until then. Each text or binary message is one input line
+//!     and each #Send is one text message. permessage-deflate (RFC 7692)
+//!     is negotiated when zlib is available, always with
+//!     \c client_no_context_takeover and \c server_no_context_takeover
+//!     so neither direction's deflate state outlives a message.
+class WebSocketProtocol: public Protocol {
+public:
+    //! Constructor.
+    //! \param descriptor the descriptor
+    explicit WebSocketProtocol(Descriptor& descriptor) noexcept;
+
+    //! Destructor.
+    virtual ~WebSocketProtocol() noexcept;
+
+    //! Restores the open connection after a hot reboot.
+    //! \param data the handoff record
+    //! \sa #SaveHandoff(const DataPtr&) const
+    virtual void LoadHandoff(const DataPtr& data) override;
+
+    //! Processes one byte of wire input.
+    //! \param byteReceived the byte to process
+    virtual void Receive(const std::uint8_t byteReceived) override;
+
+    //! Processes a run of wire input.
+    //! \param bytesReceived the bytes to process
+    //! \param nBytes the number of bytes to process
+    virtual void ReceiveBytes(
+	const std::uint8_t* bytesReceived,
+	const std::size_t nBytes) override;
+
+    //! Records the open connection for a hot reboot.
+    //! \param data the handoff record
+    //! \remark Deflate keeps no history between messages, so only the
+    //!     negotiated parameters are recorded.
+    //! \sa #LoadHandoff(const DataPtr&)
+    virtual void SaveHandoff(const DataPtr& data) const override;
+
+    //! Sends application output as one text message.
+    //! \param message the message to send
+    virtual void Send(const String& message) override;
+
+protected:
+    //! The WebSocket opcodes. \{
+    enum Opcode: std::uint8_t {
+	OP_CONTINUATION	= 0x0,	//!< Continues a fragmented message.
+	OP_TEXT		= 0x1,	//!< UTF-8 data message.
+	OP_BINARY	= 0x2,	//!< Binary data message.
+	OP_CLOSE	= 0x8,	//!< Close handshake.
+	OP_PING		= 0x9,	//!< Ping.
+	OP_PONG		= 0xA	//!< Pong.
+    };
+    //! \}
+
+    //! The WebSocket close status codes. \{
+    enum CloseStatus: std::uint16_t {
+	CLOSE_NORMAL		= 1000,	//!< Normal closure.
+	CLOSE_PROTOCOL_ERROR	= 1002,	//!< Protocol violation.
+	CLOSE_INVALID_DATA	= 1007,	//!< Undecodable message data.
+	CLOSE_TOO_BIG		= 1009	//!< Message exceeds MaxString.
+    };
+    //! \}
+
+    //! The descriptor.
+    Descriptor& descriptor_;
+
+    //! Whether permessage-deflate was negotiated.
+    bool deflateBit_;
+
+    //! The deflate window size, in bits.
+    int deflateWindowBits_;
+
+#ifdef HAVE_LIBZ
+    //! The outbound deflate stream.
+    z_stream deflater_;
+
+    //! Whether #deflater_ is initialized.
+    bool deflaterBit_;
+
+    //! The inbound inflate stream.
+    z_stream inflater_;
+
+    //! Whether #inflater_ is initialized.
+    bool inflaterBit_;
+#endif // HAVE_LIBZ
+
+    //! Unparsed frame input.
+    String frameInput_;
+
+    //! The HTTP upgrade request collected so far.
+    String handshake_;
+
+    //! The fragmented message collected so far.
+    String message_;
+
+    //! Whether the message in #message_ is compressed.
+    bool messageCompressedBit_;
+
+    //! Whether a fragmented message is in progress.
+    bool messageBit_;
+
+    //! Whether the upgrade completed.
+    bool openBit_;
+
+    //! Output written before the upgrade completed.
+    String pending_;
+
+    //! Answers a valid upgrade request and flushes held output.
+    //! \param request the HTTP request head
+    //! \return \c false if \p request is not a WebSocket upgrade
+    bool Accept(const String& request);
+
+    //! Sends a close frame and closes the descriptor.
+    //! \param status the close status code
+    //! \param reason the reason for the log
+    void Fail(
+	const CloseStatus status,
+	const String& reason);
+
+    //! Processes one complete frame.
+    //! \param header the first header byte
+    //! \param payload the unmasked payload
+    void ReceiveFrame(
+	const std::uint8_t header,
+	const String& payload);
+
+    //! Processes buffered frame input.
+    void ReceiveFrames();
+
+    //! Processes buffered upgrade input.
+    void ReceiveHandshake();
+
+    //! Processes one complete data message.
+    //! \param payload the message payload
+    //! \param compressed whether \p payload is deflated
+    void ReceiveMessage(
+	const String& payload,
+	const bool compressed);
+
+    //! Writes one unfragmented frame.
+    //! \param opcode the frame opcode
+    //! \param payload the frame payload
+    //! \param compressed whether to set RSV1 for a deflated payload
+    void SendFrame(
+	const Opcode opcode,
+	const String& payload,
+	const bool compressed = false);
+
+    //! Parses a permessage-deflate offer.
+    //! \param offers the Sec-WebSocket-Extensions value
+    //! \return the extension response, or empty to decline
+    String NegotiateDeflate(const String& offers);
+
+    //! Creates the zlib streams for a negotiated deflate.
+    //! \return \c false if zlib could not be initialized
+    bool InitDeflate();
+
+    //! Compresses one outbound message.
+    //! \param message the message
+    //! \param compressed the deflated message, sans trailing flush block
+    //! \return \c false on a zlib error
+    bool Deflate(
+	const String& message,
+	String& compressed);
+
+    //! Decompresses one inbound message.
+    //! \param compressed the deflated message
+    //! \param message the inflated message
+    //! \return \c false on a zlib error or if \p message would exceed
+    //!     MaxString
+    bool Inflate(
+	const String& compressed,
+	String& message);
+};
+//! \}
+
+}; // namespace Net
+}; // namespace Scratch
+
+#endif // _SCRATCH_PROTOCOL_WEBSOCKET_HPP_
@@ -0,0 +1,169 @@
+//! \file pulse.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_PULSE_HPP_
+#define _SCRATCH_PULSE_HPP_
+
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Utility {
+
+// Boost types.
+using ErrorCode = boost::system::error_code;
+using IoContext = boost::asio::io_context;
+using SteadyTimer = boost::asio::steady_timer;
+
+//! The pulse class. \{
+//! \remark Fixed-rate heartbeat driven by one \c steady_timer. Deadlines
+//!     advance by whole periods from the start time, so a slow pulse
+//!     does not push later ones back. A pulse that overruns is followed
+//!     by up to #MaxCatchUp missed pulses back to back; any beyond that
+//!     are dropped and counted.
+class Pulse {
+public:
+    //! The pulse handler type; receives the pulse number.
+    using Handler = std::function<void(const std::uint64_t)>;
+
+    //! The most missed pulses run back to back after an overrun.
+    static const unsigned MaxCatchUp = 4;
+
+    //! Constructor.
+    //! \param ioContext the IO context
+    explicit Pulse(IoContext& ioContext);
+
+    //! Copy constructor.
+    Pulse(const Pulse&) = delete;
+
+    //! Destructor.
+    ~Pulse() noexcept;
+
+    //! Copy assignment operator.
+    Pulse& operator=(const Pulse&) = delete;
+
+    //! Gets the number of pulses run.
+    std::uint64_t GetCount() const noexcept {
+	return count_;
+    }
+
+    //! Gets the number of pulses dropped after overruns.
+    std::uint64_t GetDropped() const noexcept {
+	return dropped_;
+    }
+
+    //! Gets how late the most recent pulse started.
+    //! \sa #GetMaxLag() const
+    std::chrono::microseconds GetLag() const noexcept {
+	return lag_;
+    }
+
+    //! Gets how late the latest-starting pulse started.
+    //! \sa #GetLag() const
+    std::chrono::microseconds GetMaxLag() const noexcept {
+	return maxLag_;
+    }
+
+    //! Gets the pulse period.
+    //! \sa #Start(const std::chrono::milliseconds)
+    std::chrono::milliseconds GetPeriod() const noexcept {
+	return period_;
+    }
+
+    //! Returns whether the pulse is running.
+    //! \sa #Start(const std::chrono::milliseconds)
+    //! \sa #Stop()
+    bool IsRunning() const noexcept {
+	return running_;
+    }
+
+    //! Registers a handler.
+    //! \param every the pulse interval, at least one
+    //! \param handler the handler, run once every \p every pulses
+    //! \return the registration, for #Unregister(const std::size_t)
+    std::size_t Register(
+	const unsigned every,
+	Handler handler);
+
+    //! Starts pulsing.
+    //! \param period the pulse period, at least one millisecond
+    //! \sa #Stop()
+    void Start(const std::chrono::milliseconds period);
+
+    //! Stops pulsing; handlers stay registered.
+    //! \sa #Start(const std::chrono::milliseconds)
+    void Stop() noexcept;
+
+    //! Unregisters a handler.
+    //! \param id the registration
+    //! \remark Safe to call from a running handler.
+    //! \sa #Register(const unsigned, Handler)
+    void Unregister(const std::size_t id) noexcept;
+
+protected:
+    //! One registered handler. \{
+    struct Entry {
+	//! The registration.
+	std::size_t id;
+
+	//! The pulse interval.
+	unsigned every;
+
+	//! The handler, or empty once unregistered.
+	Handler handler;
+    };
+    //! \}
+
+    //! The number of pulses run.
+    std::uint64_t count_;
+
+    //! The deadline of the next pulse.
+    std::chrono::steady_clock::time_point deadline_;
+
+    //! Whether handlers are running.
+    bool dispatching_;
+
+    //! The number of pulses dropped after overruns.
+    std::uint64_t dropped_;
+
+    //! The registered handlers, in registration order.
+    std::list<Entry> entries_;
+
+    //! How late the most recent pulse started.
+    std::chrono::microseconds lag_;
+
+    //! How late the latest-starting pulse started.
+    std::chrono::microseconds maxLag_;
+
+    //! The next registration.
+    std::size_t nextId_;
+
+    //! The pulse period.
+    std::chrono::milliseconds period_;
+
+    //! Whether the pulse is running.
+    bool running_;
+
+    //! The steady timer.
+    SteadyTimer steadyTimer_;
+
+    //! Runs one pulse.
+    //! \remark A handler that throws is logged; the others still run.
+    void Dispatch();
+
+    //! Begins waiting for the next deadline.
+    void InitAsyncWait();
+
+    //! Runs the pulses now due.
+    void Wake();
+};
+//! \}
+
+}; // namespace Utility
+}; // namespace Scratch
+
+#endif // _SCRATCH_PULSE_HPP_
@@ -0,0 +1,286 @@
+//! \file relay.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_RELAY_HPP_
+#define _SCRATCH_RELAY_HPP_
+
+#include <scratch/gateway_frame.hpp>
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Net {
+
+// Forward declarations.
+class RelaySession;
+
+// Boost types.
+using Acceptor = boost::asio::ip::tcp::acceptor;
+using Endpoint = boost::asio::ip::tcp::endpoint;
+using ErrorCode = boost::system::error_code;
+using IoContext = boost::asio::io_context;
+using LocalSocket = boost::asio::local::stream_protocol::socket;
+using Socket = boost::asio::ip::tcp::socket;
+using SteadyTimer = boost::asio::steady_timer;
+
+// ScratchMUD types.
+using RelaySessionPtr = std::shared_ptr<RelaySession>;
+
+//! The gateway relay. \{
+//! \remark Runs in \c scratch-gateway. Owns the TELNET listener and
+//!     multiplexes every client over one Unix socket to the game. When
+//!     the game goes away, clients stay connected and their sessions are
+//!     reopened once it is back.
+class Relay: public std::enable_shared_from_this<Relay> {
+public:
+    //! Constructor.
+    //! \param ioContext the I/O context
+    //! \param channelPath the game's Unix socket path
+    Relay(
+	IoContext& ioContext,
+	const String& channelPath) noexcept;
+
+    //! Destructor.
+    ~Relay() noexcept;
+
+    //! Drops a session from the session table.
+    //! \param session the session ID
+    void EraseSession(const std::uint32_t session) noexcept;
+
+    //! Gets the I/O context.
+    IoContext& GetIoContext() noexcept {
+	return ioContext_;
+    }
+
+    //! Queues frames for the game; dropped while disconnected.
+    //! \param type the frame type
+    //! \param session the session ID
+    //! \param data the payload
+    //! \param nBytes the size of \p data
+    void Send(
+	const GatewayFrameType type,
+	const std::uint32_t session,
+	const char* data = nullptr,
+	const std::size_t nBytes = 0);
+
+    //! Starts connecting to the game.
+    //! \sa #Stop()
+    void Start();
+
+    //! Starts the TELNET acceptor.
+    //! \param port the network port upon which to listen
+    //! \param address the network address to bind
+    void StartAcceptor(
+	const std::uint16_t port,
+	const String& address = String());
+
+    //! Closes the acceptor, the channel and every client.
+    //! \sa #Start()
+    void Stop();
+
+protected:
+    //! The TELNET acceptor.
+    Acceptor acceptor_;
+
+    //! The channel to the game.
+    LocalSocket channel_;
+
+    //! The game's Unix socket path.
+    String channelPath_;
+
+    //! Bumped whenever the channel closes, so completions queued for an
+    //! old channel are dropped.
+    unsigned channelSerial_;
+
+    //! Whether the channel is connected.
+    bool connected_;
+
+    //! Bytes read from the channel.
+    char input_[8192];
+
+    //! The I/O context.
+    //! \sa #GetIoContext()
+    IoContext& ioContext_;
+
+    //! The last session ID handed out.
+    std::uint32_t lastSession_;
+
+    //! Frames queued behind the write in flight.
+    String output_;
+
+    //! The channel frame decoder.
+    GatewayFrameReader reader_;
+
+    //! Paces reconnection attempts.
+    SteadyTimer reconnectTimer_;
+
+    //! Open sessions by ID.
+    std::map<std::uint32_t, RelaySessionPtr> sessions_;
+
+    //! Whether #Stop() was called.
+    bool stopped_;
+
+    //! Whether a channel write is in flight.
+    bool writePending_;
+
+    //! Frames in flight.
+    String writing_;
+
+    //! Closes the channel and schedules a reconnect.
+    void CloseChannel();
+
+    //! Connects to the game.
+    void Connect();
+
+    //! Configures an asynchronous accept.
+    void InitAsyncAccept();
+
+    //! Configures an asynchronous channel read.
+    void InitAsyncRead();
+
+    //! Configures an asynchronous channel write.
+    void InitAsyncWrite();
+
+    //! Schedules the next connection attempt.
+    void InitReconnect();
+
+    //! Dispatches one frame from the game.
+    //! \param frame the frame
+    void OnFrame(const GatewayFrame& frame);
+};
+//! \}
+
+//! One relayed TELNET client. \{
+//! \remark Negotiates MCCP2 (TELNET option 86) itself and compresses
+//!     everything the game sends once the client agrees; every other
+//!     TELNET option passes through to the game's TelnetProtocol.
+class RelaySession: public std::enable_shared_from_this<RelaySession> {
+public:
+    //! Constructor.
+    //! \param relay the relay
+    //! \param socket the client socket
+    //! \param session the session ID
+    RelaySession(
+	Relay& relay,
+	Socket&& socket,
+	const std::uint32_t session) noexcept;
+
+    //! Destructor.
+    ~RelaySession() noexcept;
+
+    //! Ends the session; the socket closes once pending output drains.
+    //! \param notify whether to tell the game
+    void Close(const bool notify = true);
+
+    //! Gets the remote address, as sent in \c GATEWAY_OPEN.
+    const String& GetAddress() const noexcept {
+	return address_;
+    }
+
+    //! Tells the client the game went away and releases any cork.
+    void OnChannelLost();
+
+    //! Sets or clears \c TCP_CORK.
+    //! \param cork whether to cork
+    void SetCork(const bool cork) noexcept;
+
+    //! Begins asynchronous I/O.
+    void Start();
+
+    //! Writes bytes from the game, compressed if MCCP2 is on.
+    //! \param data the bytes
+    //! \param nBytes the number of bytes
+    void Write(
+	const char* data,
+	const std::size_t nBytes);
+
+protected:
+    //! The inbound TELNET filter states. \{
+    enum TelnetState: unsigned {
+	TELNET_DATA = 0,	//!< Passing bytes through.
+	TELNET_IAC,		//!< After IAC.
+	TELNET_VERB		//!< After IAC DO or IAC DONT.
+    };
+    //! \}
+
+    //! The remote address.
+    //! \sa #GetAddress() const
+    String address_;
+
+    //! Whether #Close(const bool) was called.
+    bool closed_;
+
+    //! Whether output is being compressed.
+    bool compressing_;
+
+#ifdef HAVE_LIBZ
+    //! The MCCP2 stream.
+    z_stream deflater_;
+#endif // HAVE_LIBZ
+
+    //! Bytes read from the client.
+    char input_[4096];
+
+    //! Bytes queued behind the write in flight.
+    String output_;
+
+    //! The relay.
+    Relay& relay_;
+
+    //! The session ID.
+    std::uint32_t session_;
+
+    //! The client socket.
+    Socket socket_;
+
+    //! The inbound TELNET filter state.
+    TelnetState telnetState_;
+
+    //! The verb of the command being filtered.
+    std::uint8_t telnetVerb_;
+
+    //! Whether a write is in flight.
+    bool writePending_;
+
+    //! Bytes in flight.
+    String writing_;
+
+    //! Appends bytes to the output as they stand.
+    //! \param data the bytes
+    //! \param nBytes the number of bytes
+    void Append(
+	const char* data,
+	const std::size_t nBytes);
+
+    //! Closes the client socket.
+    void CloseSocket() noexcept;
+
+    //! Configures an asynchronous read.
+    void InitAsyncRead();
+
+    //! Configures an asynchronous write.
+    void InitAsyncWrite();
+
+    //! Filters MCCP2 negotiation out of client input and relays the rest.
+    //! \param bytes the bytes
+    //! \param nBytes the number of bytes
+    void Receive(
+	const std::uint8_t* bytes,
+	const std::size_t nBytes);
+
+    //! Starts MCCP2 after the client sends IAC DO COMPRESS2.
+    void StartCompress();
+
+    //! Ends the MCCP2 stream.
+    void StopCompress();
+};
+//! \}
+
+}; // namespace Net
+}; // namespace Scratch
+
+#endif // _SCRATCH_RELAY_HPP_
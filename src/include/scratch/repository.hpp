@@ -26,6 +26,8 @@ using Data = Scratch::Utility::Data;
 //! \remark The in-memory map is a write-through cache; #Store, #Erase, and
 //!	    #Clear update storage immediately. \c StorageT should expose
 //!	    \c ThingPtr and \c Map nested types analogous to this class.
+//!	    Every change to the map is reported to the listener, one thing
+//!	    at a time, so derived indexes can be patched in place.
 template<typename ThingT, typename StorageT>
 class Repository {
 public:
@@ -35,9 +37,23 @@ public:
     //! The type of the in-memory thing map.
     using Map = typename StorageT::Map;
 
+    //! The change kinds. \{
+    enum Change {
+	CHANGE_STORED,	//!< Added, or its contents replaced.
+	CHANGE_ERASED	//!< Removed.
+    };
+    //! \}
+
+    //! The change listener type; receives the change, the thing ID, and
+    //! the stored or erased thing.
+    //! \remark Runs inside \c noexcept members, so it must not throw.
+    using Listener = std::function<void(
+	const Change, const String&, const ThingPtr&)>;
+
     //! Constructor.
     //! \param storage the storage backend
     explicit Repository(StorageT storage) noexcept :
+	    listener_(),
 	    storage_(std::move(storage)),
 	    things_() {
 	// Nothing.
@@ -46,8 +62,11 @@ public:
     //! Clears the repository.
     //! \sa #SaveIndex() const
     void Clear() noexcept {
-	things_.clear();
+	Map erased;
+	erased.swap(things_);
 	storage_.WriteIndex(things_);
+	for (const auto& pair: erased)
+	    this->Notify(CHANGE_ERASED, pair.first, pair.second);
     }
 
     //! Removes a thing.
@@ -55,9 +74,13 @@ public:
     //! \return \c true if a thing was removed from memory
     //! \sa #Store(const String&, const ThingPtr&)
     bool Erase(const String& thingId) noexcept {
-	if (things_.erase(thingId) == 0)
+	auto found = things_.find(thingId);
+	if (found == std::end(things_))
 	    return false;
+	const auto thing = found->second;
+	things_.erase(found);
 	storage_.Erase(thingId, things_);
+	this->Notify(CHANGE_ERASED, thingId, thing);
 	return true;
     }
 
@@ -108,10 +131,12 @@ public:
 	if (found != std::end(things_) && found->second) {
 	    this->CopyContents(thing, found->second);
 	    storage_.SetThingId(*found->second, thingId);
+	    thing = found->second;
 	} else {
 	    storage_.SetThingId(*thing, thingId);
-	    things_[thingId] = std::move(thing);
+	    things_[thingId] = thing;
 	}
+	this->Notify(CHANGE_STORED, thingId, thing);
 	return true;
     }
 
@@ -124,19 +149,23 @@ public:
 	if (!storage_.ReadIndex(loaded))
 	    return false;
 
+	// Drop vanished things first, so keys they held are free to be
+	// claimed by things stored below.
+	for (const auto& id: this->GetIds()) {
+	    if (loaded.find(id) == std::end(loaded))
+		this->Forget(id);
+	}
 	for (const auto& pair: loaded) {
 	    auto found = things_.find(pair.first);
 	    if (found != std::end(things_) && found->second) {
 		this->CopyContents(pair.second, found->second);
 		storage_.SetThingId(*found->second, pair.first);
+		this->Notify(CHANGE_STORED, pair.first, found->second);
 	    } else {
 		things_[pair.first] = pair.second;
+		this->Notify(CHANGE_STORED, pair.first, pair.second);
 	    }
 	}
-	for (const auto& id: this->GetIds()) {
-	    if (loaded.find(id) == std::end(loaded))
-		things_.erase(id);
-	}
 	return true;
     }
 
@@ -162,6 +191,12 @@ public:
 	return storage_.WriteIndex(things_);
     }
 
+    //! Sets the change listener.
+    //! \param listener the listener, or empty to stop listening
+    void SetListener(Listener listener) noexcept {
+	listener_ = std::move(listener);
+    }
+
     //! Stores a thing.
     //! \param thingId the thing ID of the thing to store
     //! \param thing the thing to store
@@ -188,6 +223,7 @@ public:
 
 	    storage_.SetThingId(*canonical, thingId);
 	    storage_.Write(thingId, canonical, things_);
+	    this->Notify(CHANGE_STORED, thingId, canonical);
 	}
     }
 
@@ -203,6 +239,33 @@ protected:
 	into->ReadData(node);
     }
 
+    //! Drops a thing from memory only.
+    //! \param thingId the thing ID of the thing to drop
+    void Forget(const String& thingId) noexcept {
+	auto found = things_.find(thingId);
+	if (found == std::end(things_))
+	    return;
+	const auto thing = found->second;
+	things_.erase(found);
+	this->Notify(CHANGE_ERASED, thingId, thing);
+    }
+
+    //! Reports a change to the listener.
+    //! \param change the change
+    //! \param thingId the thing ID
+    //! \param thing the stored or erased thing
+    void Notify(
+	    const Change change,
+	    const String& thingId,
+	    const ThingPtr& thing) const noexcept {
+	if (listener_ && thing)
+	    listener_(change, thingId, thing);
+    }
+
+    //! The change listener.
+    //! \sa #SetListener(Listener)
+    Listener listener_;
+
     //! The storage backend.
     StorageT storage_;
 
@@ -39,6 +39,10 @@
 #include <boost/chrono.hpp>
 #endif // HAVE_BOOST_CHRONO_HPP
 
+#ifdef HAVE_BOOST_CONTAINER_SMALL_VECTOR_HPP
+#include <boost/container/small_vector.hpp>
+#endif // HAVE_BOOST_CONTAINER_SMALL_VECTOR_HPP
+
 #ifdef HAVE_BOOST_ENDIAN_CONVERSION_HPP
 #include <boost/endian/conversion.hpp>
 #endif // HAVE_BOOST_ENDIAN_CONVERSION_HPP
@@ -67,6 +71,18 @@
 #include <boost/system/error_code.hpp>
 #endif // HAVE_BOOST_SYSTEM_ERROR_CODE_HPP
 
+#ifdef HAVE_BOOST_UNORDERED_MAP_HPP
+#include <boost/unordered_map.hpp>
+#endif // HAVE_BOOST_UNORDERED_MAP_HPP
+
+#ifdef HAVE_BOOST_UNORDERED_SET_HPP
+#include <boost/unordered_set.hpp>
+#endif // HAVE_BOOST_UNORDERED_SET_HPP
+
+#ifdef HAVE_BOOST_UTILITY_STRING_VIEW_HPP
+#include <boost/utility/string_view.hpp>
+#endif // HAVE_BOOST_UTILITY_STRING_VIEW_HPP
+
 #ifdef HAVE_CCTYPE
 #include <cctype>
 #endif // HAVE_CCTYPE
@@ -75,10 +91,18 @@
 #include <cerrno>
 #endif // HAVE_CERRNO
 
+#ifdef HAVE_CHRONO
+#include <chrono>
+#endif // HAVE_CHRONO
+
 #ifdef HAVE_CMATH
 #include <cmath>
 #endif // HAVE_CMATH
 
+#ifdef HAVE_CONDITION_VARIABLE
+#include <condition_variable>
+#endif // HAVE_CONDITION_VARIABLE
+
 #ifdef HAVE_CRYPT_H
 extern "C" {
 #include <crypt.h>
@@ -109,10 +133,18 @@ extern "C" {
 #include <ctime>
 #endif // HAVE_CTIME
 
+#ifdef HAVE_DEQUE
+#include <deque>
+#endif // HAVE_DEQUE
+
 #ifdef HAVE_DLFCN_H
 #include <dlfcn.h>
 #endif // HAVE_DLFCN_H
 
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif // HAVE_FCNTL_H
+
 #ifdef HAVE_FSTREAM
 #include <fstream>
 #endif // HAVE_FSTREAM
@@ -121,6 +153,10 @@ extern "C" {
 #include <functional>
 #endif // HAVE_FUNCTIONAL
 
+#ifdef HAVE_IMMINTRIN_H
+#include <immintrin.h>
+#endif // HAVE_IMMINTRIN_H
+
 #ifdef HAVE_IOMANIP
 #include <iomanip>
 #endif // HAVE_IOMANIP
@@ -153,6 +189,14 @@ extern "C" {
 #include <memory>
 #endif // HAVE_MEMORY
 
+#ifdef HAVE_MUTEX
+#include <mutex>
+#endif // HAVE_MUTEX
+
+#ifdef HAVE_NETINET_TCP_H
+#include <netinet/tcp.h>
+#endif // HAVE_NETINET_TCP_H
+
 #ifdef HAVE_REGEX
 #include <regex>
 #endif // HAVE_REGEX
@@ -173,10 +217,18 @@ extern "C" {
 #include <string>
 #endif // HAVE_STRING
 
+#ifdef HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif // HAVE_SYS_SOCKET_H
+
 #ifdef HAVE_THREAD
 #include <thread>
 #endif // HAVE_THREAD
 
+#ifdef HAVE_TUPLE
+#include <tuple>
+#endif // HAVE_TUPLE
+
 #ifdef HAVE_TYPE_TRAITS
 #include <type_traits>
 #endif // HAVE_TYPE_TRAITS
@@ -185,6 +237,10 @@ extern "C" {
 #include <unistd.h>
 #endif // HAVE_UNISTD_H
 
+#ifdef HAVE_UNORDERED_MAP
+#include <unordered_map>
+#endif // HAVE_UNORDERED_MAP
+
 #ifdef HAVE_UTILITY
 #include <utility>
 #endif // HAVE_UTILITY
@@ -197,19 +253,44 @@ extern "C" {
 #include <windows.h>
 #endif // HAVE_WINDOWS_H
 
+#ifdef HAVE_ZLIB_H
+#include <zlib.h>
+#endif // HAVE_ZLIB_H
+
 namespace Scratch {
+//! Seconds a descriptor may go without input before closing.
+const std::time_t MaxIdle = 30 * 60;
+
 //! The maximum length of a user input buffer.
 const std::size_t MaxInput = 256;
 
+//! Seconds a descriptor may take to log in before closing.
+const std::time_t MaxLogin = 2 * 60;
+
+//! Seconds to wait for a TELNET option reply before assuming refusal.
+const std::time_t MaxNegotiation = 10;
+
 //! Maximum pending output bytes per descriptor (wire queue).
+//! \remark Soft cap; lower output classes are dropped beyond it.
 //! \remark Candidate for a future system-wide configuration parameter.
 const std::size_t MaxOutput = 16 * 1024;
 
+//! Hard cap on pending output bytes per descriptor (wire queue).
+//! \remark Prompts and direct replies are queued up to this cap.
+const std::size_t MaxOutputHard = 4 * MaxOutput;
+
+//! Seconds a descriptor may stay over \c MaxOutput before closing.
+const std::time_t MaxOutputStall = 30;
+
 //! The maximum length of a static buffer.
 const std::size_t MaxString = 8192;
 
 //! The ScratchMUD string type.
 using String = std::string;
+
+//! The ScratchMUD borrowed string type.
+//! \remark Valid only while the viewed string is alive and unmodified.
+using StringView = boost::string_view;
 }; // namespace Scratch
 
 #endif // _SCRATCH_SCRATCH_HPP_
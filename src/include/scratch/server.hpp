@@ -9,6 +9,8 @@
 #ifndef _SCRATCH_SERVER_HPP_
 #define _SCRATCH_SERVER_HPP_
 
+#include <scratch/admission.hpp>
+#include <scratch/protocol.hpp>
 #include <scratch/scratch.hpp>
 
 // Forward declarations.
@@ -16,18 +18,26 @@ namespace Scratch {
 namespace Core {
 class Game;
 }; // namespace Core
+namespace Utility {
+class Data;
+}; // namespace Utility
 }; // namespace Scratch
 
 namespace Scratch {
 namespace Net {
 
+// Forward declarations.
+class Gateway;
+
 // Boost types.
 using Acceptor = boost::asio::ip::tcp::acceptor;
 using Endpoint = boost::asio::ip::tcp::endpoint;
 using Socket = boost::asio::ip::tcp::socket;
 
 // ScratchMUD types.
+using DataPtr = std::shared_ptr<Scratch::Utility::Data>;
 using Game = Scratch::Core::Game;
+using GatewayPtr = std::shared_ptr<Gateway>;
 
 //! The server class. \{
 class Server {
@@ -39,35 +49,103 @@ public:
     //! Destructor.
     ~Server() noexcept;
 
-    //! Starts the acceptor and begins to accept connections.
+    //! Gets the connection admission control.
+    Admission& GetAdmission() noexcept {
+	return admission_;
+    }
+
+    //! Returns whether the listener for a protocol is open.
+    //! \param protocolType the wire protocol
+    bool IsListening(const ProtocolType protocolType) const noexcept;
+
+    //! Adopts handed-off listening sockets and begins to accept
+    //! connections.
+    //! \param data the handoff record
+    //! \return \c true if the TELNET listening socket was adopted
+    //! \sa #SaveHandoff(const DataPtr&)
+    bool ResumeAcceptor(const DataPtr& data);
+
+    //! Records the listening sockets for a hot reboot.
+    //! \param data the handoff record
+    //! \remark The WebSocket listener, if open, is nested under
+    //!     \c WebSocket.
+    //! \sa #ResumeAcceptor(const DataPtr&)
+    void SaveHandoff(const DataPtr& data);
+
+    //! Starts an acceptor and begins to accept connections.
     //! \param port the network port upon which to listen
     //! \param address the network address to bind
-    //! \sa #StartAcceptor(const Endpoint&)
+    //! \param protocolType the wire protocol for accepted connections
+    //! \sa #StartAcceptor(const Endpoint&, const ProtocolType)
     //! \sa #StopAcceptor()
     void StartAcceptor(
 	const std::uint16_t port,
-	const String& address = String());
+	const String& address = String(),
+	const ProtocolType protocolType = PROTOCOL_TELNET);
 
-    //! Starts the acceptor and begins to accept connections.
+    //! Starts an acceptor and begins to accept connections.
     //! \param endpoint the network endpoint
-    //! \sa #StartAcceptor(const std::uint16_t, const String&)
+    //! \param protocolType the wire protocol for accepted connections
+    //! \sa #StartAcceptor(const std::uint16_t, const String&, const ProtocolType)
+    //! \sa #StopAcceptor()
+    void StartAcceptor(
+	const Endpoint& endpoint,
+	const ProtocolType protocolType = PROTOCOL_TELNET);
+
+    //! Listens for \c scratch-gateway on a Unix socket.
+    //! \param path the Unix socket path
+    //! \remark Sessions the gateway opens are screened through
+    //!     \ref admission_ like accepted sockets.
     //! \sa #StopAcceptor()
-    void StartAcceptor(const Endpoint& endpoint);
+    void StartGateway(const String& path);
 
-    //! Stops the acceptor.
-    //! \sa #StartAcceptor(const std::uint16_t, const String&)
-    //! \sa #StartAcceptor(const Endpoint&)
+    //! Stops every acceptor and the gateway channel.
+    //! \sa #StartAcceptor(const std::uint16_t, const String&, const ProtocolType)
+    //! \sa #StartAcceptor(const Endpoint&, const ProtocolType)
+    //! \sa #StartGateway(const String&)
     void StopAcceptor();
 
 protected:
     //! The game state.
     Game& game_;
 
-    //! The acceptor.
+    //! The TELNET acceptor.
     Acceptor acceptor_;
 
+    //! The connection admission control.
+    //! \sa #GetAdmission()
+    Admission admission_;
+
+    //! The gateway channel multiplexer, if started.
+    //! \sa #StartGateway(const String&)
+    GatewayPtr gateway_;
+
+    //! The WebSocket acceptor.
+    Acceptor webSocketAcceptor_;
+
+    //! Adopts one handed-off listening socket.
+    //! \param acceptor the acceptor to assign
+    //! \param data the handoff record
+    //! \return \c true if the listening socket was adopted
+    bool AdoptAcceptor(
+	Acceptor& acceptor,
+	const DataPtr& data);
+
+    //! Returns the acceptor for a protocol.
+    //! \param protocolType the wire protocol
+    Acceptor& GetAcceptor(const ProtocolType protocolType) noexcept;
+
+    //! Returns whether any acceptor or the gateway channel is listening.
+    bool IsAnyListening() const noexcept;
+
+    //! Applies configured limits and loads the ban list.
+    void InitAdmission();
+
     //! Configures an asynchronous accept.
-    void InitAsyncAccept();
+    //! \param protocolType the wire protocol for accepted connections
+    //! \remark Screens each socket through \ref admission_ before
+    //!     \c Game::MakeDescriptor.
+    void InitAsyncAccept(const ProtocolType protocolType);
 };
 //! \}
 
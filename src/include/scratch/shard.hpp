@@ -0,0 +1,130 @@
+//! \file shard.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_SHARD_HPP_
+#define _SCRATCH_SHARD_HPP_
+
+#include <scratch/action.hpp>
+#include <scratch/color.hpp>
+#include <scratch/instance.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+
+// Forward declarations.
+namespace Scratch {
+namespace Scripting {
+class Lua;
+}; // namespace Scripting
+}; // namespace Scratch
+
+namespace Scratch {
+namespace Core {
+
+class Game;
+
+// ScratchMUD types.
+using Color = Scratch::Net::Color;
+
+//! The shard class. \{
+//! \remark One partition of the instances for a parallel pulse; an
+//!     instance stays on the same shard while it lives. Each shard
+//!     owns a worker Lua state with only the shard bindings, so its
+//!     instance pulse hooks can run on a pool thread. Hooks read game
+//!     state but never write it; their effects are recorded in a
+//!     command buffer that #Apply replays on the game thread once every
+//!     shard has finished.
+class Shard {
+public:
+    //! One deferred effect. \{
+    struct Deferred {
+	//! The instance the effect belongs to.
+	InstancePtr actor;
+
+	//! The action metacolor, or \c C_UNDEFINED for a command line.
+	Color::ColorEnum metacolor;
+
+	//! The action target bits.
+	unsigned targets;
+
+	//! The action message, or the command line.
+	String text;
+
+	//! The direct, indirect, and extra action slots.
+	ActionParam params[3];
+    };
+    //! \}
+
+    //! One instance pulse hook. \{
+    struct Hook {
+	//! The hook name, also its Caller identity.
+	String name;
+
+	//! The Lua source.
+	String source;
+    };
+    //! \}
+
+    //! Constructor.
+    //! \param game the game state
+    explicit Shard(Game& game);
+
+    //! Copy constructor.
+    Shard(const Shard&) = delete;
+
+    //! Destructor.
+    ~Shard() noexcept;
+
+    //! Copy assignment operator.
+    Shard& operator=(const Shard&) = delete;
+
+    //! Replays and clears the command buffer.
+    //! \remark Game thread only. Effects for instances erased since
+    //!     they were recorded are dropped.
+    void Apply();
+
+    //! Records an effect of the running hook.
+    //! \param deferred the effect
+    void Defer(Deferred deferred);
+
+    //! Gets the instance whose hooks are running, or \c nullptr.
+    const InstancePtr& GetInstance() const noexcept {
+	return instance_;
+    }
+
+    //! Runs instance pulse hooks on this shard's Lua state.
+    //! \param pulse the pulse number
+    //! \param hooks the hooks due on \p pulse
+    //! \param store the instance registry
+    //! \param positions the dense positions of this shard's instances
+    //! \remark Safe on a pool thread while the game thread waits.
+    //!     Names and players are read from the store columns.
+    void Run(
+	const std::uint64_t pulse,
+	const std::vector<Hook>& hooks,
+	const InstanceStore& store,
+	const std::vector<std::size_t>& positions);
+
+protected:
+    //! The command buffer.
+    std::vector<Deferred> buffer_;
+
+    //! The game state.
+    Game& game_;
+
+    //! The instance whose hooks are running.
+    InstancePtr instance_;
+
+    //! The worker Lua state.
+    std::unique_ptr<Scratch::Scripting::Lua> lua_;
+};
+//! \}
+
+}; // namespace Core
+}; // namespace Scratch
+
+#endif // _SCRATCH_SHARD_HPP_
@@ -0,0 +1,53 @@
+//! \file shard_bindings.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_SHARD_BINDINGS_HPP_
+#define _SCRATCH_SHARD_BINDINGS_HPP_
+
+#include <scratch/lua.hpp>
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Core {
+class Shard;
+}; // namespace Core
+
+namespace Scripting {
+
+// ScratchMUD types.
+using Shard = Scratch::Core::Shard;
+
+//! The shard bindings class. \{
+//! \remark The only bindings on a shard's worker Lua state. Nothing
+//!     here writes game state: \c action and \c dispatch_command are
+//!     recorded for the running instance and replayed on the game
+//!     thread after the pulse.
+class ShardBindings {
+public:
+    //! Attaches \p shard to its worker Lua state.
+    //! \param lua the Lua facade
+    //! \param shard the shard that owns \p lua
+    static void Bind(
+	Lua& lua,
+	Shard& shard);
+
+    //! Resolves the shard that owns a worker Lua state.
+    //! \param L the \c lua_State
+    //! \return the shard
+    static Shard& Check(lua_State* L);
+
+    //! Registers shard free functions on \p lua.
+    //! \param lua the Lua facade
+    static void Register(Lua& lua);
+};
+//! \}
+
+}; // namespace Scripting
+}; // namespace Scratch
+
+#endif // _SCRATCH_SHARD_BINDINGS_HPP_
@@ -0,0 +1,51 @@
+//! \file slot_map.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_SLOT_MAP_HPP_
+#define _SCRATCH_SLOT_MAP_HPP_
+
+#include <scratch/component_store.hpp>
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Utility {
+
+//! The slot map class. \{
+//! \remark Generational slot map: a single-column #ComponentStore whose
+//!     values are stored densely for contiguous iteration.
+template <typename T>
+class SlotMap: public ComponentStore<T> {
+public:
+    using ComponentStore<T>::Find;
+
+    //! Finds the value for \p handle.
+    //! \param handle the handle
+    //! \return the value, or \c nullptr if \p handle is stale or invalid
+    T* Find(const SlotHandle handle) noexcept {
+	return this->template Find<T>(handle);
+    }
+
+    //! Finds the value for \p handle.
+    //! \param handle the handle
+    //! \return the value, or \c nullptr if \p handle is stale or invalid
+    const T* Find(const SlotHandle handle) const noexcept {
+	return this->template Find<T>(handle);
+    }
+
+    //! Gets the values, densely packed and in no particular order.
+    //! \remark Invalidated by #Insert and #Erase.
+    const std::vector<T>& GetValues() const noexcept {
+	return this->template GetColumn<T>();
+    }
+};
+//! \}
+
+}; // namespace Utility
+}; // namespace Scratch
+
+#endif // _SCRATCH_SLOT_MAP_HPP_
@@ -62,6 +62,22 @@ int StringCompareCi(
 	const String& left,
 	const String& right);
 
+//! Compares character ranges.
+//! \param left the first range to compare
+//! \param leftSize the length of \p left
+//! \param right the second range to compare
+//! \param rightSize the length of \p right
+//! \return < 0 if \a left is less than \a right;
+//!         > 0 if \a left is greater than \a right;
+//!           0 if the specified ranges are equal
+//! \remark Only ASCII letters are folded, sixteen or thirty-two bytes at
+//!     a time where the target supports SSE2 or AVX2.
+int StringCompareCi(
+	const char* left,
+	const std::size_t leftSize,
+	const char* right,
+	const std::size_t rightSize) noexcept;
+
 //! Returns whether \p str ends with \p suffix.
 //! \param str the string to test
 //! \param suffix the suffix
@@ -78,6 +94,21 @@ bool StringEndsWithCi(
 	const String& str,
 	const String& suffix);
 
+//! Case-insensitive equality. \{
+struct StringEqualToCi {
+    //! Enables lookup by any type convertible to #StringView.
+    using is_transparent = void;
+
+    bool operator()(
+	const StringView& left,
+	const StringView& right) const noexcept {
+	return left.size() == right.size() &&
+	    StringCompareCi(left.data(), left.size(),
+		right.data(), right.size()) == 0;
+    }
+};
+//! \}
+
 //! Hashes a plaintext string.
 //! \param plaintext the string to hash
 //! \param salt the crypt salt; empty generates a new salt
@@ -116,6 +147,16 @@ String StringGenerateCopy(Random& random);
 //! \sa StringGenerateCopy(Random&)
 String StringGenerateCopy();
 
+//! Case-insensitive hash. \{
+//! \remark Keys that compare equal under #StringEqualToCi hash equal.
+struct StringHashCi {
+    //! Enables lookup by any type convertible to #StringView.
+    using is_transparent = void;
+
+    std::size_t operator()(const StringView& str) const noexcept;
+};
+//! \}
+
 //! Joins strings with a separator.
 //! \param sep the separator inserted between elements
 //! \param parts the strings to join
@@ -127,10 +168,14 @@ String StringJoin(
 
 //! Case-insensitive weak order. \{
 struct StringLessCi {
+    //! Enables lookup by any type convertible to #StringView.
+    using is_transparent = void;
+
     bool operator()(
-	const String& left,
-	const String& right) const noexcept {
-	return StringCompareCi(left, right) < 0;
+	const StringView& left,
+	const StringView& right) const noexcept {
+	return StringCompareCi(left.data(), left.size(),
+	    right.data(), right.size()) < 0;
     }
 };
 //! \}
@@ -202,12 +247,31 @@ using StringMap = std::map<String, ValueT>;
 template<class ValueT>
 using StringMapCi = std::map<String, ValueT, Scratch::Algorithm::StringLessCi>;
 
+//! A \ref std::multimap specialized for case-insensitive string keys.
+//! \tparam ValueT the C++ type of map values
+template<class ValueT>
+using StringMultimapCi = std::multimap<String, ValueT,
+	Scratch::Algorithm::StringLessCi>;
+
 //! A \ref std::set specialized for strings.
 using StringSet = std::set<String>;
 
 //! A \ref std::set specialized for case-insensitive strings.
 using StringSetCi = std::set<String, Scratch::Algorithm::StringLessCi>;
 
+//! A \ref boost::unordered_map specialized for case-insensitive string keys.
+//! \tparam ValueT the C++ type of map values
+//! \remark Unordered; use #StringMapCi where iteration order matters.
+//!     Look up by #StringView with the three-argument \c find.
+template<class ValueT>
+using StringUnorderedMapCi = boost::unordered_map<String, ValueT,
+	Scratch::Algorithm::StringHashCi, Scratch::Algorithm::StringEqualToCi>;
+
+//! A \ref boost::unordered_set specialized for case-insensitive strings.
+//! \remark Unordered; use #StringSetCi where iteration order matters.
+using StringUnorderedSetCi = boost::unordered_set<String,
+	Scratch::Algorithm::StringHashCi, Scratch::Algorithm::StringEqualToCi>;
+
 }; // namespace Scratch
 
 #endif // _SCRATCH_STRING_HXX_
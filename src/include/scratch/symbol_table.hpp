@@ -0,0 +1,92 @@
+//! \file symbol_table.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_SYMBOL_TABLE_HPP_
+#define _SCRATCH_SYMBOL_TABLE_HPP_
+
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+
+namespace Scratch {
+namespace Core {
+
+//! The symbol table class. \{
+//! \remark Interns case-insensitive names, such as permissions and
+//!     preferences, to small integers so a set of them can be held as a
+//!     fixed-width bitset and tested with one AND. Symbols are never
+//!     released; names past #MaxSymbols are not interned and callers
+//!     keep their string sets for those.
+class SymbolTable {
+public:
+    //! The number of symbols a table can hold.
+    static const std::size_t MaxSymbols = 128;
+
+    //! The symbol returned for a name that is not interned.
+    static const unsigned NoSymbol = ~0u;
+
+    //! The type of a symbol bitset.
+    using Bits = std::bitset<MaxSymbols>;
+
+    //! Default constructor.
+    SymbolTable() noexcept;
+
+    //! Copy constructor.
+    SymbolTable(const SymbolTable&) = delete;
+
+    //! Destructor.
+    ~SymbolTable() noexcept;
+
+    //! Copy assignment operator.
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    //! Interns \p name.
+    //! \param name the name
+    //! \return the symbol, or #NoSymbol if the table is full
+    unsigned Intern(const String& name);
+
+    //! Looks up \p name without interning it.
+    //! \param name the name
+    //! \return the symbol, or #NoSymbol
+    unsigned Lookup(const String& name) const noexcept;
+
+    //! Interns every name in \p names.
+    //! \param names the names
+    //! \param bits receives the symbols
+    //! \return \c false if a name could not be interned
+    bool MakeBits(
+	const StringSetCi& names,
+	Bits& bits);
+
+    //! Gets the permission table.
+    static SymbolTable& Permissions() noexcept;
+
+    //! Gets the preference table.
+    static SymbolTable& Preferences() noexcept;
+
+    //! Returns whether \p symbol is set in \p bits.
+    //! \param bits the symbol bitset
+    //! \param symbol the symbol
+    static bool Test(
+	const Bits& bits,
+	const unsigned symbol) noexcept {
+	return symbol < MaxSymbols && bits.test(symbol);
+    }
+
+protected:
+    //! The symbols by name.
+    StringUnorderedMapCi<unsigned> symbols_;
+};
+//! \}
+
+//! The type of a symbol bitset.
+using SymbolBits = SymbolTable::Bits;
+
+}; // namespace Core
+}; // namespace Scratch
+
+#endif // _SCRATCH_SYMBOL_TABLE_HPP_
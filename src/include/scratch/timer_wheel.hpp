@@ -0,0 +1,171 @@
+//! \file timer_wheel.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_TIMER_WHEEL_HPP_
+#define _SCRATCH_TIMER_WHEEL_HPP_
+
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Utility {
+
+// Boost types.
+using ErrorCode = boost::system::error_code;
+using IoContext = boost::asio::io_context;
+using SteadyTimer = boost::asio::steady_timer;
+
+//! The timer wheel class. \{
+//! \remark Hierarchical timing wheel (Varghese and Lauck) driven by one
+//!     \c steady_timer. Arm and cancel are O(1); the steady timer only
+//!     runs while at least one timer is armed.
+class TimerWheel {
+public:
+    //! The timer handler type.
+    using Handler = std::function<void()>;
+
+    //! The timer class. \{
+    //! \remark Intrusive wheel node. Owned by the caller; cancelled on
+    //!     destruction.
+    class Timer {
+    public:
+	//! Default constructor.
+	Timer() noexcept;
+
+	//! Copy constructor.
+	Timer(const Timer&) = delete;
+
+	//! Destructor.
+	~Timer() noexcept;
+
+	//! Copy assignment operator.
+	Timer& operator=(const Timer&) = delete;
+
+	//! Cancels the timer if armed.
+	//! \sa #IsArmed() const
+	void Cancel() noexcept;
+
+	//! Returns whether the timer is armed.
+	//! \sa #Cancel()
+	bool IsArmed() const noexcept {
+	    return wheel_ != nullptr;
+	}
+
+    private:
+	//! The expiry tick.
+	std::uint64_t expiry_;
+
+	//! The expiry handler.
+	Handler handler_;
+
+	//! The next timer in the slot.
+	Timer* next_;
+
+	//! The link that points at this timer.
+	Timer** prev_;
+
+	//! The owning wheel, or \c nullptr when disarmed.
+	TimerWheel* wheel_;
+
+	friend class TimerWheel;
+    };
+    //! \}
+
+    //! The tick duration.
+    static const std::chrono::milliseconds Tick;
+
+    //! Constructor.
+    //! \param ioContext the IO context
+    explicit TimerWheel(IoContext& ioContext);
+
+    //! Copy constructor.
+    TimerWheel(const TimerWheel&) = delete;
+
+    //! Destructor.
+    //! \remark Disarms every timer still in the wheel.
+    ~TimerWheel() noexcept;
+
+    //! Copy assignment operator.
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    //! Arms a timer, re-arming it if already armed.
+    //! \param timer the timer to arm
+    //! \param delay the delay before \p handler runs
+    //! \param handler the expiry handler
+    //! \remark Delays round up to whole ticks and clamp to the wheel span.
+    //! \sa #Cancel(Timer&)
+    void Arm(
+	Timer& timer,
+	const std::chrono::milliseconds delay,
+	Handler handler) noexcept;
+
+    //! Cancels a timer.
+    //! \param timer the timer to cancel
+    //! \sa #Arm(Timer&, const std::chrono::milliseconds, Handler)
+    void Cancel(Timer& timer) noexcept;
+
+    //! Cancels every timer and stops the steady timer.
+    void Clear() noexcept;
+
+    //! Returns the number of armed timers.
+    std::size_t Size() const noexcept {
+	return size_;
+    }
+
+protected:
+    //! Bits of slot index per level.
+    static const unsigned SlotBits = 6;
+
+    //! Slots per level.
+    static const unsigned Slots = 1u << SlotBits;
+
+    //! Number of levels.
+    static const unsigned Levels = 4;
+
+    //! The next tick to process.
+    std::uint64_t current_;
+
+    //! The time point of tick zero.
+    std::chrono::steady_clock::time_point origin_;
+
+    //! The number of armed timers.
+    std::size_t size_;
+
+    //! The slot lists, indexed by level and slot.
+    Timer* slots_[Levels][Slots];
+
+    //! The steady timer.
+    SteadyTimer steadyTimer_;
+
+    //! Whether the steady timer is waiting.
+    bool ticking_;
+
+    //! Advances the wheel to the present, running expired timers.
+    void Advance() noexcept;
+
+    //! Re-inserts the timers of a higher-level slot.
+    //! \param level the level to cascade
+    //! \return the cascaded slot index
+    unsigned Cascade(const unsigned level) noexcept;
+
+    //! Begins waiting for the next tick.
+    void InitAsyncWait();
+
+    //! Links a timer into the slot for its expiry.
+    //! \param timer the timer to link
+    void Link(Timer& timer) noexcept;
+
+    //! Unlinks a timer from its slot.
+    //! \param timer the timer to unlink
+    void Unlink(Timer& timer) noexcept;
+};
+//! \}
+
+}; // namespace Utility
+}; // namespace Scratch
+
+#endif // _SCRATCH_TIMER_WHEEL_HPP_
@@ -0,0 +1,85 @@
+//! \file transport.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_TRANSPORT_HPP_
+#define _SCRATCH_TRANSPORT_HPP_
+
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Net {
+
+// Boost types.
+using Address = boost::asio::ip::address;
+using ConstBuffersType = boost::asio::streambuf::const_buffers_type;
+using ErrorCode = boost::system::error_code;
+using MutableBuffer = boost::asio::mutable_buffer;
+
+//! The transport interface. \{
+//! \remark Carries a descriptor's wire bytes. The protocol layer sits
+//!     above it, so a session may ride a TCP socket or a channel
+//!     multiplexed by another process.
+class Transport {
+public:
+    //! The completion handler type.
+    using Handler = std::function<void(const ErrorCode&, std::size_t)>;
+
+    //! Destructor.
+    virtual ~Transport() noexcept {
+	// Nothing.
+    }
+
+    //! Reads some bytes.
+    //! \param buffer the buffer to fill
+    //! \param handler the completion handler
+    virtual void AsyncRead(
+	const MutableBuffer& buffer,
+	Handler handler) = 0;
+
+    //! Writes every byte of \p buffers.
+    //! \param buffers the bytes to write
+    //! \param handler the completion handler
+    virtual void AsyncWrite(
+	const ConstBuffersType& buffers,
+	Handler handler) = 0;
+
+    //! Closes the transport; outstanding operations complete with
+    //! \c operation_aborted.
+    //! \param errorCode set on failure
+    virtual void Close(ErrorCode& errorCode) noexcept = 0;
+
+    //! Returns the remote address.
+    virtual Address GetAddress() const noexcept = 0;
+
+    //! Returns the OS handle to inherit across a hot reboot, or -1 if the
+    //! transport cannot be handed off.
+    virtual int GetNativeHandle() noexcept {
+	return -1;
+    }
+
+    //! Returns whether the transport is open.
+    virtual bool IsOpen() const noexcept = 0;
+
+    //! Called when the descriptor begins asynchronous I/O.
+    virtual void OnStart() {
+	// Nothing.
+    }
+
+    //! Holds or releases partial frames until the prompt.
+    //! \param cork whether to cork
+    //! \return \c true if the setting took effect
+    virtual bool SetCork(const bool cork) noexcept {
+	return false;
+    }
+};
+//! \}
+
+}; // namespace Net
+}; // namespace Scratch
+
+#endif // _SCRATCH_TRANSPORT_HPP_
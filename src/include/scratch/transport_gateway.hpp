@@ -0,0 +1,126 @@
+//! \file transport_gateway.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_TRANSPORT_GATEWAY_HPP_
+#define _SCRATCH_TRANSPORT_GATEWAY_HPP_
+
+#include <scratch/scratch.hpp>
+#include <scratch/transport.hpp>
+
+namespace Scratch {
+namespace Net {
+
+// Forward declarations.
+class Gateway;
+
+// Boost types.
+using IoContext = boost::asio::io_context;
+
+// ScratchMUD types.
+using GatewayWeakPtr = std::weak_ptr<Gateway>;
+
+//! The gateway channel transport. \{
+//! \remark One session multiplexed over the \c scratch-gateway channel.
+//!     The gateway owns the TCP socket; this end only trades frames.
+class GatewayTransport: public Transport {
+public:
+    //! Constructor.
+    //! \param ioContext the I/O context that runs completions
+    //! \param gateway the channel multiplexer
+    //! \param session the session ID
+    //! \param address the remote address reported by the gateway
+    GatewayTransport(
+	IoContext& ioContext,
+	const GatewayWeakPtr& gateway,
+	const std::uint32_t session,
+	const Address& address) noexcept;
+
+    //! Destructor.
+    virtual ~GatewayTransport() noexcept;
+
+    //! Reads some bytes.
+    //! \param buffer the buffer to fill
+    //! \param handler the completion handler
+    virtual void AsyncRead(
+	const MutableBuffer& buffer,
+	Handler handler) override;
+
+    //! Writes every byte of \p buffers.
+    //! \param buffers the bytes to write
+    //! \param handler the completion handler
+    //! \remark Completes once the frames reach the channel.
+    virtual void AsyncWrite(
+	const ConstBuffersType& buffers,
+	Handler handler) override;
+
+    //! Closes the session and tells the gateway to drop the client.
+    //! \param errorCode set on failure
+    virtual void Close(ErrorCode& errorCode) noexcept override;
+
+    //! Returns the remote address.
+    virtual Address GetAddress() const noexcept override;
+
+    //! Returns whether the session is open.
+    virtual bool IsOpen() const noexcept override;
+
+    //! Relays \c TCP_CORK to the gateway.
+    //! \param cork whether to cork
+    //! \return \c true if the gateway was told
+    virtual bool SetCork(const bool cork) noexcept override;
+
+    //! Queues bytes the gateway received from the client.
+    //! \param data the bytes
+    //! \param nBytes the number of bytes
+    void Receive(
+	const char* data,
+	const std::size_t nBytes);
+
+    //! Marks the client gone; the pending read completes with \c eof.
+    //! \remark Called on a \c GATEWAY_CLOSE frame or when the channel is
+    //!     lost.
+    void ReceiveClose() noexcept;
+
+protected:
+    //! The remote address.
+    //! \sa #GetAddress() const
+    Address address_;
+
+    //! The channel multiplexer.
+    GatewayWeakPtr gateway_;
+
+    //! Client bytes not yet read.
+    String input_;
+
+    //! The I/O context that runs completions.
+    IoContext& ioContext_;
+
+    //! Whether the session is open.
+    //! \sa #IsOpen() const
+    bool open_;
+
+    //! The buffer of the pending read.
+    MutableBuffer readBuffer_;
+
+    //! The handler of the pending read, or empty.
+    Handler readHandler_;
+
+    //! Whether the client is gone.
+    bool remoteClosed_;
+
+    //! The session ID.
+    std::uint32_t session_;
+
+    //! Completes the pending read if input, \c eof, or a close is due.
+    void CompleteRead();
+};
+//! \}
+
+}; // namespace Net
+}; // namespace Scratch
+
+#endif // _SCRATCH_TRANSPORT_GATEWAY_HPP_
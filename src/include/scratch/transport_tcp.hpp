@@ -0,0 +1,76 @@
+//! \file transport_tcp.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_TRANSPORT_TCP_HPP_
+#define _SCRATCH_TRANSPORT_TCP_HPP_
+
+#include <scratch/scratch.hpp>
+#include <scratch/transport.hpp>
+
+namespace Scratch {
+namespace Net {
+
+// Boost types.
+using Socket = boost::asio::ip::tcp::socket;
+
+//! The TCP transport. \{
+class TcpTransport: public Transport {
+public:
+    //! Constructor.
+    //! \param socket the Boost socket
+    explicit TcpTransport(Socket&& socket) noexcept;
+
+    //! Destructor.
+    virtual ~TcpTransport() noexcept;
+
+    //! Reads some bytes.
+    //! \param buffer the buffer to fill
+    //! \param handler the completion handler
+    virtual void AsyncRead(
+	const MutableBuffer& buffer,
+	Handler handler) override;
+
+    //! Writes every byte of \p buffers.
+    //! \param buffers the bytes to write
+    //! \param handler the completion handler
+    virtual void AsyncWrite(
+	const ConstBuffersType& buffers,
+	Handler handler) override;
+
+    //! Closes the socket.
+    //! \param errorCode set on failure
+    virtual void Close(ErrorCode& errorCode) noexcept override;
+
+    //! Returns the remote address.
+    virtual Address GetAddress() const noexcept override;
+
+    //! Returns the socket handle.
+    virtual int GetNativeHandle() noexcept override;
+
+    //! Returns whether the socket is open.
+    virtual bool IsOpen() const noexcept override;
+
+    //! Disables Nagle; corking, not Nagle, batches replies.
+    virtual void OnStart() override;
+
+    //! Sets or clears \c TCP_CORK.
+    //! \param cork whether to cork
+    //! \return \c true if the setting took effect
+    //! \remark Clearing \c TCP_CORK pushes any partial frame immediately.
+    virtual bool SetCork(const bool cork) noexcept override;
+
+protected:
+    //! The Boost socket.
+    Socket socket_;
+};
+//! \}
+
+}; // namespace Net
+}; // namespace Scratch
+
+#endif // _SCRATCH_TRANSPORT_TCP_HPP_
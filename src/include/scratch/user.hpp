@@ -13,6 +13,7 @@
 #include <scratch/gender.hpp>
 #include <scratch/scratch.hpp>
 #include <scratch/string.hpp>
+#include <scratch/symbol_table.hpp>
 #include <scratch/thing.hpp>
 
 // Forward declarations.
@@ -54,6 +55,7 @@ public:
     //! \sa #SetPermissions(const StringSetCi&)
     void AddPermission(const String& permission) {
 	permissions_.insert(permission);
+	SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
     }
 
     //! Adds a player name.
@@ -72,6 +74,7 @@ public:
     //! \sa #SetPreferences(const StringSetCi&)
     void AddPreference(const String& preference) {
 	preferences_.insert(preference);
+	SymbolTable::Preferences().MakeBits(preferences_, preferenceBits_);
     }
 
     //! Clears the metacolor.
@@ -86,6 +89,7 @@ public:
     //! \sa #SetPermissions(const StringSetCi&)
     void ErasePermission(const String& permission) {
 	permissions_.erase(permission);
+	SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
     }
 
     //! Erases a player name.
@@ -104,6 +108,7 @@ public:
     //! \sa #SetPreferences(const StringSetCi&)
     void ErasePreference(const String& preference) {
 	preferences_.erase(preference);
+	SymbolTable::Preferences().MakeBits(preferences_, preferenceBits_);
     }
 
     //! Gets the email address.
@@ -143,6 +148,12 @@ public:
 	return password_;
     }
 
+    //! Gets the permissions as interned symbols.
+    //! \sa SymbolTable::Permissions()
+    const SymbolBits& GetPermissionBits() const noexcept {
+	return permissionBits_;
+    }
+
     //! Gets the permissions.
     //! \sa #SetPermissions(const StringSetCi&)
     StringSetCi GetPermissions() const noexcept {
@@ -155,6 +166,12 @@ public:
 	return players_;
     }
 
+    //! Gets the preferences as interned symbols.
+    //! \sa SymbolTable::Preferences()
+    const SymbolBits& GetPreferenceBits() const noexcept {
+	return preferenceBits_;
+    }
+
     //! Gets the preferences.
     //! \sa #SetPreferences(const StringSetCi&)
     StringSetCi GetPreferences() const noexcept {
@@ -170,6 +187,14 @@ public:
 	return permissions_.find(permission) != permissions_.end();
     }
 
+    //! Returns whether the interned permission \p symbol is present.
+    //! \param symbol the permission symbol to test
+    //! \sa #HasPermission(const String&) const
+    //! \sa SymbolTable::Permissions()
+    bool HasPermission(const unsigned symbol) const noexcept {
+	return SymbolTable::Test(permissionBits_, symbol);
+    }
+
     //! Returns whether \p player is present.
     //! \param player the player name to test
     //! \sa #AddPlayer(const String&)
@@ -188,6 +213,14 @@ public:
 	return preferences_.find(preference) != preferences_.end();
     }
 
+    //! Returns whether the interned preference \p symbol is present.
+    //! \param symbol the preference symbol to test
+    //! \sa #HasPreference(const String&) const
+    //! \sa SymbolTable::Preferences()
+    bool HasPreference(const unsigned symbol) const noexcept {
+	return SymbolTable::Test(preferenceBits_, symbol);
+    }
+
     //! Reads colors from a data node.
     //! \param data the Colors data node to read
     //! \sa #ReadData(const DataPtr&)
@@ -268,6 +301,7 @@ public:
     //! \sa #GetPermissions() const
     void SetPermissions(const StringSetCi& permissions) {
 	permissions_ = permissions;
+	SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
     }
 
     //! Sets the player names.
@@ -282,6 +316,7 @@ public:
     //! \sa #GetPreferences() const
     void SetPreferences(const StringSetCi& preferences) {
 	preferences_ = preferences;
+	SymbolTable::Preferences().MakeBits(preferences_, preferenceBits_);
     }
 
     //! Writes colors to a data node.
@@ -355,6 +390,11 @@ protected:
     //! \sa #SetPermissions(const StringSetCi&)
     StringSetCi permissions_;
 
+    //! The interned permissions; names past SymbolTable::MaxSymbols
+    //!     are absent.
+    //! \sa #GetPermissionBits() const
+    SymbolBits permissionBits_;
+
     //! The player names owned by this user.
     //! \sa #GetPlayers() const
     //! \sa #SetPlayers(const StringSetCi&)
@@ -364,6 +404,11 @@ protected:
     //! \sa #GetPreferences() const
     //! \sa #SetPreferences(const StringSetCi&)
     StringSetCi preferences_;
+
+    //! The interned preferences; names past SymbolTable::MaxSymbols
+    //!     are absent.
+    //! \sa #GetPreferenceBits() const
+    SymbolBits preferenceBits_;
 };
 //! \}
 
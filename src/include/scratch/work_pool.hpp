@@ -0,0 +1,111 @@
+//! \file work_pool.hpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#ifndef _SCRATCH_WORK_POOL_HPP_
+#define _SCRATCH_WORK_POOL_HPP_
+
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Utility {
+
+//! The work pool class. \{
+//! \remark Fork-join thread pool. #Run deals a batch of tasks across one
+//!     queue per thread, the calling thread included, and blocks until
+//!     the batch is done. Each thread takes from the back of its own
+//!     queue and, once that is empty, steals from the front of the
+//!     others, so an uneven batch still finishes on every core.
+class WorkPool {
+public:
+    //! The task type.
+    //! \remark Exceptions are logged and swallowed.
+    using Task = std::function<void()>;
+
+    //! Constructor.
+    //! \param threads the number of worker threads besides the caller;
+    //!     zero runs every batch on the calling thread
+    explicit WorkPool(const std::size_t threads);
+
+    //! Copy constructor.
+    WorkPool(const WorkPool&) = delete;
+
+    //! Destructor.
+    //! \remark Joins the worker threads.
+    ~WorkPool() noexcept;
+
+    //! Copy assignment operator.
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    //! Gets the number of tasks taken from another thread's queue.
+    std::uint64_t GetSteals() const noexcept {
+	return steals_;
+    }
+
+    //! Gets the number of worker threads besides the caller.
+    std::size_t GetThreads() const noexcept {
+	return threads_.size();
+    }
+
+    //! Runs a batch of tasks.
+    //! \param tasks the tasks, consumed
+    //! \remark Blocks until every task has finished. Not reentrant.
+    void Run(std::vector<Task>& tasks);
+
+protected:
+    //! One thread's task queue. \{
+    struct Queue {
+	//! Guards #tasks.
+	std::mutex mutex;
+
+	//! The tasks; the owner takes the back, thieves the front.
+	std::deque<Task> tasks;
+    };
+    //! \}
+
+    //! Signals that a batch has finished.
+    std::condition_variable done_;
+
+    //! The current batch.
+    std::uint64_t generation_;
+
+    //! Guards #generation_, #pending_, and #stopping_.
+    std::mutex mutex_;
+
+    //! The tasks not yet finished in the current batch.
+    std::size_t pending_;
+
+    //! The task queues; the caller owns the first.
+    std::vector<std::unique_ptr<Queue>> queues_;
+
+    //! The number of tasks stolen.
+    std::atomic<std::uint64_t> steals_;
+
+    //! Whether the worker threads should exit.
+    bool stopping_;
+
+    //! The worker threads.
+    std::vector<std::thread> threads_;
+
+    //! Signals that a batch has started.
+    std::condition_variable wake_;
+
+    //! Runs one task from \p self's queue or, failing that, a stolen one.
+    //! \param self the queue of the running thread
+    //! \return \c false if every queue was empty
+    bool RunOne(const std::size_t self) noexcept;
+
+    //! The worker thread loop.
+    //! \param self the queue of this thread
+    void Work(const std::size_t self) noexcept;
+};
+//! \}
+
+}; // namespace Utility
+}; // namespace Scratch
+
+#endif // _SCRATCH_WORK_POOL_HPP_
@@ -9,14 +9,64 @@
 #define _SCRATCH_ACTION_CPP_
 
 #include <scratch/action.hpp>
+#include <scratch/gender.hpp>
+#include <scratch/instance.hpp>
+#include <scratch/player.hpp>
 #include <scratch/scratch.hpp>
 #include <scratch/string.hpp>
 
+#include <cctype>
 #include <sstream>
 
 namespace Scratch {
 namespace Core {
 
+namespace {
+
+//! Returns the genitive form.
+//! \param name the name
+String MakeNamePossessive(const String& name) {
+    if (name.empty())
+	return "<Invalid>";
+    const auto lower = [](const char c) {
+	return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    };
+    const char last = lower(name.back());
+    if (last == 's' || last == 'x' || last == 'z')
+	return name + "'";
+    if (name.size() >= 2) {
+	const char a = lower(name[name.size() - 2]);
+	const char b = lower(name[name.size() - 1]);
+	if ((a == 'c' && b == 'h') || (a == 's' && b == 'h'))
+	    return name + "'";
+    }
+    return name + "'s";
+}
+
+//! Returns whether text starts with vowel.
+//! \param text the text
+bool StartsWithVowel(const String& text) noexcept {
+    if (text.empty())
+	return false;
+    const char c = static_cast<char>(
+	std::tolower(static_cast<unsigned char>(text[0])));
+    return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u';
+}
+
+//! Resolves name.
+//! \param instance the instance
+//! \return the name
+String ResolveName(const InstancePtr& instance) {
+    if (!instance)
+	return String();
+    auto player = instance->GetPlayer();
+    if (player)
+	return player->GetName();
+    return String();
+}
+
+} // namespace
+
 //! Default constructor.
 ActionParam::ActionParam() noexcept :
 	text_(),
@@ -79,5 +129,231 @@ ActionParam::ActionParam(const InstancePtr& instance) noexcept :
     // Nothing.
 }
 
+//! Constructor.
+//! \param message the message template
+ActionTemplate::ActionTemplate(const String& message) :
+	literals_(),
+	segments_() {
+    literals_.reserve(message.size());
+    for (std::size_t i = 0; i < message.size(); ++i) {
+	if (message[i] != '$') {
+	    auto next = message.find('$', i);
+	    if (next == String::npos)
+		next = message.size();
+	    this->AppendLiteral(message.substr(i, next - i));
+	    i = next - 1;
+	    continue;
+	}
+	if (i + 1 >= message.size()) {
+	    this->AppendLiteral("$");
+	    continue;
+	}
+	if (message[i + 1] == '$') {
+	    this->AppendLiteral("$");
+	    ++i;
+	    continue;
+	}
+	if (message[i + 1] != '{') {
+	    this->AppendLiteral("$");
+	    continue;
+	}
+	const std::size_t begin = i + 2;
+	std::size_t end = begin;
+	while (end < message.size() && message[end] != '}')
+	    ++end;
+	if (end >= message.size()) {
+	    this->AppendLiteral(message.substr(i));
+	    break;
+	}
+	const auto body = message.substr(begin, end - begin);
+	const auto colon = body.find(':');
+	Segment segment;
+	if (colon == String::npos) {
+	    segment.you = this->CompileSide(body);
+	    segment.other = segment.you;
+	} else {
+	    segment.you = this->CompileSide(body.substr(0, colon));
+	    segment.other = this->CompileSide(body.substr(colon + 1));
+	}
+	segments_.push_back(segment);
+	i = end;
+    }
+}
+
+//! Destructor.
+ActionTemplate::~ActionTemplate() noexcept {
+    // Nothing.
+}
+
+//! Appends literal text, merging into a trailing literal segment.
+//! \param text the literal text
+void ActionTemplate::AppendLiteral(const String& text) {
+    if (text.empty())
+	return;
+    if (!segments_.empty()) {
+	auto& last = segments_.back();
+	if (last.you.property == PROP_LITERAL &&
+		last.other.property == PROP_LITERAL &&
+		last.you.offset + last.you.length == literals_.size() &&
+		last.other.offset == last.you.offset &&
+		last.other.length == last.you.length) {
+	    literals_ += text;
+	    last.you.length += text.size();
+	    last.other.length = last.you.length;
+	    return;
+	}
+    }
+    Segment segment;
+    segment.you.offset = literals_.size();
+    segment.you.length = text.size();
+    segment.other = segment.you;
+    literals_ += text;
+    segments_.push_back(segment);
+}
+
+//! Compiles one macro side.
+//! \param text the side text
+ActionTemplate::Side ActionTemplate::CompileSide(const String& text) {
+    //! The property names. \{
+    static const struct {
+	const char* name;
+	Property property;
+	bool raw;
+    } properties[] = {
+	{"An",			PROP_AN,		false},
+	{"Copula",		PROP_COPULA,		false},
+	{"Determiner",		PROP_DETERMINER,	false},
+	{"Name",		PROP_NAME,		false},
+	{"NamePossessive",	PROP_NAME_POSSESSIVE,	false},
+	{"Object",		PROP_OBJECT,		false},
+	{"Possessive",		PROP_POSSESSIVE,	false},
+	{"RawCopula",		PROP_COPULA,		true},
+	{"RawDeterminer",	PROP_DETERMINER,	true},
+	{"RawName",		PROP_NAME,		true},
+	{"RawNamePossessive",	PROP_NAME_POSSESSIVE,	true},
+	{"RawObject",		PROP_OBJECT,		true},
+	{"RawPossessive",	PROP_POSSESSIVE,	true},
+	{"RawReflexive",	PROP_REFLEXIVE,		true},
+	{"RawSubject",		PROP_SUBJECT,		true},
+	{"Reflexive",		PROP_REFLEXIVE,		false},
+	{"Subject",		PROP_SUBJECT,		false},
+	{"Text",		PROP_TEXT,		false}
+    };
+    //! \}
+
+    Side side;
+    const auto dot = text.find('.');
+    if (dot == String::npos) {
+	side.offset = literals_.size();
+	side.length = text.size();
+	literals_ += text;
+	return side;
+    }
+
+    side.property = PROP_INVALID;
+    if (dot == 0 || text.size() < 3)
+	return side;
+    switch (static_cast<char>(
+	    std::toupper(static_cast<unsigned char>(text[0])))) {
+    case 'S': side.slot = 0; break;
+    case 'D': side.slot = 1; break;
+    case 'I': side.slot = 2; break;
+    case 'X': side.slot = 3; break;
+    default: return side;
+    }
+    const auto prop = text.substr(dot + 1);
+    for (const auto& entry: properties) {
+	if (Scratch::Algorithm::StringCompareCi(prop, entry.name) == 0) {
+	    side.property = entry.property;
+	    side.raw = entry.raw;
+	    break;
+	}
+    }
+    return side;
+}
+
+//! Expands this template for one recipient.
+//! \param subject the subject slot
+//! \param direct the direct slot
+//! \param indirect the indirect slot
+//! \param extra the extra slot
+//! \param recipient the recipient instance
+String ActionTemplate::Expand(
+	const ActionParam& subject,
+	const ActionParam& direct,
+	const ActionParam& indirect,
+	const ActionParam& extra,
+	const InstancePtr& recipient) const {
+    const ActionParam* params[] = {&subject, &direct, &indirect, &extra};
+    const bool youSubject =
+	    subject.GetInstance() && recipient &&
+	    subject.GetInstance() == recipient;
+
+    String out;
+    out.reserve(literals_.size());
+    for (const auto& segment: segments_) {
+	const auto& side = youSubject ? segment.you : segment.other;
+	switch (static_cast<int>(side.property)) {
+	case PROP_LITERAL:
+	    out.append(literals_, side.offset, side.length);
+	    break;
+	case PROP_INVALID:
+	    out += "<Invalid>";
+	    break;
+	default:
+	    out += Resolve(side, *params[side.slot], recipient);
+	    break;
+	}
+    }
+    return out;
+}
+
+//! Resolves one property side.
+//! \param side the side
+//! \param param the slot param
+//! \param recipient the recipient instance
+String ActionTemplate::Resolve(
+	const Side& side,
+	const ActionParam& param,
+	const InstancePtr& recipient) {
+    const auto instance = param.GetInstance();
+    if (side.property == PROP_TEXT) {
+	if (!param.GetText().empty())
+	    return param.GetText();
+	return ResolveName(instance);
+    }
+    if (side.property == PROP_AN) {
+	String text = param.GetText();
+	if (text.empty() && instance)
+	    text = ResolveName(instance);
+	return StartsWithVowel(text) ? "an" : "a";
+    }
+    if (!instance)
+	return "<Invalid>";
+
+    const bool isMe = !side.raw && recipient && instance == recipient;
+    const auto gender = instance->GetGender();
+    switch (static_cast<int>(side.property)) {
+    case PROP_NAME:
+	return isMe ? "you" : ResolveName(instance);
+    case PROP_NAME_POSSESSIVE:
+	return isMe ? "your" : MakeNamePossessive(ResolveName(instance));
+    case PROP_COPULA:
+	return isMe ? "are" : Gender::GetCopula(gender);
+    case PROP_DETERMINER:
+	return isMe ? "your" : Gender::GetDeterminer(gender);
+    case PROP_SUBJECT:
+	return isMe ? "you" : Gender::GetSubject(gender);
+    case PROP_OBJECT:
+	return isMe ? "you" : Gender::GetObject(gender);
+    case PROP_POSSESSIVE:
+	return isMe ? "yours" : Gender::GetPossessive(gender);
+    case PROP_REFLEXIVE:
+	return isMe ? "yourself" : Gender::GetReflexive(gender);
+    default:
+	return "<Invalid>";
+    }
+}
+
 }; // namespace Core
 }; // namespace Scratch
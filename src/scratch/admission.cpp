@@ -0,0 +1,289 @@
+//! \file admission.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_ADMISSION_CPP_
+
+#include <scratch/admission.hpp>
+#include <scratch/data.hpp>
+#include <scratch/logger.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+
+namespace Scratch {
+namespace Net {
+
+// Boost types.
+using ErrorCode = boost::system::error_code;
+
+// ScratchMUD types.
+using Data = Scratch::Utility::Data;
+using DataPtr = std::shared_ptr<Data>;
+
+//! Fixed path of the ban list Data file.
+static const char banFileName[] = "data/ban.dat";
+
+//! Bit offset of an IPv4 address within its IPv4-mapped key.
+static const unsigned v4MappedBits = 96;
+
+// std::max binds MinPrune by reference, so it needs a definition.
+const std::size_t Admission::MinPrune;
+
+//! Default constructor.
+Admission::Admission() noexcept :
+	banRoot_(std::make_unique<BanNode>()),
+	banCount_(0),
+	buckets_(),
+	burst_(5),
+	limit_(8),
+	pruneAt_(MinPrune),
+	rate_(0.5) {
+    // Nothing.
+}
+
+//! Destructor.
+Admission::~Admission() noexcept {
+    // Nothing.
+}
+
+//! Screens a connection and, if admitted, counts it against
+//! \p address.
+//! \param address the source address
+//! \return the admission verdict
+//! \sa #Release(const Address&)
+Admission::Verdict Admission::Admit(const Address& address) noexcept {
+    const auto now = std::chrono::steady_clock::now();
+
+    // Bound memory under address churn.
+    if (buckets_.size() >= pruneAt_)
+	this->Prune(now);
+
+    // Find or start bucket.
+    auto it = buckets_.find(address);
+    if (it == std::end(buckets_)) {
+	it = buckets_.emplace(address, Bucket()).first;
+	it->second.refilled = now;
+	it->second.tokens = burst_;
+    } else {
+	this->Refill(it->second, now);
+    }
+    auto& bucket = it->second;
+
+    // Screen connection.
+    auto verdict = ADMIT;
+    if (this->IsBanned(address))
+	verdict = REJECT_BANNED;
+    else if (limit_ && bucket.connections >= limit_)
+	verdict = REJECT_LIMIT;
+    else if (bucket.tokens < 1.0)
+	verdict = REJECT_RATE;
+
+    if (verdict != ADMIT) {
+	// Log the first rejection of a run only.
+	if (bucket.rejected++ == 0) {
+	    LOGGER_NETWORK() << "Rejecting connections from " << address
+		<< " (" << VerdictToString(verdict) << ").";
+	}
+	return verdict;
+    }
+
+    if (bucket.rejected) {
+	LOGGER_NETWORK() << "Rejected " << bucket.rejected
+	    << " connection(s) from " << address << ".";
+	bucket.rejected = 0;
+    }
+    bucket.tokens -= 1.0;
+    ++bucket.connections;
+    return ADMIT;
+}
+
+//! Counts an already-open connection against \p address without
+//! screening it.
+//! \param address the source address
+//! \remark Used for sessions handed over by a hot reboot.
+//! \sa #Release(const Address&)
+void Admission::Adopt(const Address& address) noexcept {
+    auto it = buckets_.find(address);
+    if (it == std::end(buckets_)) {
+	it = buckets_.emplace(address, Bucket()).first;
+	it->second.refilled = std::chrono::steady_clock::now();
+	it->second.tokens = burst_;
+    }
+    ++it->second.connections;
+}
+
+//! Returns whether \p address matches a banned prefix.
+//! \param address the source address
+bool Admission::IsBanned(const Address& address) const noexcept {
+    const auto bytes = ToBytes(address);
+    const BanNode* node = banRoot_.get();
+    for (unsigned bit = 0; node; ++bit) {
+	if (node->banned)
+	    return true;
+	if (bit == bytes.size() * 8)
+	    break;
+	const auto branch = (bytes[bit / 8] >> (7 - bit % 8)) & 1;
+	node = node->children[branch].get();
+    }
+    return false;
+}
+
+//! Loads the ban list from the fixed Data file.
+//! \return \c true if the file was loaded; the previous list is kept
+//!     otherwise
+bool Admission::LoadBans() noexcept {
+    auto root = std::make_shared<Data>();
+    if (!root->LoadFile(banFileName)) {
+	LOGGER_NETWORK() << "Error loading ban list " << banFileName << ".";
+	return false;
+    }
+
+    for (const auto& entry: root->GetEntries()) {
+	if (Scratch::Algorithm::StringCompareCi(entry.first, "Bans")) {
+	    LOGGER_NETWORK() << "Unknown ban list key " << entry.first << ".";
+	    return false;
+	}
+    }
+
+    // Build replacement tree.
+    auto banRoot = std::make_unique<BanNode>();
+    std::size_t banCount = 0;
+    if (auto bans = root->Get("Bans")) {
+	for (const auto& entry: bans->GetEntries()) {
+	    const auto cidr = bans->GetString(entry.first);
+	    if (!InsertBan(*banRoot, cidr)) {
+		LOGGER_NETWORK() << "Invalid ban " << entry.first << ": " << cidr << ".";
+		return false;
+	    }
+	    ++banCount;
+	}
+    }
+
+    banRoot_ = std::move(banRoot);
+    banCount_ = banCount;
+    LOGGER_NETWORK() << "Loaded " << banCount_ << " ban(s).";
+    return true;
+}
+
+//! Releases a connection admitted for \p address.
+//! \param address the source address
+//! \sa #Admit(const Address&)
+void Admission::Release(const Address& address) noexcept {
+    auto it = buckets_.find(address);
+    if (it != std::end(buckets_) && it->second.connections)
+	--it->second.connections;
+}
+
+//! Sets the per-address limits.
+//! \param rate the sustained connection rate, per minute
+//! \param burst the burst allowance
+//! \param limit the concurrent connection limit, or zero
+void Admission::SetLimits(
+	const double rate,
+	const unsigned burst,
+	const unsigned limit) noexcept {
+    burst_ = std::max(burst, 1u);
+    limit_ = limit;
+    rate_ = rate / 60.0;
+}
+
+//! Returns a verdict name.
+//! \param verdict the verdict
+const char* Admission::VerdictToString(const Verdict verdict) noexcept {
+    switch (static_cast<int>(verdict)) {
+    case ADMIT:		return "admitted";
+    case REJECT_BANNED:	return "banned";
+    case REJECT_LIMIT:	return "connection limit";
+    case REJECT_RATE:	return "rate limit";
+    default:		return "unknown";
+    }
+}
+
+//! Inserts a banned prefix.
+//! \param root the tree root
+//! \param cidr the prefix in \c address/length form
+//! \return \c true if \p cidr was valid
+bool Admission::InsertBan(
+	BanNode& root,
+	const String& cidr) noexcept {
+    // Split address and prefix length.
+    const auto slash = cidr.find('/');
+    ErrorCode errorCode;
+    const auto address = boost::asio::ip::make_address(
+	cidr.substr(0, slash), errorCode);
+    if (errorCode)
+	return false;
+
+    const unsigned offset = address.is_v4() ? v4MappedBits : 0;
+    unsigned length = 128 - offset;
+    if (slash != String::npos) {
+	const auto lengthText = cidr.substr(slash + 1);
+	if (lengthText.empty() || lengthText.size() > 3 ||
+		!std::all_of(std::begin(lengthText), std::end(lengthText), ::isdigit))
+	    return false;
+	length = static_cast<unsigned>(std::stoul(lengthText));
+	if (length > 128 - offset)
+	    return false;
+    }
+    length += offset;
+
+    // Walk or grow one node per prefix bit.
+    const auto bytes = ToBytes(address);
+    BanNode* node = &root;
+    for (unsigned bit = 0; bit < length; ++bit) {
+	const auto branch = (bytes[bit / 8] >> (7 - bit % 8)) & 1;
+	if (!node->children[branch])
+	    node->children[branch] = std::make_unique<BanNode>();
+	node = node->children[branch].get();
+    }
+    node->banned = true;
+    return true;
+}
+
+//! Erases idle, full buckets.
+//! \param now the current time
+void Admission::Prune(const std::chrono::steady_clock::time_point now) noexcept {
+    for (auto it = std::begin(buckets_); it != std::end(buckets_); ) {
+	this->Refill(it->second, now);
+	if (!it->second.connections && it->second.tokens >= burst_)
+	    it = buckets_.erase(it);
+	else
+	    ++it;
+    }
+    pruneAt_ = std::max(MinPrune, buckets_.size() * 2);
+}
+
+//! Refills a bucket.
+//! \param bucket the bucket
+//! \param now the current time
+void Admission::Refill(
+	Bucket& bucket,
+	const std::chrono::steady_clock::time_point now) const noexcept {
+    const std::chrono::duration<double> elapsed = now - bucket.refilled;
+    bucket.tokens = std::min(
+	static_cast<double>(burst_),
+	bucket.tokens + elapsed.count() * rate_);
+    bucket.refilled = now;
+}
+
+//! Returns the tree key for \p address.
+//! \param address the address
+Admission::AddressBytes Admission::ToBytes(const Address& address) noexcept {
+    if (address.is_v6())
+	return address.to_v6().to_bytes();
+
+    // Map IPv4 into ::ffff:0:0/96.
+    AddressBytes bytes = {};
+    const auto v4 = address.to_v4().to_bytes();
+    bytes[10] = 0xff;
+    bytes[11] = 0xff;
+    std::copy(std::begin(v4), std::end(v4), std::begin(bytes) + 12);
+    return bytes;
+}
+
+}; // namespace Net
+}; // namespace Scratch
@@ -0,0 +1,78 @@
+//! \file audience.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_AUDIENCE_CPP_
+
+#include <scratch/audience.hpp>
+#include <scratch/instance.hpp>
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Core {
+
+//! Default constructor.
+Audience::Audience() noexcept :
+	members_() {
+    // Nothing.
+}
+
+//! Destructor.
+Audience::~Audience() noexcept {
+    this->Clear();
+}
+
+//! Removes every member.
+void Audience::Clear() noexcept {
+    for (auto& member: members_) {
+	member->audience_ = nullptr;
+	member->audienceSlot_ = 0;
+    }
+    members_.clear();
+}
+
+//! Returns whether \p instance is a member.
+//! \param instance the instance
+bool Audience::Contains(const InstancePtr& instance) const noexcept {
+    return instance && instance->audience_ == this;
+}
+
+//! Removes a member.
+//! \param instance the instance to remove
+//! \remark Moves the last member into the vacated slot.
+//! \sa #Insert(const InstancePtr&)
+void Audience::Erase(const InstancePtr& instance) noexcept {
+    if (!this->Contains(instance))
+	return;
+
+    // Swap last member into slot.
+    const auto slot = instance->audienceSlot_;
+    if (slot + 1 != members_.size()) {
+	members_[slot] = std::move(members_.back());
+	members_[slot]->audienceSlot_ = slot;
+    }
+    members_.pop_back();
+    instance->audience_ = nullptr;
+    instance->audienceSlot_ = 0;
+}
+
+//! Adds a member, removing it from any other audience first.
+//! \param instance the instance to add
+//! \sa #Erase(const InstancePtr&)
+void Audience::Insert(const InstancePtr& instance) noexcept {
+    if (!instance || this->Contains(instance))
+	return;
+    if (instance->audience_)
+	instance->audience_->Erase(instance);
+
+    instance->audience_ = this;
+    instance->audienceSlot_ = members_.size();
+    members_.push_back(instance);
+}
+
+}; // namespace Core
+}; // namespace Scratch
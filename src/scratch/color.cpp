@@ -19,49 +19,49 @@ namespace Net {
 //! \param name the color name
 //! \sa #ToString(ColorEnum)
 Color::ColorEnum Color::ByName(const String& name) noexcept {
-    static StringMapCi<ColorEnum> colors;
-    if (colors.empty()) {
-	colors["Amber"] = C_AMBER;
-	colors["Aqua"] = C_AQUA;
-	colors["Azure"] = C_AZURE;
-	colors["Black"] = C_CHARCOAL;
-	colors["Blue"] = C_INDIGO;
-	colors["Charcoal"] = C_CHARCOAL;
-	colors["Crimson"] = C_CRIMSON;
-	colors["Cyan"] = C_TEAL;
-	colors["Emphasis"] = C_EMPHASIS;
-	colors["Enum"] = C_ENUM;
-	colors["Failed"] = C_FAILED;
-	colors["Forest"] = C_FOREST;
-	colors["Gray"] = C_GRAY;
-	colors["Green"] = C_FOREST;
-	colors["Indigo"] = C_INDIGO;
-	colors["Key"] = C_KEY;
-	colors["Lime"] = C_LIME;
-	colors["Magenta"] = C_PURPLE;
-	colors["Name"] = C_NAME;
-	colors["Normal"] = C_NORMAL;
-	colors["Number"] = C_NUMBER;
-	colors["Ochre"] = C_OCHRE;
-	colors["Okay"] = C_OKAY;
-	colors["Percent"] = C_PERCENT;
-	colors["Pink"] = C_PINK;
-	colors["Prompt"] = C_PROMPT;
-	colors["Punctuation"] = C_PUNCTUATION;
-	colors["Purple"] = C_PURPLE;
-	colors["Red"] = C_CRIMSON;
-	colors["Restricted"] = C_RESTRICTED;
-	colors["Say"] = C_SAY;
-	colors["Silver"] = C_SILVER;
-	colors["Snow"] = C_SNOW;
-	colors["Social"] = C_SOCIAL;
-	colors["Teal"] = C_TEAL;
-	colors["Text"] = C_TEXT;
-	colors["Violet"] = C_VIOLET;
-	colors["White"] = C_SILVER;
-	colors["Yellow"] = C_OCHRE;
-	colors["YesNo"] = C_YESNO;
-    }
+    // Initialized once, so pulse worker threads may look colors up.
+    static const StringUnorderedMapCi<ColorEnum> colors = {
+	{"Amber", C_AMBER},
+	{"Aqua", C_AQUA},
+	{"Azure", C_AZURE},
+	{"Black", C_CHARCOAL},
+	{"Blue", C_INDIGO},
+	{"Charcoal", C_CHARCOAL},
+	{"Crimson", C_CRIMSON},
+	{"Cyan", C_TEAL},
+	{"Emphasis", C_EMPHASIS},
+	{"Enum", C_ENUM},
+	{"Failed", C_FAILED},
+	{"Forest", C_FOREST},
+	{"Gray", C_GRAY},
+	{"Green", C_FOREST},
+	{"Indigo", C_INDIGO},
+	{"Key", C_KEY},
+	{"Lime", C_LIME},
+	{"Magenta", C_PURPLE},
+	{"Name", C_NAME},
+	{"Normal", C_NORMAL},
+	{"Number", C_NUMBER},
+	{"Ochre", C_OCHRE},
+	{"Okay", C_OKAY},
+	{"Percent", C_PERCENT},
+	{"Pink", C_PINK},
+	{"Prompt", C_PROMPT},
+	{"Punctuation", C_PUNCTUATION},
+	{"Purple", C_PURPLE},
+	{"Red", C_CRIMSON},
+	{"Restricted", C_RESTRICTED},
+	{"Say", C_SAY},
+	{"Silver", C_SILVER},
+	{"Snow", C_SNOW},
+	{"Social", C_SOCIAL},
+	{"Teal", C_TEAL},
+	{"Text", C_TEXT},
+	{"Violet", C_VIOLET},
+	{"White", C_SILVER},
+	{"Yellow", C_OCHRE},
+	{"YesNo", C_YESNO}
+    };
 
     auto const found = colors.find(name);
     if (found != colors.end())
@@ -68,6 +68,7 @@ Command::Command() noexcept :
 	action_(),
 	keywords_(),
 	permissions_(),
+	permissionBits_(),
 	social_() {
     // Nothing.
 }
@@ -79,6 +80,7 @@ Command::Command(const Command& other) noexcept :
 	action_(other.action_),
 	keywords_(other.keywords_),
 	permissions_(other.permissions_),
+	permissionBits_(other.permissionBits_),
 	social_() {
     if (other.social_)
 	social_ = std::make_shared<Social>(*other.social_);
@@ -96,6 +98,7 @@ Command& Command::operator=(const Command& other) noexcept {
     action_ = other.action_;
     keywords_ = other.keywords_;
     permissions_ = other.permissions_;
+    permissionBits_ = other.permissionBits_;
     if (other.social_)
 	social_ = std::make_shared<Social>(*other.social_);
     else
@@ -115,6 +118,12 @@ bool Command::Allows(const InstancePtr& performer) const noexcept {
     auto player = performer->GetPlayer();
     if (!player)
 	return false;
+    if ((permissionBits_ & player->GetPermissionBits()).any())
+	return true;
+
+    // Names past SymbolTable::MaxSymbols are absent from the bits.
+    if (permissionBits_.count() == permissions_.size())
+	return false;
     for (const auto& permission: permissions_) {
 	if (player->HasPermission(permission))
 	    return true;
@@ -166,6 +175,7 @@ void Command::ReadPermissionsData(const DataPtr& data) noexcept {
 	if (!permission.empty())
 	    permissions_.insert(permission);
     }
+    SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
 }
 
 //! Writes this command to a data node.
@@ -307,6 +307,7 @@ static int CommandAddPermission(lua_State* L) {
 	return luaL_argerror(L, 2, "unknown permission");
     }
     command->AddPermission(name);
+    game.ReindexCommand(command);
     return 0;
 }
 
@@ -315,7 +316,10 @@ static int CommandErasePermission(lua_State* L) {
     if (lua_gettop(L) != 2)
 	return luaL_error(L, "erase_permission expects 1 argument");
     luaL_checktype(L, 2, LUA_TSTRING);
-    CommandBindings::Check(L, 1)->ErasePermission(Lua::CheckString(L, 2));
+    auto& game = Lua::CheckGame(L);
+    auto command = CommandBindings::Check(L, 1);
+    command->ErasePermission(Lua::CheckString(L, 2));
+    game.ReindexCommand(command);
     return 0;
 }
 
@@ -408,7 +412,9 @@ static int CommandSetPermissions(lua_State* L) {
 	}
 	permissions.insert(name);
     }
-    CommandBindings::Check(L, 1)->SetPermissions(permissions);
+    auto command = CommandBindings::Check(L, 1);
+    command->SetPermissions(permissions);
+    game.ReindexCommand(command);
     return 0;
 }
 
@@ -559,18 +565,14 @@ static int CommandRepositoryGc(lua_State* L) {
 static int CommandRepositoryClear(lua_State* L) {
     if (lua_gettop(L) != 1)
 	return luaL_error(L, "clear expects no arguments");
-    auto& game = Lua::CheckGame(L);
     CommandBindings::CheckRepository(L).Clear();
-    game.RebuildCommandIndex();
     return 0;
 }
 
 static int CommandRepositoryErase(lua_State* L) {
     if (lua_gettop(L) != 2)
 	return luaL_error(L, "erase expects 1 argument");
-    auto& game = Lua::CheckGame(L);
     CommandBindings::CheckRepository(L).Erase(Lua::CheckString(L, 2));
-    game.RebuildCommandIndex();
     return 0;
 }
 
@@ -596,11 +598,8 @@ static int CommandRepositoryLoad(lua_State* L) {
     if (lua_gettop(L) != 2)
 	return luaL_error(L, "load expects 1 argument");
     auto& lua = Lua::CheckLua(L);
-    auto& game = Lua::CheckGame(L);
     const bool ok = CommandBindings::CheckRepository(L).Load(
 	    Lua::CheckString(L, 2));
-    if (ok)
-	game.RebuildCommandIndex();
     lua.PushBool(ok);
     return 1;
 }
@@ -609,10 +608,7 @@ static int CommandRepositoryLoadIndex(lua_State* L) {
     if (lua_gettop(L) != 1)
 	return luaL_error(L, "load_index expects no arguments");
     auto& lua = Lua::CheckLua(L);
-    auto& game = Lua::CheckGame(L);
     const bool ok = CommandBindings::CheckRepository(L).LoadIndex();
-    if (ok)
-	game.RebuildCommandIndex();
     lua.PushBool(ok);
     return 1;
 }
@@ -645,8 +641,12 @@ static int CommandRepositoryStore(lua_State* L) {
     auto& game = Lua::CheckGame(L);
     auto& repo = CommandBindings::CheckRepository(L);
     auto command = CommandBindings::Check(L, 3);
+    const auto conflict = game.FindCommandConflict(*command, repo.Get(name));
+    if (!conflict.empty()) {
+	command.reset();
+	return luaL_error(L, "command index conflict on %s", conflict.c_str());
+    }
     repo.Store(name, command);
-    game.RebuildCommandIndex();
     return 0;
 }
 
@@ -778,25 +778,6 @@ static int RunSocialProxy(lua_State* L) {
     return 0;
 }
 
-//! Installs the A targets table.
-static void RegisterTargetsTable(Lua& lua) {
-    auto* L = lua.GetState();
-    lua_createtable(L, 0, 6);
-    lua_pushinteger(L, Scratch::Core::ACT_NOREPEAT);
-    lua_setfield(L, -2, "NOREPEAT");
-    lua_pushinteger(L, Scratch::Core::ACT_TOALL);
-    lua_setfield(L, -2, "TO_ALL");
-    lua_pushinteger(L, Scratch::Core::ACT_TOCHAR);
-    lua_setfield(L, -2, "TO_CHAR");
-    lua_pushinteger(L, Scratch::Core::ACT_TONOTVICT);
-    lua_setfield(L, -2, "TO_NOTVICT");
-    lua_pushinteger(L, Scratch::Core::ACT_TOROOM);
-    lua_setfield(L, -2, "TO_ROOM");
-    lua_pushinteger(L, Scratch::Core::ACT_TOVICT);
-    lua_setfield(L, -2, "TO_VICT");
-    lua.SetSafe("A");
-}
-
 //! Registers Command and Social bindings.
 //! \param lua the Lua facade
 void CommandBindings::Register(Lua& lua) {
@@ -818,7 +799,27 @@ void CommandBindings::Register(Lua& lua) {
     lua.PushFunction(RunSocialProxy);
     lua.SetSafe("run_social");
 
-    RegisterTargetsTable(lua);
+    CommandBindings::RegisterTargets(lua);
+}
+
+//! Registers the \c A action targets table.
+//! \param lua the Lua facade
+void CommandBindings::RegisterTargets(Lua& lua) {
+    auto* L = lua.GetState();
+    lua_createtable(L, 0, 6);
+    lua_pushinteger(L, Scratch::Core::ACT_NOREPEAT);
+    lua_setfield(L, -2, "NOREPEAT");
+    lua_pushinteger(L, Scratch::Core::ACT_TOALL);
+    lua_setfield(L, -2, "TO_ALL");
+    lua_pushinteger(L, Scratch::Core::ACT_TOCHAR);
+    lua_setfield(L, -2, "TO_CHAR");
+    lua_pushinteger(L, Scratch::Core::ACT_TONOTVICT);
+    lua_setfield(L, -2, "TO_NOTVICT");
+    lua_pushinteger(L, Scratch::Core::ACT_TOROOM);
+    lua_setfield(L, -2, "TO_ROOM");
+    lua_pushinteger(L, Scratch::Core::ACT_TOVICT);
+    lua_setfield(L, -2, "TO_VICT");
+    lua.SetSafe("A");
 }
 
 }; // namespace Scripting
@@ -0,0 +1,132 @@
+//! \file command_profile.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_COMMAND_PROFILE_CPP_
+
+#include <scratch/command_profile.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+
+namespace Scratch {
+namespace Core {
+
+namespace {
+
+//! Formats the median and 99th percentile bounds of a histogram.
+//! \param histogram the histogram
+//! \return \c "<p50/<p99"
+String FormatPercentiles(
+	const std::uint64_t (&histogram)[CommandProfile::Buckets]) {
+    char cell[64] = {'\0'};
+    std::snprintf(cell, sizeof(cell), "<%llu/<%llu",
+	static_cast<unsigned long long>(
+	    CommandProfile::Percentile(histogram, 50)),
+	static_cast<unsigned long long>(
+	    CommandProfile::Percentile(histogram, 99)));
+    return cell;
+}
+
+} // namespace
+
+//! Default constructor.
+CommandProfile::CommandProfile() noexcept :
+	stats_() {
+    // Nothing.
+}
+
+//! Destructor.
+CommandProfile::~CommandProfile() noexcept {
+    // Nothing.
+}
+
+//! Formats the counters as a table, one command per row.
+//! \return the table, or empty if nothing was recorded
+String CommandProfile::Format() const {
+    if (stats_.empty())
+	return String();
+
+    String out;
+    char row[MaxString] = {'\0'};
+    std::snprintf(row, sizeof(row), "%-16s %8s %10s %10s  %-13s %-13s %-13s %s\r\n",
+	"Command", "Calls", "Avg(us)", "Max(us)",
+	"Parse(us)", "Find(us)", "Execute(us)", "Output(B)");
+    out += row;
+    for (const auto& pair: stats_) {
+	const auto& stats = pair.second;
+	std::snprintf(row, sizeof(row), "%-16s %8llu %10llu %10llu  %-13s %-13s %-13s %s\r\n",
+	    pair.first.c_str(),
+	    static_cast<unsigned long long>(stats.invocations),
+	    static_cast<unsigned long long>(
+		stats.total.count() / std::max<std::uint64_t>(stats.invocations, 1)),
+	    static_cast<unsigned long long>(stats.max.count()),
+	    FormatPercentiles(stats.stages[STAGE_PARSE]).c_str(),
+	    FormatPercentiles(stats.stages[STAGE_FIND]).c_str(),
+	    FormatPercentiles(stats.stages[STAGE_EXECUTE]).c_str(),
+	    FormatPercentiles(stats.output).c_str());
+	out += row;
+    }
+    return out;
+}
+
+//! Records one invocation.
+//! \param command the command name
+//! \param sample the measurements
+//! \return the wall time of \p sample
+std::chrono::microseconds CommandProfile::Record(
+	const String& command,
+	const Sample& sample) {
+    auto& stats = stats_[command];
+    auto total = std::chrono::microseconds(0);
+    for (unsigned stage = 0; stage < MAX_STAGE; ++stage) {
+	const auto elapsed = sample.stages[stage];
+	total += elapsed;
+	++stats.stages[stage][Bucket(
+	    static_cast<std::uint64_t>(elapsed.count()))];
+    }
+    ++stats.output[Bucket(sample.outputBytes)];
+    ++stats.invocations;
+    stats.total += total;
+    stats.max = std::max(stats.max, total);
+    return total;
+}
+
+//! Returns the histogram bucket for \p value.
+//! \param value the measured value
+unsigned CommandProfile::Bucket(const std::uint64_t value) noexcept {
+    unsigned bucket = 0;
+    for (auto rest = value; rest && bucket + 1 < Buckets; rest >>= 1)
+	++bucket;
+    return bucket;
+}
+
+//! Returns the upper bound of the bucket holding a percentile.
+//! \param histogram the histogram
+//! \param percent the percentile, 1 to 100
+//! \return the exclusive upper bound, or zero if \p histogram is empty
+std::uint64_t CommandProfile::Percentile(
+	const std::uint64_t (&histogram)[Buckets],
+	const unsigned percent) noexcept {
+    std::uint64_t count = 0;
+    for (const auto n: histogram)
+	count += n;
+    if (!count)
+	return 0;
+
+    // Smallest bucket whose running count reaches the rank.
+    const auto rank = (count * percent + 99) / 100;
+    std::uint64_t seen = 0;
+    for (unsigned bucket = 0; bucket < Buckets; ++bucket) {
+	seen += histogram[bucket];
+	if (seen >= rank)
+	    return std::uint64_t(1) << bucket;
+    }
+    return std::uint64_t(1) << (Buckets - 1);
+}
+
+}; // namespace Core
+}; // namespace Scratch
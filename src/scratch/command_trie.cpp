@@ -0,0 +1,220 @@
+//! \file command_trie.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_COMMAND_TRIE_CPP_
+
+#include <scratch/command.hpp>
+#include <scratch/command_trie.hpp>
+#include <scratch/instance.hpp>
+#include <scratch/player.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+
+#include <cctype>
+
+namespace Scratch {
+namespace Core {
+
+namespace {
+
+//! Folds one character for matching.
+//! \param c the character
+char Fold(const char c) noexcept {
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+} // namespace
+
+//! Default constructor.
+CommandTrie::CommandTrie() noexcept :
+	nodes_() {
+    // Nothing.
+}
+
+//! Destructor.
+CommandTrie::~CommandTrie() noexcept {
+    // Nothing.
+}
+
+//! Rebuilds the trie.
+//! \param index the keyword command index
+void CommandTrie::Build(const StringMapCi<CommandPtr>& index) {
+    this->Clear();
+    nodes_.emplace_back();
+
+    // Insert keywords; index order breaks length ties as before.
+    for (const auto& pair: index) {
+	if (!pair.second || pair.first.empty())
+	    continue;
+	const auto entry = MakeEntry(pair.first, pair.second);
+
+	std::uint32_t node = 0;
+	for (const auto c: pair.first) {
+	    const auto folded = Fold(c);
+	    auto& children = nodes_[node].children;
+	    auto child = std::find_if(std::begin(children), std::end(children),
+		[folded](const std::pair<char, std::uint32_t>& p) {
+		    return p.first == folded;
+		});
+	    if (child != std::end(children)) {
+		node = child->second;
+	    } else {
+		const auto next = static_cast<std::uint32_t>(nodes_.size());
+		children.emplace_back(folded, next);
+		nodes_.emplace_back();
+		node = next;
+	    }
+	    nodes_[node].entries.push_back(entry);
+	}
+    }
+
+    // Shortest keyword first.
+    for (auto& node: nodes_) {
+	std::stable_sort(std::begin(node.entries), std::end(node.entries),
+	    [](const Entry& a, const Entry& b) {
+		return a.length < b.length;
+	    });
+    }
+}
+
+//! Removes every node.
+void CommandTrie::Clear() noexcept {
+    nodes_.clear();
+}
+
+//! Removes one keyword of \p command.
+//! \param keyword the keyword
+//! \param command the command indexed under \p keyword
+//! \remark Emptied nodes stay until the next #Build.
+//! \sa #Insert(const String&, const CommandPtr&)
+void CommandTrie::Erase(
+	const String& keyword,
+	const CommandPtr& command) noexcept {
+    if (keyword.empty() || nodes_.empty())
+	return;
+
+    std::uint32_t node = 0;
+    for (const auto c: keyword) {
+	const auto folded = Fold(c);
+	const auto& children = nodes_[node].children;
+	auto child = std::find_if(std::begin(children), std::end(children),
+	    [folded](const std::pair<char, std::uint32_t>& p) {
+		return p.first == folded;
+	    });
+	if (child == std::end(children))
+	    return;
+	node = child->second;
+
+	auto& entries = nodes_[node].entries;
+	entries.erase(std::remove_if(std::begin(entries), std::end(entries),
+	    [&keyword, &command](const Entry& entry) {
+		return entry.command == command &&
+		    !Scratch::Algorithm::StringCompareCi(
+			entry.keyword, keyword);
+	    }), std::end(entries));
+    }
+}
+
+//! Finds the shortest keyword \p word abbreviates that \p performer
+//! may use.
+//! \param word the typed word
+//! \param performer the performing instance
+//! \return the matched command, or \c nullptr
+CommandPtr CommandTrie::Find(
+	const String& word,
+	const InstancePtr& performer) const noexcept {
+    if (word.empty() || nodes_.empty())
+	return nullptr;
+
+    std::uint32_t node = 0;
+    for (const auto c: word) {
+	const auto folded = Fold(c);
+	const auto& children = nodes_[node].children;
+	auto child = std::find_if(std::begin(children), std::end(children),
+	    [folded](const std::pair<char, std::uint32_t>& p) {
+		return p.first == folded;
+	    });
+	if (child == std::end(children))
+	    return nullptr;
+	node = child->second;
+    }
+
+    auto player = performer ? performer->GetPlayer() : PlayerPtr();
+    const auto mask = player ? player->GetPermissionBits() : SymbolBits();
+    for (const auto& entry: nodes_[node].entries) {
+	if (entry.open || (entry.mask & mask).any())
+	    return entry.command;
+	if (entry.overflow && entry.command->Allows(performer))
+	    return entry.command;
+    }
+    return nullptr;
+}
+
+//! Adds one keyword of \p command.
+//! \param keyword the keyword
+//! \param command the command to index under \p keyword
+//! \remark Candidates keep the order #Build gives them.
+//! \sa #Erase(const String&, const CommandPtr&)
+void CommandTrie::Insert(
+	const String& keyword,
+	const CommandPtr& command) {
+    if (keyword.empty() || !command)
+	return;
+    if (nodes_.empty())
+	nodes_.emplace_back();
+    const auto entry = MakeEntry(keyword, command);
+
+    std::uint32_t node = 0;
+    for (const auto c: keyword) {
+	const auto folded = Fold(c);
+	auto& children = nodes_[node].children;
+	auto child = std::find_if(std::begin(children), std::end(children),
+	    [folded](const std::pair<char, std::uint32_t>& p) {
+		return p.first == folded;
+	    });
+	if (child != std::end(children)) {
+	    node = child->second;
+	} else {
+	    const auto next = static_cast<std::uint32_t>(nodes_.size());
+	    children.emplace_back(folded, next);
+	    nodes_.emplace_back();
+	    node = next;
+	}
+
+	// Shortest keyword first, then keyword order.
+	auto& entries = nodes_[node].entries;
+	auto at = std::find_if(std::begin(entries), std::end(entries),
+	    [&entry](const Entry& other) {
+		return other.length > entry.length ||
+		    (other.length == entry.length &&
+		     Scratch::Algorithm::StringCompareCi(
+			 entry.keyword, other.keyword) < 0);
+	    });
+	entries.insert(at, entry);
+    }
+}
+
+//! Makes the candidate for one keyword of \p command.
+//! \param keyword the keyword
+//! \param command the command
+CommandTrie::Entry CommandTrie::MakeEntry(
+	const String& keyword,
+	const CommandPtr& command) {
+    Entry entry;
+    entry.command = command;
+    entry.keyword = keyword;
+    entry.length = keyword.size();
+    entry.mask = command->GetPermissionBits();
+    const auto permissions = command->GetPermissions().size();
+    entry.open = permissions == 0;
+    entry.overflow = entry.mask.count() != permissions;
+    return entry;
+}
+
+}; // namespace Core
+}; // namespace Scratch
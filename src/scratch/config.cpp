@@ -27,8 +27,18 @@ static const char configFileName[] = "data/config.dat";
 Config::Config() noexcept :
 	address_(),
 	bootstrapState_("Login"),
+	connectBurst_(5),
+	connectLimit_(8),
+	connectRate_(30.0),
+	gateway_(),
 	metaColors_(),
-	port_(6767) {
+	port_(6767),
+	pulseRate_(10),
+	pulseShards_(1),
+	pulseThreads_(0),
+	slowCommand_(100),
+	tcpCork_(true),
+	webSocketPort_(0) {
     // Nothing.
 }
 
@@ -63,28 +73,98 @@ bool Config::Load() noexcept {
     if (!game)
 	return false;
     for (const auto& entry: game->GetEntries()) {
-	if (!KeyIs(entry.first, "BootstrapState"))
+	if (!KeyIs(entry.first, "BootstrapState") &&
+		!KeyIs(entry.first, "PulseRate") &&
+		!KeyIs(entry.first, "PulseShards") &&
+		!KeyIs(entry.first, "PulseThreads") &&
+		!KeyIs(entry.first, "SlowCommand"))
 	    return false;
     }
     const auto bootstrapState = game->GetString("BootstrapState");
     if (bootstrapState.empty())
 	return false;
+    auto pulseRate = pulseRate_;
+    if (game->Get("PulseRate")) {
+	const auto value = game->GetNumber("PulseRate");
+	if (value < 1.0 || value > 1000.0)
+	    return false;
+	pulseRate = static_cast<unsigned>(value);
+    }
+    auto pulseShards = pulseShards_;
+    if (game->Get("PulseShards")) {
+	const auto value = game->GetNumber("PulseShards");
+	if (value < 1.0 || value > 256.0)
+	    return false;
+	pulseShards = static_cast<unsigned>(value);
+    }
+    auto pulseThreads = pulseThreads_;
+    if (game->Get("PulseThreads")) {
+	const auto value = game->GetNumber("PulseThreads");
+	if (value < 0.0 || value > 64.0)
+	    return false;
+	pulseThreads = static_cast<unsigned>(value);
+    }
+    auto slowCommand = slowCommand_;
+    if (game->Get("SlowCommand")) {
+	const auto value = game->GetNumber("SlowCommand");
+	if (value < 0.0 || value > 60000.0)
+	    return false;
+	slowCommand = static_cast<unsigned>(value);
+    }
 
     String address;
+    auto connectBurst = connectBurst_;
+    auto connectLimit = connectLimit_;
+    auto connectRate = connectRate_;
+    String gateway;
     auto port = port_;
+    auto tcpCork = tcpCork_;
+    auto webSocketPort = webSocketPort_;
     if (auto network = root->Get("Network")) {
 	for (const auto& entry: network->GetEntries()) {
 	    if (!KeyIs(entry.first, "Address") &&
-		    !KeyIs(entry.first, "Port"))
+		    !KeyIs(entry.first, "ConnectBurst") &&
+		    !KeyIs(entry.first, "ConnectLimit") &&
+		    !KeyIs(entry.first, "ConnectRate") &&
+		    !KeyIs(entry.first, "Gateway") &&
+		    !KeyIs(entry.first, "Port") &&
+		    !KeyIs(entry.first, "TcpCork") &&
+		    !KeyIs(entry.first, "WebSocketPort"))
 		return false;
 	}
 	address = network->GetString("Address");
+	if (network->Get("ConnectBurst")) {
+	    const auto value = network->GetNumber("ConnectBurst");
+	    if (value < 1.0 || value > 1000.0)
+		return false;
+	    connectBurst = static_cast<unsigned>(value);
+	}
+	if (network->Get("ConnectLimit")) {
+	    const auto value = network->GetNumber("ConnectLimit");
+	    if (value < 0.0 || value > 65535.0)
+		return false;
+	    connectLimit = static_cast<unsigned>(value);
+	}
+	if (network->Get("ConnectRate")) {
+	    const auto value = network->GetNumber("ConnectRate");
+	    if (value <= 0.0 || value > 60000.0)
+		return false;
+	    connectRate = value;
+	}
+	gateway = network->GetString("Gateway");
 	if (network->Get("Port")) {
 	    const auto value = network->GetNumber("Port");
 	    if (value < 1.0 || value > 65535.0)
 		return false;
 	    port = static_cast<std::uint16_t>(value);
 	}
+	tcpCork = network->GetYesNo("TcpCork", tcpCork);
+	if (network->Get("WebSocketPort")) {
+	    const auto value = network->GetNumber("WebSocketPort");
+	    if (value < 0.0 || value > 65535.0)
+		return false;
+	    webSocketPort = static_cast<std::uint16_t>(value);
+	}
     }
 
     std::map<Color::ColorEnum, Color::ColorEnum> metaColors;
@@ -101,8 +181,18 @@ bool Config::Load() noexcept {
 
     address_ = std::move(address);
     bootstrapState_ = bootstrapState;
+    connectBurst_ = connectBurst;
+    connectLimit_ = connectLimit;
+    connectRate_ = connectRate;
+    gateway_ = std::move(gateway);
     metaColors_ = std::move(metaColors);
     port_ = port;
+    pulseRate_ = pulseRate;
+    pulseShards_ = pulseShards;
+    pulseThreads_ = pulseThreads;
+    slowCommand_ = slowCommand;
+    tcpCork_ = tcpCork;
+    webSocketPort_ = webSocketPort;
     return true;
 }
 
@@ -126,13 +216,25 @@ bool Config::Save() const noexcept {
     if (!game)
 	return false;
     game->PutString("BootstrapState", bootstrapState_);
+    game->PutNumber("PulseRate", static_cast<double>(pulseRate_));
+    game->PutNumber("PulseShards", static_cast<double>(pulseShards_));
+    game->PutNumber("PulseThreads", static_cast<double>(pulseThreads_));
+    game->PutNumber("SlowCommand", static_cast<double>(slowCommand_));
 
     auto network = root->Put("Network");
     if (!network)
 	return false;
     if (!address_.empty())
 	network->PutString("Address", address_);
+    network->PutNumber("ConnectBurst", static_cast<double>(connectBurst_));
+    network->PutNumber("ConnectLimit", static_cast<double>(connectLimit_));
+    network->PutNumber("ConnectRate", connectRate_);
+    if (!gateway_.empty())
+	network->PutString("Gateway", gateway_);
     network->PutNumber("Port", static_cast<double>(port_));
+    network->PutYesNo("TcpCork", tcpCork_);
+    if (webSocketPort_)
+	network->PutNumber("WebSocketPort", static_cast<double>(webSocketPort_));
 
     return root->SaveFile(configFileName);
 }
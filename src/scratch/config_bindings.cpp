@@ -66,6 +66,54 @@ static int ConfigGetBootstrapState(lua_State* L) {
     return 1;
 }
 
+//! Handles Config:get_connect_burst().
+static int ConfigGetConnectBurst(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_connect_burst expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    const auto connectBurst = config->GetConnectBurst();
+    config.reset();
+    lua.PushInt(static_cast<lua_Integer>(connectBurst));
+    return 1;
+}
+
+//! Handles Config:get_connect_limit().
+static int ConfigGetConnectLimit(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_connect_limit expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    const auto connectLimit = config->GetConnectLimit();
+    config.reset();
+    lua.PushInt(static_cast<lua_Integer>(connectLimit));
+    return 1;
+}
+
+//! Handles Config:get_connect_rate().
+static int ConfigGetConnectRate(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_connect_rate expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    const auto connectRate = config->GetConnectRate();
+    config.reset();
+    lua.PushNumber(connectRate);
+    return 1;
+}
+
+//! Handles Config:get_gateway().
+static int ConfigGetGateway(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_gateway expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    auto gateway = config->GetGateway();
+    config.reset();
+    lua.PushString(std::move(gateway));
+    return 1;
+}
+
 //! Handles Config:get_metacolor(name).
 static int ConfigGetMetaColor(lua_State* L) {
     if (lua_gettop(L) != 2)
@@ -123,6 +171,78 @@ static int ConfigGetPort(lua_State* L) {
     return 1;
 }
 
+//! Handles Config:get_pulse_rate().
+static int ConfigGetPulseRate(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_pulse_rate expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    const auto pulseRate = config->GetPulseRate();
+    config.reset();
+    lua.PushInt(static_cast<lua_Integer>(pulseRate));
+    return 1;
+}
+
+//! Handles Config:get_pulse_shards().
+static int ConfigGetPulseShards(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_pulse_shards expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    const auto pulseShards = config->GetPulseShards();
+    config.reset();
+    lua.PushInt(static_cast<lua_Integer>(pulseShards));
+    return 1;
+}
+
+//! Handles Config:get_pulse_threads().
+static int ConfigGetPulseThreads(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_pulse_threads expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    const auto pulseThreads = config->GetPulseThreads();
+    config.reset();
+    lua.PushInt(static_cast<lua_Integer>(pulseThreads));
+    return 1;
+}
+
+//! Handles Config:get_slow_command().
+static int ConfigGetSlowCommand(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_slow_command expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    const auto slowCommand = config->GetSlowCommand();
+    config.reset();
+    lua.PushInt(static_cast<lua_Integer>(slowCommand));
+    return 1;
+}
+
+//! Handles Config:get_tcp_cork().
+static int ConfigGetTcpCork(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_tcp_cork expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    const auto tcpCork = config->GetTcpCork();
+    config.reset();
+    lua.PushBool(tcpCork);
+    return 1;
+}
+
+//! Handles Config:get_websocket_port().
+static int ConfigGetWebSocketPort(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "get_websocket_port expects no arguments");
+    auto& lua = Lua::CheckLua(L);
+    auto config = ConfigBindings::Check(L, 1);
+    const auto webSocketPort = config->GetWebSocketPort();
+    config.reset();
+    lua.PushInt(static_cast<lua_Integer>(webSocketPort));
+    return 1;
+}
+
 //! Resolves a Config userdata at \p index.
 //! \param L the \c lua_State
 //! \param index the stack index of the userdata
@@ -157,9 +277,19 @@ void ConfigBindings::Register(Lua& lua) {
 	{"__gc", ConfigGc},
 	{"get_address", ConfigGetAddress},
 	{"get_bootstrap_state", ConfigGetBootstrapState},
+	{"get_connect_burst", ConfigGetConnectBurst},
+	{"get_connect_limit", ConfigGetConnectLimit},
+	{"get_connect_rate", ConfigGetConnectRate},
+	{"get_gateway", ConfigGetGateway},
 	{"get_metacolor", ConfigGetMetaColor},
 	{"get_metacolors", ConfigGetMetaColors},
 	{"get_port", ConfigGetPort},
+	{"get_pulse_rate", ConfigGetPulseRate},
+	{"get_pulse_shards", ConfigGetPulseShards},
+	{"get_pulse_threads", ConfigGetPulseThreads},
+	{"get_slow_command", ConfigGetSlowCommand},
+	{"get_tcp_cork", ConfigGetTcpCork},
+	{"get_websocket_port", ConfigGetWebSocketPort},
 	{nullptr, nullptr}
     };
     luaL_setfuncs(L, methods, 0);
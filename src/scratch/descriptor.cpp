@@ -8,10 +8,12 @@
 
 #define _SCRATCH_DESCRIPTOR_CPP_
 
+#include <scratch/audience.hpp>
 #include <scratch/color.hpp>
 #include <scratch/color_bindings.hpp>
 #include <scratch/command.hpp>
 #include <scratch/config.hpp>
+#include <scratch/data.hpp>
 #include <scratch/descriptor.hpp>
 #include <scratch/descriptor_bindings.hpp>
 #include <scratch/editor.hpp>
@@ -22,10 +24,12 @@
 #include <scratch/menu.hpp>
 #include <scratch/player.hpp>
 #include <scratch/protocol_telnet.hpp>
+#include <scratch/protocol_websocket.hpp>
 #include <scratch/scratch.hpp>
 #include <scratch/state.hpp>
 #include <scratch/storage_file_multi.hpp>
 #include <scratch/string.hpp>
+#include <scratch/transport_tcp.hpp>
 #include <scratch/user.hpp>
 
 namespace Scratch {
@@ -33,14 +37,37 @@ namespace Net {
 
 // ScratchMUD types.
 using Color = Scratch::Net::Color;
+using Data = Scratch::Utility::Data;
 
 //! Constructor.
 //! \param game the game state
 //! \param socket the Boost socket
+//! \param protocolType the wire protocol
+//! \sa #Descriptor(Game&, std::unique_ptr<Transport>&&, const ProtocolType)
 Descriptor::Descriptor(
 	Game& game,
-	Socket&& socket) :
+	Socket&& socket,
+	const ProtocolType protocolType) :
+	Descriptor(game, std::make_unique<TcpTransport>(std::move(socket)),
+	    protocolType) {
+    // Nothing.
+}
+
+//! Constructor.
+//! \param game the game state
+//! \param transport the wire transport
+//! \param protocolType the wire protocol
+Descriptor::Descriptor(
+	Game& game,
+	std::unique_ptr<Transport>&& transport,
+	const ProtocolType protocolType) :
+	address_(),
 	colorBit_(true),
+	commandCount_(0),
+	commandPending_(false),
+	commandStarted_(),
+	commandWrites_(0),
+	corked_(false),
 	editCommand_(),
 	editEnumeration_(),
 	editName_(),
@@ -49,17 +76,33 @@ Descriptor::Descriptor(
 	editString_(),
 	editUser_(),
 	game_(game),
+	idleTimer_(),
 	input_(),
+	inputLines_(0),
+	inputPackets_(0),
 	lineInput_(),
 	editor_(),
+	loginTimer_(),
 	menu_(),
 	name_(),
 	output_(),
+	outputBytes_(0),
+	outputClass_(OUT_REPLY),
+	outputDrops_(),
+	outputSkipped_(0),
+	outputStallSince_(0),
 	promptBit_(true),
+	promptLatencyMax_(0),
+	promptLatencyTotal_(0),
+	promptQueued_(false),
 	protocol_(),
-	socket_(std::move(socket)),
+	protocolType_(protocolType),
 	state_(),
+	stateIndexed_(nullptr),
+	stateNext_(nullptr),
+	statePrev_(nullptr),
 	stateStack_(),
+	transport_(std::move(transport)),
 	terminalType_(),
 	instance_(),
 	user_(),
@@ -67,8 +110,14 @@ Descriptor::Descriptor(
 	windowWidth_(80),
 	writeFlushPosted_(false),
 	writePending_(false) {
-    // Default to TELNET.
-    protocol_ = std::make_unique<TelnetProtocol>(*this);
+    // Capture remote address.
+    address_ = transport_->GetAddress();
+
+    // Create protocol.
+    if (protocolType_ == PROTOCOL_WEBSOCKET)
+	protocol_ = std::make_unique<WebSocketProtocol>(*this);
+    else
+	protocol_ = std::make_unique<TelnetProtocol>(*this);
 }
 
 //! Destructor.
@@ -113,11 +162,37 @@ void Descriptor::ClearMenu() noexcept {
 //! \sa #Closed() const
 //! \sa #Login(const UserPtr&)
 void Descriptor::Close() noexcept {
-    if (!socket_.is_open())
+    if (!transport_->IsOpen())
 	return;
 
     LOGGER_NETWORK() << "Descriptor " << name_ << " disconnected.";
 
+    idleTimer_.Cancel();
+    loginTimer_.Cancel();
+
+    // Log backpressure drops.
+    if (outputDrops_[OUT_ACTION] || outputDrops_[OUT_BROADCAST] ||
+	outputDrops_[OUT_PROMPT] || outputDrops_[OUT_REPLY]) {
+	LOGGER_NETWORK() << "Descriptor " << name_ << " dropped"
+	    << " prompt=" << outputDrops_[OUT_PROMPT]
+	    << " reply=" << outputDrops_[OUT_REPLY]
+	    << " action=" << outputDrops_[OUT_ACTION]
+	    << " broadcast=" << outputDrops_[OUT_BROADCAST] << ".";
+    }
+
+    // Log prompt-boundary flushing.
+    if (commandCount_) {
+	LOGGER_NETWORK() << "Descriptor " << name_
+	    << " commands=" << commandCount_
+	    << " writes/command=" << static_cast<double>(commandWrites_) / commandCount_
+	    << " prompt latency avg=" << promptLatencyTotal_.count() / commandCount_
+	    << "us max=" << promptLatencyMax_.count() << "us.";
+    }
+
+    // Fold packets per command into the terminal type's totals.
+    if (inputLines_)
+	game_.RecordTerminalStats(terminalType_, inputPackets_, inputLines_);
+
     this->ClearEditor();
 
     this->SetCharacter(nullptr);
@@ -135,12 +210,12 @@ void Descriptor::Close() noexcept {
     editString_.clear();
     editUser_.reset();
     stateStack_.clear();
-    state_.reset();
+    this->UpdateState(nullptr);
 
-    // Close Boost socket. Outstanding async ops are cancelled and their
+    // Close transport. Outstanding async ops are cancelled and their
     // completion handlers are queued on IO context before close returns.
     ErrorCode errorCode;
-    socket_.close(errorCode);
+    transport_->Close(errorCode);
 
     // Log failures.
     if (errorCode) {
@@ -159,7 +234,7 @@ void Descriptor::Close() noexcept {
 //! Returns whether the descriptor is closed.
 //! \sa #Close()
 bool Descriptor::Closed() const noexcept {
-    return !socket_.is_open();
+    return !transport_->IsOpen();
 }
 
 //! Returns whether the editor is intercepting input.
@@ -261,6 +336,44 @@ void Descriptor::DeliverByte(const std::uint8_t byteReceived) {
     }
 }
 
+//! Delivers a run of application-data bytes from the protocol.
+//! \param bytesReceived the bytes to deliver
+//! \param nBytes the number of bytes to deliver
+//! \remark Whole printable lines skip the line buffer; anything else
+//!     falls back to #DeliverByte(const std::uint8_t).
+void Descriptor::DeliverBytes(
+	const std::uint8_t* bytesReceived,
+	const std::size_t nBytes) {
+    std::size_t n = 0;
+    while (n < nBytes && !this->Closed()) {
+	const auto* begin = bytesReceived + n;
+	const auto* newline = static_cast<const std::uint8_t*>(
+	    std::memchr(begin, '\n', nBytes - n));
+	const auto lineN = newline ?
+	    static_cast<std::size_t>(newline - begin) + 1 : nBytes - n;
+
+	// Fast path. A clean CR LF line with nothing buffered.
+	if (newline && lineInput_.tellp() <= 0) {
+	    auto textN = lineN - 1;
+	    if (textN && begin[textN - 1] == '\r')
+		--textN;
+	    const bool clean = textN <= MaxInput &&
+		std::all_of(begin, begin + textN,
+		    [](const std::uint8_t ch) { return std::isprint(ch); });
+	    if (clean) {
+		n += lineN;
+		this->ReceiveLine(String(reinterpret_cast<const char*>(begin), textN));
+		continue;
+	    }
+	}
+
+	// Fallback. Edit characters, partial lines, and overlong input.
+	for (std::size_t lineByteN = 0; lineByteN < lineN && !this->Closed(); ++lineByteN)
+	    this->DeliverByte(begin[lineByteN]);
+	n += lineN;
+    }
+}
+
 //! Logs in the specified user, setting LastLogin and persisting.
 //! \param user the user to log in
 //! \sa #Close()
@@ -278,6 +391,7 @@ void Descriptor::Login(const UserPtr& user) noexcept {
 	    game_.GetUsers()->Save(user_->GetName());
 	}
 
+	loginTimer_.Cancel();
 	user_ = user;
 	user_->SetLastLogin(std::time(nullptr));
 	game_.GetUsers()->Save(user_->GetName());
@@ -315,6 +429,8 @@ void Descriptor::SetCharacter(const InstancePtr& instance) noexcept {
 	    if (players)
 		players->Save(player->GetName());
 	}
+	if (instance_->GetAudience())
+	    instance_->GetAudience()->Erase(instance_);
 	instance_->SetDescriptor(nullptr);
 	instance_.reset();
     }
@@ -341,23 +457,27 @@ void Descriptor::SetCharacter(const InstancePtr& instance) noexcept {
 
     instance_ = instance;
     instance->SetDescriptor(this->shared_from_this());
+    game_.GetAudience().Insert(instance);
 }
 
 //! Writes to the descriptor.
 //! \param message the message to print
-void Descriptor::Print(const String& message) noexcept {
+//! \param outputClass the output priority class
+void Descriptor::Print(
+	const String& message,
+	const OutputClass outputClass) noexcept {
     if (this->Closed())
 	return;
 
     this->EndLine();
-    this->Write(message);
+    this->Write(message, outputClass);
     if (!message.empty())
 	promptBit_ = message.back() == '\n';
 }
 
 //! Writes cells in a column-major fold.
 //! \param cells the pre-rendered cell strings
-//! \sa #Print(const String&)
+//! \sa #Print(const String&, const OutputClass)
 //! \sa #GetWindowWidth() const
 void Descriptor::PrintColumns(const std::vector<String>& cells) noexcept {
     if (this->Closed() || cells.empty())
@@ -462,6 +582,16 @@ void Descriptor::SetPromptBit(const bool promptBit) noexcept {
     }));
 }
 
+//! Sends a GMCP message out of band.
+//! \param package the GMCP package and message name
+//! \param json the JSON payload, or empty
+//! \return \c true if the protocol carried the message
+bool Descriptor::SendGmcp(const String& package, const String& json) {
+    if (this->Closed())
+	return false;
+    return protocol_->SendGmcp(package, json);
+}
+
 //! Enables or disables Quiet (server echo / hidden client local echo).
 //! \param quiet whether Quiet is enabled
 void Descriptor::SetQuiet(bool quiet) {
@@ -485,7 +615,7 @@ void Descriptor::PopState() {
 	return;
 
     stateStack_.pop_front();
-    state_ = stateStack_.empty() ? StatePtr() : stateStack_.front();
+    this->UpdateState(stateStack_.empty() ? StatePtr() : stateStack_.front());
     this->ClearEditor();
     this->ClearMenu();
 
@@ -548,7 +678,7 @@ void Descriptor::PopStateUntil(const StatePtr& target) {
 	if (state_ != leaving)
 	    return;
 	stateStack_.pop_front();
-	state_ = stateStack_.empty() ? StatePtr() : stateStack_.front();
+	this->UpdateState(stateStack_.empty() ? StatePtr() : stateStack_.front());
     }
 
     if (stateStack_.empty()) {
@@ -622,7 +752,7 @@ void Descriptor::PushState(const StatePtr& state) {
     }
 
     stateStack_.push_front(next);
-    state_ = next;
+    this->UpdateState(next);
     this->ClearEditor();
     this->ClearMenu();
     this->RunStateHook(next->GetFocus(), "Focus");
@@ -695,7 +825,7 @@ void Descriptor::SetState(const StatePtr& state) {
 	if (state_ != leaving)
 	    return;
 	stateStack_.pop_front();
-	state_ = stateStack_.empty() ? StatePtr() : stateStack_.front();
+	this->UpdateState(stateStack_.empty() ? StatePtr() : stateStack_.front());
     }
 
     if (!next) {
@@ -707,7 +837,7 @@ void Descriptor::SetState(const StatePtr& state) {
     }
 
     stateStack_.push_front(next);
-    state_ = next;
+    this->UpdateState(next);
     this->ClearEditor();
     this->ClearMenu();
     this->RunStateHook(next->GetFocus(), "Focus");
@@ -735,8 +865,104 @@ void Descriptor::SetStateByName(const String& stateName) {
     }
 }
 
+//! Restores a handed-off session and begins asynchronous I/O.
+//! \param data the handoff record
+//! \remark Replaces #Start() after a hot reboot. The state stack is
+//!     restored without running Focus hooks.
+//! \sa #SaveHandoff(const DataPtr&)
+void Descriptor::Resume(const DataPtr& data) {
+    // Restore terminal.
+    colorBit_ = data->GetYesNo("Color", colorBit_);
+    terminalType_ = data->GetString("TerminalType");
+    windowHeight_ = static_cast<std::uint16_t>(
+	data->GetNumber("WindowHeight", windowHeight_));
+    windowWidth_ = static_cast<std::uint16_t>(
+	data->GetNumber("WindowWidth", windowWidth_));
+    if (auto protocolData = data->Get("Protocol"))
+	protocol_->LoadHandoff(protocolData);
+
+    // Restore account without a fresh login edge.
+    const auto userName = data->GetString("User");
+    if (!userName.empty())
+	user_ = game_.GetUsers()->Get(userName);
+    if (!user_)
+	this->InitLoginTimer();
+    this->InitIdleTimer();
+
+    // Restore character.
+    const auto playerName = data->GetString("Character");
+    if (user_ && !playerName.empty())
+	this->CreateCharacter(game_.GetPlayers()->Get(playerName));
+
+    // Restore state stack, bottom first.
+    if (user_) {
+	if (auto statesData = data->Get("States")) {
+	    for (const auto& entry: statesData->GetEntries()) {
+		if (auto state = game_.GetStates()->Get(
+			statesData->GetString(entry.first)))
+		    stateStack_.push_front(state);
+	    }
+	}
+    }
+
+    this->InitAsyncRead();
+    if (stateStack_.empty()) {
+	// Restart anonymous sessions at the bootstrap state.
+	this->SetState(game_.GetStates()->Get(
+	    game_.GetConfig()->GetBootstrapState()));
+	this->Write("");
+	return;
+    }
+    this->UpdateState(stateStack_.front());
+    this->SetQuiet(state_->GetQuietBit());
+    this->Write("Reboot complete.\r\n");
+}
+
+//! Records the session for a hot reboot.
+//! \param data the handoff record
+//! \return \c false if the transport cannot be handed off
+//! \sa #Resume(const DataPtr&)
+bool Descriptor::SaveHandoff(const DataPtr& data) {
+    const auto handle = transport_->GetNativeHandle();
+    if (handle < 0)
+	return false;
+    data->PutNumber("Socket", handle);
+    data->PutYesNo("V6", address_.is_v6());
+    if (protocolType_ == PROTOCOL_WEBSOCKET)
+	data->PutYesNo("WebSocket", true);
+
+    // Write terminal.
+    data->PutYesNo("Color", colorBit_);
+    if (!terminalType_.empty())
+	data->PutString("TerminalType", terminalType_);
+    data->PutNumber("WindowHeight", windowHeight_);
+    data->PutNumber("WindowWidth", windowWidth_);
+    auto protocolData = std::make_shared<Data>();
+    protocol_->SaveHandoff(protocolData);
+    if (protocolData->Size())
+	data->Put("Protocol", protocolData);
+
+    // Write account and character.
+    if (user_)
+	data->PutString("User", user_->GetName());
+    if (instance_ && instance_->GetPlayer())
+	data->PutString("Character", instance_->GetPlayer()->GetName());
+
+    // Write state stack, bottom first.
+    auto statesData = std::make_shared<Data>();
+    for (auto it = stateStack_.rbegin(); it != stateStack_.rend(); ++it)
+	statesData->PutString("%", (*it)->GetName());
+    if (statesData->Size())
+	data->Put("States", statesData);
+    return true;
+}
+
 //! Begins asynchronous I/O after the descriptor is indexed by the game.
 void Descriptor::Start() {
+    transport_->OnStart();
+    this->InitLoginTimer();
+    this->InitIdleTimer();
+
     protocol_->OnStart();
     this->SetState(game_.GetStates()->Get(
 	game_.GetConfig()->GetBootstrapState()));
@@ -746,10 +972,17 @@ void Descriptor::Start() {
 
 //! Writes application output through the protocol.
 //! \param message the message to write
-void Descriptor::Write(const String& message) {
+//! \param outputClass the output priority class
+void Descriptor::Write(
+	const String& message,
+	const OutputClass outputClass) {
     if (this->Closed())
 	return;
+
+    // Tag the raw writes the protocol makes for this message.
+    outputClass_ = outputClass;
     protocol_->Send(message);
+    outputClass_ = OUT_REPLY;
 }
 
 //! Writes the prompt.
@@ -768,12 +1001,12 @@ void Descriptor::WritePrompt() {
     std::snprintf(message, sizeof(message), "%s:ScratchMUD:> %s",
 	this->GetColor(Color::C_PROMPT),
 	this->GetColor(Color::C_NORMAL));
-    this->Write(message);
+    this->Write(message, OUT_PROMPT);
 
     // Restore interrupted input.
     const auto pendingInput = lineInput_.str();
     if (!pendingInput.empty())
-	this->Write(pendingInput);
+	this->Write(pendingInput, OUT_PROMPT);
 
     promptBit_ = false;
     protocol_->OnPrompt();
@@ -781,33 +1014,66 @@ void Descriptor::WritePrompt() {
 
 //! Writes raw bytes to the wire.
 //! \param message the message to write
+//! \remark Tagged with the output class of the enclosing #Write.
+//!     Over \c MaxOutput, prompts, actions, and broadcasts are dropped;
+//!     over \c MaxOutputHard, or over \c MaxOutput for longer than
+//!     \c MaxOutputStall seconds, the descriptor is closed.
 void Descriptor::WriteRaw(const String& message) {
     if (this->Closed()) {
 	LOGGER_ASSERT() << "Descriptor " << name_ << " already closed.";
 	return;
     }
+    outputBytes_ += message.size();
 
     // Post onto the IO context so buffer mutations stay single-threaded.
     // std::function type-erases the handler so shared_ptr captures do not
     // trip -Werror=inline inside Boost.Asio templates.
     const auto self = this->shared_from_this();
-    boost::asio::post(game_.GetIoContext(), std::function<void()>([self, message]() {
+    const auto outputClass = outputClass_;
+    boost::asio::post(game_.GetIoContext(), std::function<void()>([self, message, outputClass]() {
 	if (self->Closed() || self->game_.GetShutdown())
 	    return;
 
 	// Cap pending wire bytes. Try a flush if idle; if still no room,
-	// drop the connection with an overflow error.
+	// apply backpressure by output class.
 	if (self->output_.size() + message.size() > MaxOutput) {
 	    if (!self->writePending_ && self->output_.size())
 		self->InitAsyncWrite();
 	    if (self->output_.size() + message.size() > MaxOutput) {
-		LOGGER_NETWORK() << "Descriptor " << self->name_ << " output exceeded " << MaxOutput << " bytes; closing.";
-		self->Close();
+		const auto now = std::time(nullptr);
+		if (!self->outputStallSince_)
+		    self->outputStallSince_ = now;
+
+		// Sustained or hard overflow drops the connection.
+		if (self->output_.size() + message.size() > MaxOutputHard ||
+		    now - self->outputStallSince_ > MaxOutputStall) {
+		    ++self->outputDrops_[outputClass];
+		    LOGGER_NETWORK() << "Descriptor " << self->name_ << " output exceeded " << MaxOutput << " bytes for " << (now - self->outputStallSince_) << " seconds; closing.";
+		    self->Close();
+		    return;
+		}
+
+		// Prompts are redrawn once output drains.
+		if (outputClass == OUT_PROMPT) {
+		    ++self->outputDrops_[outputClass];
+		    self->promptBit_ = true;
+		    return;
+		}
+
+		// Actions and broadcasts collapse into one marker.
+		if (outputClass != OUT_REPLY) {
+		    ++self->outputDrops_[outputClass];
+		    ++self->outputSkipped_;
+		    return;
+		}
 	    }
 	}
 
-	if (!self->Closed() && !message.empty())
+	if (!self->Closed() && !message.empty()) {
 	    self->output_.sputn(message.data(), static_cast<std::streamsize>(message.size()));
+	    if (outputClass == OUT_PROMPT)
+		self->promptQueued_ = true;
+	}
 
 	// Coalesce queued WriteRaw posts before async_write.
 	// Must not mutate streambuf during in-flight write.
@@ -824,6 +1090,48 @@ void Descriptor::WriteRaw(const String& message) {
     }));
 }
 
+//! Corks the socket while a command's output is produced.
+//! \sa #EndCommand()
+void Descriptor::BeginCommand() noexcept {
+    commandPending_ = true;
+    commandStarted_ = std::chrono::steady_clock::now();
+    promptQueued_ = false;
+    this->SetCork(true);
+}
+
+//! Uncorks the socket and records prompt latency.
+//! \remark Called once the prompt has been handed to the socket.
+//! \sa #BeginCommand()
+void Descriptor::EndCommand() noexcept {
+    if (!commandPending_)
+	return;
+
+    this->SetCork(false);
+
+    const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+	std::chrono::steady_clock::now() - commandStarted_);
+    promptLatencyMax_ = std::max(promptLatencyMax_, latency);
+    promptLatencyTotal_ += latency;
+    ++commandCount_;
+    commandPending_ = false;
+    promptQueued_ = false;
+}
+
+//! Ends the command once its handler has run, if it wrote nothing.
+//! \remark Posted behind any prompt the handler asked for, so a
+//!     prompt or reply reaches the output buffer first and is left to
+//!     the write completion.
+//! \sa #EndCommand()
+void Descriptor::EndCommandIfIdle() {
+    const auto self = this->shared_from_this();
+    boost::asio::post(game_.GetIoContext(), std::function<void()>([self]() {
+	if (self->Closed() || !self->commandPending_ || self->writePending_ ||
+	    self->writeFlushPosted_ || self->output_.size())
+	    return;
+	self->EndCommand();
+    }));
+}
+
 //! Ends the current line if needed.
 void Descriptor::EndLine() {
     if (promptBit_)
@@ -836,8 +1144,8 @@ void Descriptor::EndLine() {
 void Descriptor::InitAsyncRead() {
     MutableBuffersType mutableInput = input_.prepare(MaxString);
     const auto self = this->shared_from_this();
-    socket_.async_read_some(boost::asio::buffer(mutableInput),
-	std::function<void(const ErrorCode&, std::size_t)>(
+    transport_->AsyncRead(boost::asio::buffer(mutableInput),
+	Transport::Handler(
 	[self](const ErrorCode& errorCode, std::size_t nBytes) {
 	    if (errorCode.value() == boost::asio::error::eof) {
 		self->Close();
@@ -852,14 +1160,14 @@ void Descriptor::InitAsyncRead() {
 	    } else {
 		// Commit bytes.
 		self->input_.commit(nBytes);
-
-		// Read bytes from input buffer.
-		std::istream input(&self->input_);
-		while (!self->game_.GetShutdown() && input) {
-		    const int byteReceived = input.get();
-		    if (byteReceived == std::char_traits<char>::eof())
-			break;
-		    self->protocol_->Receive(static_cast<std::uint8_t>(byteReceived));
+		++self->inputPackets_;
+
+		// Hand the whole read to the protocol.
+		if (!self->game_.GetShutdown()) {
+		    const auto input = self->input_.data();
+		    self->protocol_->ReceiveBytes(
+			static_cast<const std::uint8_t*>(input.data()),
+			input.size());
 		}
 
 		// Advance stream buffer.
@@ -878,10 +1186,12 @@ void Descriptor::InitAsyncWrite() {
 	return;
 
     writePending_ = true;
+    if (commandPending_)
+	++commandWrites_;
     const auto self = this->shared_from_this();
-    boost::asio::async_write(socket_, output_.data(),
-	std::function<void(ErrorCode, std::size_t)>(
-	[self](ErrorCode errorCode, std::size_t nBytes) {
+    transport_->AsyncWrite(output_.data(),
+	Transport::Handler(
+	[self](const ErrorCode& errorCode, std::size_t nBytes) {
 	    self->writePending_ = false;
 
 	    if (errorCode) {
@@ -898,6 +1208,21 @@ void Descriptor::InitAsyncWrite() {
 	    // Advance the output buffer past bytes written.
 	    self->output_.consume(nBytes);
 
+	    // Release backpressure once half the soft cap has drained.
+	    if (self->outputStallSince_ && self->output_.size() <= MaxOutput / 2) {
+		self->outputStallSince_ = 0;
+		self->WriteSkipped();
+	    }
+
+	    // Uncork at the prompt boundary, or once no prompt will follow.
+	    if (self->commandPending_ && !self->output_.size()) {
+		const bool wantsPrompt = self->promptBit_ &&
+		    (self->IsEditorActive() ||
+		    (self->state_ && self->state_->GetPromptBit()));
+		if (self->promptQueued_ || !wantsPrompt)
+		    self->EndCommand();
+	    }
+
 	    // Continue draining, or show the prompt.
 	    if (!self->game_.GetShutdown() && !self->Closed() && self->output_.size())
 		self->InitAsyncWrite();
@@ -910,6 +1235,31 @@ void Descriptor::InitAsyncWrite() {
 	}));
 }
 
+//! Arms the idle disconnect timer.
+void Descriptor::InitIdleTimer() {
+    const std::weak_ptr<Descriptor> weak = this->shared_from_this();
+    game_.GetTimers().Arm(idleTimer_, std::chrono::seconds(MaxIdle), [weak]() {
+	auto self = weak.lock();
+	if (!self || self->Closed())
+	    return;
+	LOGGER_NETWORK() << "Descriptor " << self->name_ << " idle for " << MaxIdle << " seconds; closing.";
+	self->Close();
+    });
+}
+
+//! Arms the login disconnect timer.
+void Descriptor::InitLoginTimer() {
+    // Give up on connections that never finish logging in.
+    const std::weak_ptr<Descriptor> weak = this->shared_from_this();
+    game_.GetTimers().Arm(loginTimer_, std::chrono::seconds(MaxLogin), [weak]() {
+	auto self = weak.lock();
+	if (!self || self->Closed() || self->user_)
+	    return;
+	LOGGER_NETWORK() << "Descriptor " << self->name_ << " did not log in within " << MaxLogin << " seconds; closing.";
+	self->Close();
+    });
+}
+
 //! Processes line input.
 //! \param lineReceived the line input to process
 void Descriptor::ReceiveLine(const String& lineReceived) {
@@ -919,9 +1269,16 @@ void Descriptor::ReceiveLine(const String& lineReceived) {
 	LOGGER_NETWORK() << "Descriptor " << name_ << " has no connection state; closing.";
 	this->Close();
     } else if (this->IsEditorActive()) {
+	this->InitIdleTimer();
+	++inputLines_;
+	this->BeginCommand();
 	if (!editor_->Receive(lineReceived))
 	    this->ResumeAfterEditor();
+	this->EndCommandIfIdle();
     } else {
+	this->InitIdleTimer();
+	++inputLines_;
+	this->BeginCommand();
 	const auto before = state_;
 	const auto received = state_->GetReceived();
 	if (!received.empty())
@@ -930,6 +1287,7 @@ void Descriptor::ReceiveLine(const String& lineReceived) {
 	if (!this->Closed() && state_ && state_ == before &&
 	    state_->GetPromptBit())
 	    this->SetPromptBit(true);
+	this->EndCommandIfIdle();
     }
 }
 
@@ -977,5 +1335,43 @@ bool Descriptor::RunStateHook(
     return lua.Execute(hook);
 }
 
+//! Corks or uncorks the transport.
+//! \param cork whether to cork
+//! \remark No-op when the transport cannot cork or corking is disabled
+//!     in Config.
+void Descriptor::SetCork(const bool cork) noexcept {
+    if (corked_ == cork || this->Closed())
+	return;
+    if (cork && !game_.GetConfig()->GetTcpCork())
+	return;
+
+    if (transport_->SetCork(cork))
+	corked_ = cork;
+}
+
+//! Replaces the current connection state and relists this
+//! descriptor in the game's state index.
+//! \param state the new current state, or \c nullptr
+//! \remark Every write of \ref state_ goes through here.
+void Descriptor::UpdateState(StatePtr state) noexcept {
+    state_ = std::move(state);
+    game_.IndexDescriptorState(*this);
+}
+
+//! Queues the "messages skipped" marker once output has drained.
+void Descriptor::WriteSkipped() {
+    if (this->Closed() || !outputSkipped_)
+	return;
+
+    char message[MaxString] = {'\0'};
+    std::snprintf(message, sizeof(message), "%s[%zu message%s skipped]%s\r\n",
+	this->GetColor(Color::C_PUNCTUATION),
+	outputSkipped_,
+	outputSkipped_ == 1 ? "" : "s",
+	this->GetColor(Color::C_NORMAL));
+    outputSkipped_ = 0;
+    this->Print(message);
+}
+
 }; // namespace Net
 }; // namespace Scratch
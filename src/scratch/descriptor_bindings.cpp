@@ -1007,6 +1007,187 @@ static int DescriptorPushState(lua_State* L) {
     return 0;
 }
 
+//! The maximum table nesting serialized by Descriptor:send_gmcp.
+static const unsigned MaxJsonDepth = 16;
+
+//! Appends \p str to \p json as a quoted JSON string.
+//! \param json the JSON text
+//! \param str the string bytes
+//! \param len the string length
+static void AppendJsonString(
+	String& json,
+	const char* str,
+	const std::size_t len) {
+    json.push_back('"');
+    for (std::size_t n = 0; n < len; ++n) {
+	const auto ch = static_cast<unsigned char>(str[n]);
+	switch (ch) {
+	case '"':  json.append("\\\""); break;
+	case '\\': json.append("\\\\"); break;
+	case '\b': json.append("\\b"); break;
+	case '\f': json.append("\\f"); break;
+	case '\n': json.append("\\n"); break;
+	case '\r': json.append("\\r"); break;
+	case '\t': json.append("\\t"); break;
+	default:
+	    if (ch < 0x20) {
+		char escape[8] = {'\0'};
+		std::snprintf(escape, sizeof(escape), "\\u%04x", ch);
+		json.append(escape);
+	    } else {
+		json.push_back(static_cast<char>(ch));
+	    }
+	    break;
+	}
+    }
+    json.push_back('"');
+}
+
+//! Appends the Lua value at \p index to \p json as compact JSON.
+//! \param L the \c lua_State
+//! \param index the stack index of the value
+//! \param json the JSON text
+//! \param depth the current table nesting
+//! \return an error message, or null on success
+//! \remark Tables with keys 1..n become arrays, others objects. Never
+//!     raises a Lua error, so the caller may unwind C++ locals first.
+static const char* AppendJson(
+	lua_State* L,
+	const int index,
+	String& json,
+	const unsigned depth) {
+    switch (lua_type(L, index)) {
+    case LUA_TNIL:
+	json.append("null");
+	return nullptr;
+    case LUA_TBOOLEAN:
+	json.append(lua_toboolean(L, index) ? "true" : "false");
+	return nullptr;
+    case LUA_TNUMBER: {
+	char number[32] = {'\0'};
+	if (lua_isinteger(L, index)) {
+	    std::snprintf(number, sizeof(number), "%lld",
+		static_cast<long long>(lua_tointeger(L, index)));
+	} else {
+	    const auto value = lua_tonumber(L, index);
+	    if (!std::isfinite(value))
+		return "non-finite number";
+	    std::snprintf(number, sizeof(number), "%.17g", value);
+	}
+	json.append(number);
+	return nullptr;
+    }
+    case LUA_TSTRING: {
+	std::size_t len = 0;
+	const char* str = lua_tolstring(L, index, &len);
+	AppendJsonString(json, str, len);
+	return nullptr;
+    }
+    case LUA_TTABLE:
+	break;
+    default:
+	return "unsupported value type";
+    }
+
+    if (depth >= MaxJsonDepth)
+	return "table nested too deeply";
+    if (!lua_checkstack(L, 3))
+	return "stack overflow";
+    const int table = lua_absindex(L, index);
+
+    // Array if the keys are exactly 1..n.
+    std::size_t count = 0;
+    bool array = true;
+    lua_pushnil(L);
+    while (lua_next(L, table)) {
+	++count;
+	if (!lua_isinteger(L, -2) || lua_tointeger(L, -2) < 1)
+	    array = false;
+	lua_pop(L, 1);
+    }
+    if (count && array && lua_rawlen(L, table) != count)
+	array = false;
+
+    if (count && array) {
+	json.push_back('[');
+	for (std::size_t n = 1; n <= count; ++n) {
+	    if (n > 1)
+		json.push_back(',');
+	    lua_rawgeti(L, table, static_cast<lua_Integer>(n));
+	    const char* error = AppendJson(L, -1, json, depth + 1);
+	    lua_pop(L, 1);
+	    if (error)
+		return error;
+	}
+	json.push_back(']');
+	return nullptr;
+    }
+
+    json.push_back('{');
+    bool first = true;
+    lua_pushnil(L);
+    while (lua_next(L, table)) {
+	// Convert a copy; lua_tolstring on the key itself breaks lua_next.
+	const int keyType = lua_type(L, -2);
+	if (keyType != LUA_TSTRING && keyType != LUA_TNUMBER) {
+	    lua_pop(L, 2);
+	    return "object keys must be strings or numbers";
+	}
+	if (!first)
+	    json.push_back(',');
+	first = false;
+	lua_pushvalue(L, -2);
+	std::size_t len = 0;
+	const char* key = lua_tolstring(L, -1, &len);
+	AppendJsonString(json, key, len);
+	lua_pop(L, 1);
+	json.push_back(':');
+	const char* error = AppendJson(L, -1, json, depth + 1);
+	lua_pop(L, 1);
+	if (error) {
+	    lua_pop(L, 1);
+	    return error;
+	}
+    }
+    json.push_back('}');
+    return nullptr;
+}
+
+//! Handles Descriptor:send_gmcp(package [, value]).
+//! \remark Returns \c false if the client did not accept GMCP.
+static int DescriptorSendGmcp(lua_State* L) {
+    const int howMany = lua_gettop(L);
+    if (howMany != 2 && howMany != 3)
+	return luaL_error(L, "send_gmcp expects 1 or 2 arguments");
+    auto weakD = CheckWeakDescriptorPtr(L);
+    if (weakD.expired())
+	return luaL_error(L, "invalid descriptor");
+    const char* error = nullptr;
+    bool sent = false;
+    {
+	const auto package = Lua::CheckString(L, 2);
+	const bool packageOk = !package.empty() &&
+	    std::all_of(std::begin(package), std::end(package), [](const char ch) {
+		return ch > ' ' && ch < 0x7f;
+	    });
+	String json;
+	if (!packageOk)
+	    error = "send_gmcp expects a package name without spaces";
+	else if (howMany == 3 && !lua_isnil(L, 3))
+	    error = AppendJson(L, 3, json, 0);
+	if (!error) {
+	    if (auto d = weakD.lock())
+		sent = d->SendGmcp(package, json);
+	    else
+		error = "invalid descriptor";
+	}
+    }
+    if (error)
+	return luaL_error(L, "%s", error);
+    Lua::CheckLua(L).PushBool(sent);
+    return 1;
+}
+
 //! Handles Descriptor:set_state(name|state).
 static int DescriptorSetState(lua_State* L) {
     if (lua_gettop(L) != 2)
@@ -1133,6 +1314,7 @@ static void RegisterDescriptorMeta(lua_State* L) {
 	{"print_format", DescriptorPrintFormat},
 	{"print_menu", DescriptorPrintMenu},
 	{"push_state", DescriptorPushState},
+	{"send_gmcp", DescriptorSendGmcp},
 	{"set_character", DescriptorSetCharacter},
 	{"set_color", DescriptorSetColor},
 	{"set_edit_command", DescriptorSetEditCommand},
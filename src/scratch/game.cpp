@@ -10,6 +10,7 @@
 
 #include <scratch/command.hpp>
 #include <scratch/config.hpp>
+#include <scratch/data.hpp>
 #include <scratch/descriptor.hpp>
 #include <scratch/enumeration.hpp>
 #include <scratch/game.hpp>
@@ -23,34 +24,77 @@
 #include <scratch/storage_file.hpp>
 #include <scratch/storage_file_multi.hpp>
 #include <scratch/string.hpp>
+#include <scratch/transport_tcp.hpp>
 #include <scratch/user.hpp>
 
 namespace Scratch {
 namespace Core {
 
+// Boost types.
+using Tcp = boost::asio::ip::tcp;
+
+// ScratchMUD types.
+using Data = Scratch::Utility::Data;
+
+//! Fixed path of the hot reboot handoff Data file.
+static const char copyoverFileName[] = "data/copyover.dat";
+
+//! Sets or clears close-on-exec on a file descriptor.
+//! \param handle the file descriptor
+//! \param closeOnExec whether to close \p handle across \c exec
+static void SetCloseOnExec(
+	const int handle,
+	const bool closeOnExec) noexcept {
+    const int flags = ::fcntl(handle, F_GETFD);
+    if (flags < 0)
+	return;
+    ::fcntl(handle, F_SETFD,
+	closeOnExec ? (flags | FD_CLOEXEC) : (flags & ~FD_CLOEXEC));
+}
+
 //! Default constructor.
 Game::Game() :
 	ioContext_(),
+	actionTemplates_(),
+	actionTemplatesIndex_(),
+	audience_(),
+	commandProfile_(),
 	commands_(std::make_shared<CommandRepository>(
 		Scratch::Storage::MultiFileStorage<Command>(
 			"data", "command", ".dat"))),
 	commandsIndex_(),
+	commandsKeys_(),
+	commandsTrie_(),
 	config_(std::make_shared<Config>()),
+	copyoverBit_(false),
+	descriptorsByState_(),
 	descriptors_(),
 	enumerations_(std::make_shared<EnumerationRepository>(
 		Scratch::Storage::FileStorage<Enumeration>(
 			"data", "enumeration", ".dat"))),
+	instancesIndex_(),
+	instancesByPlayer_(),
 	instances_(),
 	lua_(std::make_unique<Lua>(*this)),
 	players_(std::make_shared<PlayerRepository>(
 		Scratch::Storage::MultiFileStorage<Player>(
 			"data", "player", ".dat"))),
+	programName_(),
+	pulse_(ioContext_),
+	pulseHooks_(),
+	instancePulseHooks_(),
+	pulsePool_(),
+	shards_(),
+	shardPositions_(),
 	server_(),
 	shutdown_(false),
 	signals_(ioContext_),
 	states_(std::make_shared<StateRepository>(
 		Scratch::Storage::MultiFileStorage<State>(
 			"data", "state", ".dat"))),
+	terminalStats_(),
+	timers_(ioContext_),
+	copyoverTimer_(),
 	users_(std::make_shared<UserRepository>(
 		Scratch::Storage::MultiFileStorage<User>(
 			"data", "user", ".dat"))) {
@@ -82,17 +126,9 @@ ConfigPtr Game::GetConfig() const noexcept {
 //! \param descriptorName the descriptor name
 //! \return the descriptor, or \c nullptr
 DescriptorPtr Game::GetDescriptor(const String& descriptorName) noexcept {
-    auto d = descriptors_.find(descriptorName);
-    return d != std::end(descriptors_) ? d->second : nullptr;
-}
-
-//! Gets the descriptors.
-std::set<DescriptorPtr> Game::GetDescriptors() const noexcept {
-    std::set<DescriptorPtr> descriptorSet;
-    for (auto& pair: descriptors_) {
-	descriptorSet.insert(pair.second);
-    }
-    return descriptorSet;
+    auto d = descriptors_.Find(
+	SlotMap<DescriptorPtr>::FromName(descriptorName));
+    return d ? *d : nullptr;
 }
 
 //! Gets the enumeration repository.
@@ -105,6 +141,11 @@ StateRepositoryPtr Game::GetStates() const noexcept {
     return states_;
 }
 
+//! Gets the timer wheel.
+TimerWheel& Game::GetTimers() noexcept {
+    return timers_;
+}
+
 //! Gets the user repository.
 UserRepositoryPtr Game::GetUsers() const noexcept {
     return users_;
@@ -115,20 +156,18 @@ PlayerRepositoryPtr Game::GetPlayers() const noexcept {
     return players_;
 }
 
+//! Gets the game pulse.
+Pulse& Game::GetPulse() noexcept {
+    return pulse_;
+}
+
 //! Gets an instance.
 //! \param instanceName the instance name
 //! \return the instance, or \c nullptr
 InstancePtr Game::GetInstance(const String& instanceName) const noexcept {
-    auto it = instances_.find(instanceName);
-    return it != std::end(instances_) ? it->second : nullptr;
-}
-
-//! Gets the instances.
-std::set<InstancePtr> Game::GetInstances() const noexcept {
-    std::set<InstancePtr> instanceSet;
-    for (auto& pair: instances_)
-	instanceSet.insert(pair.second);
-    return instanceSet;
+    auto instance = instances_.Find<InstancePtr>(
+	InstanceStore::FromName(instanceName));
+    return instance ? *instance : nullptr;
 }
 
 //! Gets the instance for \p player.
@@ -137,12 +176,8 @@ std::set<InstancePtr> Game::GetInstances() const noexcept {
 InstancePtr Game::GetInstanceFor(const PlayerPtr& player) noexcept {
     if (!player)
 	return nullptr;
-    for (auto& pair: instances_) {
-	auto& instance = pair.second;
-	if (instance && instance->GetPlayer() == player)
-	    return instance;
-    }
-    return nullptr;
+    auto it = instancesByPlayer_.find(player.get());
+    return it != std::end(instancesByPlayer_) ? it->second : nullptr;
 }
 
 //! Inserts an instance.
@@ -151,36 +186,208 @@ InstancePtr Game::GetInstanceFor(const PlayerPtr& player) noexcept {
 bool Game::InsertInstance(const InstancePtr& instance) noexcept {
     if (!instance)
 	return false;
+    if (instance->game_ == this)
+	return true;
     if (instance->GetPlayer() && this->GetInstanceFor(instance->GetPlayer()))
 	return false;
-    while (instance->GetName().empty() ||
-	    this->GetInstance(instance->GetName())) {
-	instance->SetName(Scratch::Algorithm::StringGenerateCopy());
+    // The columns own the fields from here on.
+    instance->handle_ = instances_.Insert(instance, String(),
+	instance->gender_, std::move(instance->player_),
+	std::move(instance->descriptor_));
+    instance->game_ = this;
+    instance->name_.clear();
+    instance->SetName(InstanceStore::ToName(instance->handle_));
+    if (auto player = instance->GetPlayer()) {
+	instancesByPlayer_[player.get()] = instance;
+	instancesIndex_.emplace(player->GetName(), instance);
     }
-    instances_[instance->GetName()] = instance;
+#ifdef SCRATCH_DEBUG_CHECKS
+    this->CheckInstanceIndex();
+#endif // SCRATCH_DEBUG_CHECKS
     return true;
 }
 
 //! Removes an instance.
 //! \param instance the instance to erase
 void Game::EraseInstance(const InstancePtr& instance) noexcept {
-    if (!instance || instance->GetName().empty())
+    if (!instance || instance->game_ != this)
+	return;
+    if (instance->GetAudience())
+	instance->GetAudience()->Erase(instance);
+    const auto handle = instance->handle_;
+    instance->Detach();
+    instances_.Erase(handle);
+    this->UnindexPlayer(instance, instance->GetPlayer());
+#ifdef SCRATCH_DEBUG_CHECKS
+    this->CheckInstanceIndex();
+#endif // SCRATCH_DEBUG_CHECKS
+}
+
+//! Updates the player index after a live instance changes player.
+//! \param instance the instance
+//! \param previous the player it had before
+//! \sa Instance::SetPlayer(const PlayerPtr&)
+void Game::ReindexPlayer(
+	const InstancePtr& instance,
+	const PlayerPtr& previous) noexcept {
+    this->UnindexPlayer(instance, previous);
+
+    // First claimant keeps the player, as a scan in insertion order would.
+    if (auto player = instance->GetPlayer()) {
+	instancesByPlayer_.emplace(player.get(), instance);
+	instancesIndex_.emplace(player->GetName(), instance);
+    }
+#ifdef SCRATCH_DEBUG_CHECKS
+    this->CheckInstanceIndex();
+#endif // SCRATCH_DEBUG_CHECKS
+}
+
+//! Drops \p instance from the player and keyword indexes.
+//! \param instance the instance
+//! \param player the player it was indexed under
+//! \remark Another live instance holding \p player inherits the player
+//!     entry; only #ReindexPlayer can create such a duplicate, so the
+//!     fallback scan is rare.
+void Game::UnindexPlayer(
+	const InstancePtr& instance,
+	const PlayerPtr& player) noexcept {
+    if (!player)
+	return;
+
+    // Keyword entry; live players cannot be renamed.
+    auto range = instancesIndex_.equal_range(player->GetName());
+    for (auto kt = range.first; kt != range.second; ++kt) {
+	if (kt->second == instance) {
+	    instancesIndex_.erase(kt);
+	    break;
+	}
+    }
+
+    auto it = instancesByPlayer_.find(player.get());
+    if (it == std::end(instancesByPlayer_) || it->second != instance)
 	return;
-    instances_.erase(instance->GetName());
+    instancesByPlayer_.erase(it);
+    const auto& instances = instances_.GetColumn<InstancePtr>();
+    const auto& players = instances_.GetColumn<PlayerPtr>();
+    for (std::size_t n = 0; n < players.size(); ++n) {
+	if (players[n] == player && instances[n] != instance) {
+	    instancesByPlayer_.emplace(player.get(), instances[n]);
+	    break;
+	}
+    }
+}
+
+//! Verifies the state index against a full scan of the descriptors.
+//! \return \c false if a descriptor is missing, stale, or mislinked
+//! \remark Run after every state change when configured with
+//!     \c --enable-debug-checks.
+bool Game::CheckDescriptorIndex() const noexcept {
+    bool consistent = true;
+    std::size_t linked = 0;
+    for (auto& pair: descriptorsByState_) {
+	if (!pair.second) {
+	    LOGGER_ASSERT() << "State index holds an empty list.";
+	    consistent = false;
+	}
+	const Descriptor* prev = nullptr;
+	for (auto d = pair.second; d; d = d->stateNext_) {
+	    if (d->statePrev_ != prev || d->stateIndexed_ != pair.first ||
+		    d->state_.get() != pair.first) {
+		LOGGER_ASSERT() << "Descriptor " << d->GetName()
+		    << " is stale in the state index.";
+		consistent = false;
+	    }
+	    prev = d;
+	    ++linked;
+	}
+    }
+    std::size_t stated = 0;
+    for (auto& d: this->GetDescriptors()) {
+	if (d && d->state_)
+	    ++stated;
+    }
+    if (stated != linked) {
+	LOGGER_ASSERT() << "State index lists " << linked
+	    << " descriptors for " << stated << " in a state.";
+	consistent = false;
+    }
+    return consistent;
+}
+
+//! Verifies the player and keyword indexes against a full scan.
+//! \return \c false if an entry is missing, stale, or mismatched
+bool Game::CheckInstanceIndex() const noexcept {
+    bool consistent = true;
+    for (auto& pair: instancesByPlayer_) {
+	const auto& instance = pair.second;
+	if (!instance || instance->GetPlayer().get() != pair.first ||
+		this->GetInstance(instance->GetName()) != instance) {
+	    LOGGER_ASSERT() << "Player index entry "
+		<< (instance ? instance->GetName() : String("<null>"))
+		<< " is stale.";
+	    consistent = false;
+	}
+    }
+    const auto& instances = instances_.GetColumn<InstancePtr>();
+    const auto& names = instances_.GetColumn<String>();
+    const auto& players = instances_.GetColumn<PlayerPtr>();
+    for (std::size_t n = 0; n < instances.size(); ++n) {
+	const auto& instance = instances[n];
+	const auto handle = instances_.GetHandle(n);
+	if (!instance || instance->GetHandle() != handle ||
+		names[n] != InstanceStore::ToName(handle)) {
+	    LOGGER_ASSERT() << "Instance " << names[n]
+		<< " is stale in the instance store.";
+	    consistent = false;
+	}
+	if (!instance || !players[n])
+	    continue;
+	auto it = instancesByPlayer_.find(players[n].get());
+	if (it == std::end(instancesByPlayer_)) {
+	    LOGGER_ASSERT() << "Instance " << instance->GetName()
+		<< " missing from player index.";
+	    consistent = false;
+	}
+    }
+    std::size_t keyed = 0;
+    for (const auto& player: players) {
+	if (player)
+	    ++keyed;
+    }
+    for (auto& pair: instancesIndex_) {
+	const auto& instance = pair.second;
+	if (!instance || !instance->GetPlayer() ||
+		Scratch::Algorithm::StringCompareCi(
+		    instance->GetPlayer()->GetName(), pair.first) ||
+		this->GetInstance(instance->GetName()) != instance) {
+	    LOGGER_ASSERT() << "Keyword index entry " << pair.first
+		<< " is stale.";
+	    consistent = false;
+	}
+    }
+    if (keyed != instancesIndex_.size()) {
+	LOGGER_ASSERT() << "Keyword index holds " << instancesIndex_.size()
+	    << " entries for " << keyed << " instances.";
+	consistent = false;
+    }
+    return consistent;
 }
 
 //! Applies Quiet and Prompt bits.
 //! \param state the connection state
-//! \sa #GetDescriptors() const
+//! \sa #GetDescriptorsIn(const StatePtr&) const
 //! \sa Descriptor::SetState(const StatePtr&)
 void Game::ApplyStateBits(const StatePtr& state) noexcept {
     if (!state)
 	return;
+    auto it = descriptorsByState_.find(state.get());
+    if (it == std::end(descriptorsByState_))
+	return;
 
     const bool quiet = state->GetQuietBit();
     const bool prompt = state->GetPromptBit();
-    for (auto& d: this->GetDescriptors()) {
-	if (!d || d->Closed() || d->GetState() != state)
+    for (auto d = it->second; d; d = d->stateNext_) {
+	if (d->Closed())
 	    continue;
 	d->SetQuiet(quiet);
 	if (prompt)
@@ -188,6 +395,24 @@ void Game::ApplyStateBits(const StatePtr& state) noexcept {
     }
 }
 
+//! Gets the open descriptors whose current state is \p state.
+//! \param state the connection state
+//! \return a snapshot, most recently entered first
+//! \remark Walks only the descriptors listed under \p state.
+//! \sa #IndexDescriptorState(Descriptor&)
+std::vector<DescriptorPtr> Game::GetDescriptorsIn(
+	const StatePtr& state) const {
+    std::vector<DescriptorPtr> descriptors;
+    auto it = descriptorsByState_.find(state.get());
+    if (it == std::end(descriptorsByState_))
+	return descriptors;
+    for (auto d = it->second; d; d = d->stateNext_) {
+	if (!d->Closed())
+	    descriptors.push_back(d->shared_from_this());
+    }
+    return descriptors;
+}
+
 //! Gets the IO context.
 IoContext& Game::GetIoContext() noexcept {
     return ioContext_;
@@ -198,27 +423,62 @@ Lua& Game::GetLua() noexcept {
     return *lua_;
 }
 
+//! Gets the server.
+Server& Game::GetServer() noexcept {
+    return *server_;
+}
+
 //! Gets the shutdown flag.
 //! \sa #SetShutdown(const bool)
 bool Game::GetShutdown() const noexcept {
     return shutdown_;
 }
 
+//! Adds a closed session's input counters to its terminal type and
+//! logs the running packets per command.
+//! \param terminalType the TTYPE, or empty if none was reported
+//! \param packets the input packets read
+//! \param lines the input lines delivered
+//! \sa #GetTerminalStats() const
+void Game::RecordTerminalStats(
+	const String& terminalType,
+	const std::uint64_t packets,
+	const std::uint64_t lines) {
+    const String key = terminalType.empty() ? "unknown" : terminalType;
+    auto& stats = terminalStats_[key];
+    ++stats.sessions;
+    stats.packets += packets;
+    stats.lines += lines;
+
+    if (stats.lines) {
+	LOGGER_NETWORK() << "TTYPE " << key
+	    << " sessions=" << stats.sessions
+	    << " packets/command=" << static_cast<double>(stats.packets) / stats.lines << ".";
+    }
+}
+
 //! Constructs a descriptor.
 //! \param socket the Boost socket
-DescriptorPtr Game::MakeDescriptor(Socket&& socket) noexcept {
-    // Create descriptor.
-    auto d = std::make_shared<Descriptor>(*this, std::move(socket));
+//! \param protocolType the wire protocol
+DescriptorPtr Game::MakeDescriptor(
+	Socket&& socket,
+	const ProtocolType protocolType) noexcept {
+    return this->MakeDescriptor(
+	std::make_unique<Scratch::Net::TcpTransport>(std::move(socket)),
+	protocolType);
+}
 
-    // Create descriptor name.
-    while (true) {
-	d->SetName(Scratch::Algorithm::StringGenerateCopy());
-	if (!this->GetDescriptor(d->GetName()))
-	    break;
-    }
+//! Constructs a descriptor over a transport.
+//! \param transport the wire transport
+//! \param protocolType the wire protocol
+DescriptorPtr Game::MakeDescriptor(
+	std::unique_ptr<Transport>&& transport,
+	const ProtocolType protocolType) noexcept {
+    // Create descriptor.
+    auto d = std::make_shared<Descriptor>(*this, std::move(transport), protocolType);
 
-    // Store descriptor into descriptor index.
-    descriptors_[d->GetName()] = d;
+    // Store descriptor into descriptor index; name is the handle.
+    d->SetName(SlotMap<DescriptorPtr>::ToName(descriptors_.Insert(d)));
 
     // Start descriptor I/O.
     d->Start();
@@ -229,14 +489,20 @@ DescriptorPtr Game::MakeDescriptor(Socket&& socket) noexcept {
 //! Erases a descriptor.
 //! \param descriptorName the descriptor name to erase
 void Game::EraseDescriptor(const String& descriptorName) noexcept {
-    auto it = descriptors_.find(descriptorName);
-    if (it == std::end(descriptors_))
+    const auto handle = SlotMap<DescriptorPtr>::FromName(descriptorName);
+    auto it = descriptors_.Find(handle);
+    if (!it)
 	return;
 
     // Hold reference across close so cancelled completions stay valid
     // when this path closes socket itself (not via Descriptor::Close).
-    DescriptorPtr d = it->second;
-    descriptors_.erase(it);
+    DescriptorPtr d = *it;
+    descriptors_.Erase(handle);
+    this->UnindexDescriptorState(*d);
+
+    // Return the admission slot.
+    if (server_)
+	server_->GetAdmission().Release(d->GetAddress());
 
     if (d->Closed())
 	return;
@@ -247,6 +513,57 @@ void Game::EraseDescriptor(const String& descriptorName) noexcept {
     boost::asio::post(ioContext_, [d]() mutable {});
 }
 
+//! Lists \p d under its current state, moving it off the state it
+//! was listed under before.
+//! \param d the descriptor
+//! \remark Called by the descriptor whenever its current state
+//!     changes; each state heads an intrusive list threaded through
+//!     its descriptors.
+//! \sa #GetDescriptorsIn(const StatePtr&) const
+void Game::IndexDescriptorState(Descriptor& d) noexcept {
+    const State* state = d.state_.get();
+    if (d.stateIndexed_ == state)
+	return;
+
+    this->UnindexDescriptorState(d);
+    if (state) {
+	auto& head = descriptorsByState_[state];
+	d.stateNext_ = head;
+	if (head)
+	    head->statePrev_ = &d;
+	head = &d;
+	d.stateIndexed_ = state;
+    }
+#ifdef SCRATCH_DEBUG_CHECKS
+    this->CheckDescriptorIndex();
+#endif // SCRATCH_DEBUG_CHECKS
+}
+
+//! Unlinks \p d from the state index.
+//! \param d the descriptor
+//! \sa #IndexDescriptorState(Descriptor&)
+void Game::UnindexDescriptorState(Descriptor& d) noexcept {
+    if (!d.stateIndexed_)
+	return;
+
+    if (d.stateNext_)
+	d.stateNext_->statePrev_ = d.statePrev_;
+    if (d.statePrev_) {
+	d.statePrev_->stateNext_ = d.stateNext_;
+    } else {
+	auto it = descriptorsByState_.find(d.stateIndexed_);
+	if (it != std::end(descriptorsByState_) && it->second == &d) {
+	    if (d.stateNext_)
+		it->second = d.stateNext_;
+	    else
+		descriptorsByState_.erase(it);
+	}
+    }
+    d.stateIndexed_ = nullptr;
+    d.stateNext_ = nullptr;
+    d.statePrev_ = nullptr;
+}
+
 //! Loads game repositories from disk.
 //! \throw std::runtime_error if a required repository cannot be loaded
 //! \sa #Run()
@@ -263,6 +580,17 @@ void Game::LoadRepositories() {
 	throw std::runtime_error("Couldn't load command index.");
     }
     this->RebuildCommandIndex();
+    commands_->SetListener([this](
+	    const CommandRepository::Change change,
+	    const String&,
+	    const CommandPtr& command) {
+	// Patch only the changed command's keys. The repository has
+	// already taken a rejected change, so rebuild to match it.
+	if (change == CommandRepository::CHANGE_ERASED)
+	    this->UnindexCommand(command);
+	else if (!this->IndexCommand(command))
+	    this->RebuildCommandIndex(false);
+    });
     if (!enumerations_->LoadIndex()) {
 	throw std::runtime_error("Couldn't load enumeration index.");
     }
@@ -280,20 +608,48 @@ void Game::LoadRepositories() {
 void Game::ParseArguments(
 	const int argc,
 	const char **argv) {
-    // Nothing.
+    if (argc > 0 && argv[0])
+	programName_ = argv[0];
+    for (int n = 1; n < argc; ++n) {
+	if (argv[n] && !std::strcmp(argv[n], "--copyover"))
+	    copyoverBit_ = true;
+    }
 }
 
 //! Runs the game.
 void Game::Run() {
     this->LoadRepositories();
 
-    // Configure acceptor.
+    // Configure acceptor, adopting handed-off sockets after a hot reboot;
+    // with a gateway, scratch-gateway owns the TELNET port instead.
     server_ = std::make_shared<Server>(*this);
-    server_->StartAcceptor(config_->GetPort(), config_->GetAddress());
+    if (!config_->GetGateway().empty())
+	server_->StartGateway(config_->GetGateway());
+    else if (!copyoverBit_ || !this->CopyoverResume())
+	server_->StartAcceptor(config_->GetPort(), config_->GetAddress());
+    if (config_->GetWebSocketPort() &&
+	    !server_->IsListening(Scratch::Net::PROTOCOL_WEBSOCKET)) {
+	server_->StartAcceptor(config_->GetWebSocketPort(),
+	    config_->GetAddress(), Scratch::Net::PROTOCOL_WEBSOCKET);
+    }
 
     // Wait for SIGINT / SIGTERM so we can shut down cleanly.
     this->InitSignals();
 
+    // Shard instance pulse hooks across the work pool.
+    shards_.clear();
+    for (unsigned n = 0; n < config_->GetPulseShards(); ++n)
+	shards_.push_back(std::make_unique<Shard>(*this));
+    shardPositions_.assign(shards_.size(), std::vector<std::size_t>());
+    pulsePool_ = std::make_unique<WorkPool>(config_->GetPulseThreads());
+
+    // Start the game pulse.
+    pulse_.Register(1, [this](const std::uint64_t pulse) {
+	this->RunPulseHooks(pulse);
+	this->RunInstancePulseHooks(pulse);
+    });
+    pulse_.Start(std::chrono::milliseconds(1000 / config_->GetPulseRate()));
+
     // Now run event loop.
     LOGGER_MAIN() << "Starting game loop.";
     while (!shutdown_) {
@@ -317,6 +673,113 @@ void Game::Run() {
     LOGGER_MAIN() << "Game loop completed normally.";
 }
 
+//! Runs the Lua instance pulse hooks due on \p pulse across the
+//! shards, then applies their deferred effects.
+//! \param pulse the pulse number
+//! \sa #SetInstancePulseHook(const String&, const unsigned, const String&)
+void Game::RunInstancePulseHooks(const std::uint64_t pulse) {
+    if (instancePulseHooks_.empty() || shards_.empty() || !pulsePool_)
+	return;
+
+    std::vector<Shard::Hook> hooks;
+    for (auto& pair: instancePulseHooks_) {
+	if (pulse % pair.second.every == 0)
+	    hooks.push_back(Shard::Hook{pair.first, pair.second.source});
+    }
+    const auto& instances = instances_.GetColumn<InstancePtr>();
+    if (hooks.empty() || instances.empty())
+	return;
+
+    // An instance keeps the shard picked by its slot index for life, so
+    // script state in that shard's Lua state survives swap-removes.
+    for (auto& positions: shardPositions_)
+	positions.clear();
+    for (std::size_t n = 0; n < instances.size(); ++n) {
+	const auto slot = static_cast<std::uint32_t>(instances_.GetHandle(n));
+	shardPositions_[slot % shards_.size()].push_back(n);
+    }
+
+    // The game thread blocks in Run, so nothing writes game state
+    // meanwhile.
+    std::vector<WorkPool::Task> tasks;
+    for (std::size_t n = 0; n < shards_.size(); ++n) {
+	if (shardPositions_[n].empty())
+	    continue;
+	auto* shard = shards_[n].get();
+	const auto& positions = shardPositions_[n];
+	const auto& store = instances_;
+	tasks.push_back([shard, pulse, &hooks, &store, &positions] {
+	    shard->Run(pulse, hooks, store, positions);
+	});
+    }
+    pulsePool_->Run(tasks);
+
+    // Cross-shard effects land on the game thread, in shard order.
+    for (auto& shard: shards_)
+	shard->Apply();
+}
+
+//! Runs the Lua pulse hooks due on \p pulse with \c pulse.
+//! \param pulse the pulse number
+//! \sa #SetPulseHook(const String&, const unsigned, const String&)
+void Game::RunPulseHooks(const std::uint64_t pulse) {
+    if (pulseHooks_.empty())
+	return;
+
+    // Walk by name; a hook may set or erase hooks, itself included.
+    auto& lua = this->GetLua();
+    auto it = pulseHooks_.begin();
+    while (it != pulseHooks_.end()) {
+	const auto name = it->first;
+	if (pulse % it->second.every == 0) {
+	    const auto source = it->second.source;
+	    Lua::Caller caller(lua, name + ":Pulse");
+	    if (caller.IsActive()) {
+		lua.PushInt(static_cast<lua_Integer>(pulse));
+		lua.SetEnv("pulse");
+		lua.Execute(source);
+	    }
+	}
+	it = pulseHooks_.upper_bound(name);
+    }
+}
+
+//! Sets or erases a Lua instance pulse hook.
+//! \param name the hook name, also its Caller identity
+//! \param every the pulse interval, at least one
+//! \param source the Lua source, or empty to erase the hook
+//! \sa #RunInstancePulseHooks(const std::uint64_t)
+void Game::SetInstancePulseHook(
+	const String& name,
+	const unsigned every,
+	const String& source) {
+    if (source.empty()) {
+	instancePulseHooks_.erase(name);
+	return;
+    }
+    auto& hook = instancePulseHooks_[name];
+    hook.every = std::max(every, 1u);
+    hook.source = source;
+}
+
+//! Sets or erases a Lua pulse hook.
+//! \param name the hook name, also its Caller identity
+//! \param every the pulse interval, at least one
+//! \param source the Lua source, or empty to erase the hook
+//! \sa #RunPulseHooks(const std::uint64_t)
+void Game::SetPulseHook(
+	const String& name,
+	const unsigned every,
+	const String& source) {
+    if (source.empty()) {
+	pulseHooks_.erase(name);
+	return;
+    }
+    auto& hook = pulseHooks_[name];
+    hook.every = std::max(every, 1u);
+    hook.source = source;
+}
+
 //! Sets the shutdown flag.
 //! \param shutdown the shutdown flag value
 //! \sa #GetShutdown() const
@@ -345,11 +808,182 @@ void Game::Shutdown() noexcept {
 	d->Close();
 
     // Maps; Close() defers EraseDescriptor via post.
-    descriptors_.clear();
-    instances_.clear();
+    for (auto d: this->GetDescriptors())
+	this->UnindexDescriptorState(*d);
+    descriptorsByState_.clear();
+    descriptors_.Clear();
+    audience_.Clear();
+    for (auto& instance: instances_.GetColumn<InstancePtr>())
+	instance->Detach();
+    instancesIndex_.clear();
+    instancesByPlayer_.clear();
+    instances_.Clear();
+    pulse_.Stop();
+    pulseHooks_.clear();
+    instancePulseHooks_.clear();
+    timers_.Clear();
     ioContext_.stop();
 }
 
+//! Schedules a hot reboot that keeps every connection open.
+//! \remark Sessions are written to a handoff file and the program
+//!     image is re-executed with the sockets inherited.
+//! \sa #CopyoverExec()
+//! \sa #CopyoverResume()
+void Game::Copyover() noexcept {
+    if (shutdown_ || !server_ || copyoverTimer_.IsArmed())
+	return;
+
+    // Gateway sessions have no socket to inherit; the gateway holds them
+    // open across a plain restart instead.
+    if (!config_->GetGateway().empty()) {
+	LOGGER_MAIN() << "Hot reboot unavailable behind the gateway; restart the game instead.";
+	return;
+    }
+
+    // Let pending output drain before the image is replaced.
+    LOGGER_MAIN() << "Hot reboot scheduled.";
+    timers_.Arm(copyoverTimer_, std::chrono::seconds(1), [this]() {
+	this->CopyoverExec();
+    });
+}
+
+//! Writes the handoff file and re-executes the program.
+//! \remark Returns only if the hot reboot failed.
+//! \sa #Copyover()
+void Game::CopyoverExec() noexcept {
+    if (shutdown_ || !server_)
+	return;
+
+    // Write listening socket.
+    auto root = std::make_shared<Data>();
+    auto serverData = std::make_shared<Data>();
+    server_->SaveHandoff(serverData);
+    if (!serverData->Size()) {
+	LOGGER_MAIN() << "Hot reboot aborted; acceptor is not open.";
+	return;
+    }
+    root->Put("Server", serverData);
+    std::vector<int> handles;
+    handles.push_back(static_cast<int>(serverData->GetNumber("Socket")));
+    if (auto webSocketData = serverData->Get("WebSocket"))
+	handles.push_back(static_cast<int>(webSocketData->GetNumber("Socket")));
+
+    // Write sessions and persist their accounts.
+    auto descriptorsData = std::make_shared<Data>();
+    for (auto& d: this->GetDescriptors()) {
+	if (!d || d->Closed())
+	    continue;
+	auto descriptorData = std::make_shared<Data>();
+	if (!d->SaveHandoff(descriptorData))
+	    continue;
+	descriptorsData->Put("%", descriptorData);
+	handles.push_back(static_cast<int>(descriptorData->GetNumber("Socket")));
+	if (auto user = d->GetUser())
+	    users_->Save(user->GetName());
+	if (auto character = d->GetCharacter()) {
+	    if (auto player = character->GetPlayer())
+		players_->Save(player->GetName());
+	}
+    }
+    if (descriptorsData->Size())
+	root->Put("Descriptors", descriptorsData);
+
+    if (!root->SaveFile(copyoverFileName)) {
+	LOGGER_MAIN() << "Hot reboot aborted; couldn't write " << copyoverFileName << ".";
+	return;
+    }
+
+    // Exec by path so a freshly deployed binary is the one that runs.
+    for (const auto handle: handles)
+	SetCloseOnExec(handle, false);
+    LOGGER_MAIN() << "Hot rebooting with " << descriptorsData->Size() << " descriptor(s).";
+    const auto program = programName_.empty() ? String("bin/scratch") : programName_;
+    const char* argv[] = { program.c_str(), "--copyover", nullptr };
+    ::execvp(program.c_str(), const_cast<char* const*>(argv));
+
+    // Still here; carry on with the old image.
+    LOGGER_SYSTEM() << "Error executing " << program << ": " << std::strerror(errno) << ".";
+    for (const auto handle: handles)
+	SetCloseOnExec(handle, true);
+    ErrorCode errorCode;
+    boost::filesystem::remove(copyoverFileName, errorCode);
+}
+
+//! Rebuilds the acceptor and descriptors from the handoff file.
+//! \return \c true if the handed-off acceptor was adopted
+//! \sa #Copyover()
+bool Game::CopyoverResume() {
+    auto root = std::make_shared<Data>();
+    const bool loaded = root->LoadFile(copyoverFileName);
+    ErrorCode removeError;
+    boost::filesystem::remove(copyoverFileName, removeError);
+    if (!loaded) {
+	LOGGER_MAIN() << "Couldn't load " << copyoverFileName << "; starting fresh.";
+	return false;
+    }
+
+    // Adopt listening socket.
+    auto serverData = root->Get("Server");
+    auto descriptorsData = root->Get("Descriptors");
+    if (!serverData || !server_->ResumeAcceptor(serverData)) {
+	LOGGER_MAIN() << "Couldn't adopt handed-off acceptor; starting fresh.";
+	if (serverData) {
+	    if (auto webSocketData = serverData->Get("WebSocket")) {
+		const auto handle = static_cast<int>(webSocketData->GetNumber("Socket", -1));
+		if (handle >= 0)
+		    ::close(handle);
+	    }
+	}
+	if (descriptorsData) {
+	    for (const auto& entry: descriptorsData->GetEntries()) {
+		const auto handle = static_cast<int>(entry.second->GetNumber("Socket", -1));
+		if (handle >= 0)
+		    ::close(handle);
+	    }
+	}
+	return false;
+    }
+    SetCloseOnExec(static_cast<int>(serverData->GetNumber("Socket")), true);
+    if (auto webSocketData = serverData->Get("WebSocket"))
+	SetCloseOnExec(static_cast<int>(webSocketData->GetNumber("Socket")), true);
+
+    // Adopt sessions.
+    std::size_t resumed = 0;
+    if (descriptorsData) {
+	for (const auto& entry: descriptorsData->GetEntries()) {
+	    const auto& descriptorData = entry.second;
+	    const auto handle = static_cast<int>(descriptorData->GetNumber("Socket", -1));
+	    if (handle < 0)
+		continue;
+	    SetCloseOnExec(handle, true);
+
+	    Socket socket(ioContext_);
+	    ErrorCode errorCode;
+	    socket.assign(descriptorData->GetYesNo("V6", false) ? Tcp::v6() : Tcp::v4(),
+		handle, errorCode);
+	    if (errorCode) {
+		LOGGER_NETWORK() << "Error adopting descriptor socket.";
+		LOGGER_NETWORK() << " >> " << errorCode;
+		LOGGER_NETWORK() << " >> " << errorCode.message();
+		::close(handle);
+		continue;
+	    }
+
+	    const auto protocolType = descriptorData->GetYesNo("WebSocket", false) ?
+		Scratch::Net::PROTOCOL_WEBSOCKET : Scratch::Net::PROTOCOL_TELNET;
+	    auto d = std::make_shared<Descriptor>(*this, std::move(socket), protocolType);
+	    d->SetName(SlotMap<DescriptorPtr>::ToName(descriptors_.Insert(d)));
+	    server_->GetAdmission().Adopt(d->GetAddress());
+	    d->Resume(descriptorData);
+	    ++resumed;
+	}
+    }
+
+    LOGGER_MAIN() << "Resumed " << resumed << " descriptor(s) after hot reboot.";
+    return true;
+}
+
 //! Begins waiting for process termination signals.
 void Game::InitSignals() {
     signals_.add(SIGINT);
@@ -9,13 +9,14 @@
 #define _SCRATCH_GAME_ACTION_CPP_
 
 #include <scratch/action.hpp>
+#include <scratch/audience.hpp>
 #include <scratch/color.hpp>
 #include <scratch/color_bindings.hpp>
 #include <scratch/command.hpp>
 #include <scratch/command_bindings.hpp>
+#include <scratch/config.hpp>
 #include <scratch/descriptor.hpp>
 #include <scratch/game.hpp>
-#include <scratch/gender.hpp>
 #include <scratch/instance.hpp>
 #include <scratch/instance_bindings.hpp>
 #include <scratch/logger.hpp>
@@ -25,8 +26,7 @@
 #include <scratch/storage_file.hpp>
 #include <scratch/storage_file_multi.hpp>
 #include <scratch/string.hpp>
-
-#include <cctype>
+#include <scratch/symbol_table.hpp>
 
 namespace Scratch {
 namespace Core {
@@ -35,262 +35,30 @@ using Lua = Scratch::Scripting::Lua;
 
 namespace {
 
-//! Returns the genitive form.
-//! \param name the name
-String MakeNamePossessive(const String& name) {
-    if (name.empty())
-	return "<Invalid>";
-    const auto lower = [](const char c) {
-	return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-    };
-    const char last = lower(name.back());
-    if (last == 's' || last == 'x' || last == 'z')
-	return name + "'";
-    if (name.size() >= 2) {
-	const char a = lower(name[name.size() - 2]);
-	const char b = lower(name[name.size() - 1]);
-	if ((a == 'c' && b == 'h') || (a == 's' && b == 'h'))
-	    return name + "'";
-    }
-    return name + "'s";
-}
-
-//! Returns whether text starts with vowel.
-//! \param text the text
-bool StartsWithVowel(const String& text) noexcept {
-    if (text.empty())
-	return false;
-    const char c = static_cast<char>(
-	std::tolower(static_cast<unsigned char>(text[0])));
-    return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u';
-}
-
-//! Resolves gender.
-//! \param instance the instance
-//! \return the gender, or \c GENDER_UNDEFINED
-Gender::GenderEnum ResolveGender(const InstancePtr& instance) {
-    if (!instance)
-	return Gender::GENDER_UNDEFINED;
-    return instance->GetGender();
-}
-
-//! Resolves name.
-//! \param instance the instance
-//! \return the name
-String ResolveName(const InstancePtr& instance) {
-    if (!instance)
-	return String();
-    auto player = instance->GetPlayer();
-    if (player)
-	return player->GetName();
-    return String();
-}
-
-//! Resolves one property.
-//! \param prop the property name
-//! \param param the action param
-//! \param recipient the recipient instance
-//! \param raw whether you-shift is disabled
-String ResolveProperty(
-	const String& prop,
-	const ActionParam& param,
-	const InstancePtr& recipient,
-	const bool raw) {
-    const auto instance = param.GetInstance();
-    const bool isMe = !raw && instance && recipient && instance == recipient;
-    const auto gender = ResolveGender(instance);
-
-    if (Scratch::Algorithm::StringCompareCi(prop, "Text") == 0) {
-	if (!param.GetText().empty())
-	    return param.GetText();
-	if (instance)
-	    return ResolveName(instance);
-	return String();
-    }
-    if (Scratch::Algorithm::StringCompareCi(prop, "An") == 0) {
-	String text = param.GetText();
-	if (text.empty() && instance)
-	    text = ResolveName(instance);
-	return StartsWithVowel(text) ? "an" : "a";
-    }
-    if (Scratch::Algorithm::StringCompareCi(prop, "Name") == 0 ||
-	    Scratch::Algorithm::StringCompareCi(prop, "RawName") == 0) {
-	if (!instance)
-	    return "<Invalid>";
-	if (isMe)
-	    return "you";
-	return ResolveName(instance);
-    }
-    if (Scratch::Algorithm::StringCompareCi(prop, "NamePossessive") == 0 ||
-	    Scratch::Algorithm::StringCompareCi(prop, "RawNamePossessive") == 0) {
-	if (!instance)
-	    return "<Invalid>";
-	if (isMe)
-	    return "your";
-	return MakeNamePossessive(ResolveName(instance));
-    }
-    if (Scratch::Algorithm::StringCompareCi(prop, "Copula") == 0 ||
-	    Scratch::Algorithm::StringCompareCi(prop, "RawCopula") == 0) {
-	if (!instance)
-	    return "<Invalid>";
-	if (isMe)
-	    return "are";
-	return Gender::GetCopula(gender);
-    }
-    if (Scratch::Algorithm::StringCompareCi(prop, "Determiner") == 0 ||
-	    Scratch::Algorithm::StringCompareCi(prop, "RawDeterminer") == 0) {
-	if (!instance)
-	    return "<Invalid>";
-	if (isMe)
-	    return "your";
-	return Gender::GetDeterminer(gender);
-    }
-    if (Scratch::Algorithm::StringCompareCi(prop, "Subject") == 0 ||
-	    Scratch::Algorithm::StringCompareCi(prop, "RawSubject") == 0) {
-	if (!instance)
-	    return "<Invalid>";
-	if (isMe)
-	    return "you";
-	return Gender::GetSubject(gender);
-    }
-    if (Scratch::Algorithm::StringCompareCi(prop, "Object") == 0 ||
-	    Scratch::Algorithm::StringCompareCi(prop, "RawObject") == 0) {
-	if (!instance)
-	    return "<Invalid>";
-	if (isMe)
-	    return "you";
-	return Gender::GetObject(gender);
-    }
-    if (Scratch::Algorithm::StringCompareCi(prop, "Possessive") == 0 ||
-	    Scratch::Algorithm::StringCompareCi(prop, "RawPossessive") == 0) {
-	if (!instance)
-	    return "<Invalid>";
-	if (isMe)
-	    return "yours";
-	return Gender::GetPossessive(gender);
-    }
-    if (Scratch::Algorithm::StringCompareCi(prop, "Reflexive") == 0 ||
-	    Scratch::Algorithm::StringCompareCi(prop, "RawReflexive") == 0) {
-	if (!instance)
-	    return "<Invalid>";
-	if (isMe)
-	    return "yourself";
-	return Gender::GetReflexive(gender);
-    }
-    return "<Invalid>";
-}
+//! The number of compiled action templates kept.
+const std::size_t MaxActionTemplates = 256;
 
-//! Resolves a slot letter to a param.
-//! \param slot the slot letter
-//! \param subject the subject slot
-//! \param direct the direct slot
-//! \param indirect the indirect slot
-//! \param extra the extra slot
-//! \return the matched param, or \c nullptr
-const ActionParam* SlotParam(
-	const char slot,
-	const ActionParam& subject,
-	const ActionParam& direct,
-	const ActionParam& indirect,
-	const ActionParam& extra) noexcept {
-    switch (static_cast<char>(
-	    std::toupper(static_cast<unsigned char>(slot)))) {
-    case 'S': return &subject;
-    case 'D': return &direct;
-    case 'I': return &indirect;
-    case 'X': return &extra;
-    default: return nullptr;
-    }
-}
+//! The AutoSay preference symbol.
+const unsigned AutoSayPreference =
+	SymbolTable::Preferences().Intern("AutoSay");
 
-//! Expands one macro side.
-//! \param side the macro side
-//! \param subject the subject slot
-//! \param direct the direct slot
-//! \param indirect the indirect slot
-//! \param extra the extra slot
-//! \param recipient the recipient instance
-String ExpandSide(
-	const String& side,
-	const ActionParam& subject,
-	const ActionParam& direct,
-	const ActionParam& indirect,
-	const ActionParam& extra,
-	const InstancePtr& recipient) {
-    const auto dot = side.find('.');
-    if (dot == String::npos)
-	return side;
-    if (dot == 0 || side.size() < 3)
-	return "<Invalid>";
-    const auto* param = SlotParam(
-	    side[0], subject, direct, indirect, extra);
-    if (!param)
-	return "<Invalid>";
-    const auto prop = side.substr(dot + 1);
-    const bool raw = Scratch::Algorithm::StringStartsWithCi(prop, "Raw");
-    return ResolveProperty(prop, *param, recipient, raw);
-}
+//! The NoRepeat preference symbol.
+const unsigned NoRepeatPreference =
+	SymbolTable::Preferences().Intern("NoRepeat");
 
-//! Expands an action message template.
-//! \param message the message template
-//! \param subject the subject slot
-//! \param direct the direct slot
-//! \param indirect the indirect slot
-//! \param extra the extra slot
-//! \param recipient the recipient instance
-String ExpandMessage(
-	const String& message,
-	const ActionParam& subject,
-	const ActionParam& direct,
-	const ActionParam& indirect,
-	const ActionParam& extra,
-	const InstancePtr& recipient) {
-    String out;
-    out.reserve(message.size());
-    for (std::size_t i = 0; i < message.size(); ++i) {
-	if (message[i] != '$') {
-	    out.push_back(message[i]);
-	    continue;
-	}
-	if (i + 1 >= message.size()) {
-	    out.push_back('$');
-	    continue;
-	}
-	if (message[i + 1] == '$') {
-	    out.push_back('$');
-	    ++i;
-	    continue;
-	}
-	if (message[i + 1] != '{') {
-	    out.push_back('$');
-	    continue;
-	}
-	const std::size_t begin = i + 2;
-	std::size_t end = begin;
-	while (end < message.size() && message[end] != '}')
-	    ++end;
-	if (end >= message.size()) {
-	    out.append(message.substr(i));
-	    break;
-	}
-	const auto body = message.substr(begin, end - begin);
-	const auto colon = body.find(':');
-	String chosen;
-	if (colon == String::npos) {
-	    chosen = body;
-	} else {
-	    const bool youSubject =
-		    subject.GetInstance() && recipient &&
-		    subject.GetInstance() == recipient;
-	    chosen = youSubject ?
-		    body.substr(0, colon) :
-		    body.substr(colon + 1);
-	}
-	out += ExpandSide(
-		chosen, subject, direct, indirect, extra, recipient);
-	i = end;
+//! Gets the keys a command is indexed under.
+//! \param command the command
+//! \return the name and keywords, less any empty ones
+StringSetCi CommandKeys(const Command& command) {
+    StringSetCi keys;
+    const auto name = command.GetName();
+    if (!name.empty())
+	keys.insert(name);
+    for (const auto& keyword: command.GetKeywords()) {
+	if (!keyword.empty())
+	    keys.insert(keyword);
     }
-    return out;
+    return keys;
 }
 
 } // namespace
@@ -314,32 +82,31 @@ void Game::Action(
     if (message.empty() || targets == 0)
 	return;
 
-    std::set<InstancePtr> audience;
-    auto addInstance = [&audience](const ActionParam& param) {
-	if (param.GetInstance())
-	    audience.insert(param.GetInstance());
-    };
-    addInstance(subject);
-    addInstance(direct);
-    addInstance(indirect);
-    addInstance(extra);
-
-    for (auto& d: this->GetDescriptors()) {
-	if (!d || d->Closed())
-	    continue;
-	auto instance = d->GetCharacter();
-	if (instance)
-	    audience.insert(instance);
-    }
+    const auto compiled = this->CompileAction(message);
 
     const auto subjectInstance = subject.GetInstance();
     const auto victInstance = direct.GetInstance() ?
 	    direct.GetInstance() :
 	    (indirect.GetInstance() ? indirect.GetInstance() : InstancePtr());
+    const InstancePtr slots[] = {
+	subject.GetInstance(),
+	direct.GetInstance(),
+	indirect.GetInstance(),
+	extra.GetInstance()
+    };
 
-    for (const auto& recipient: audience) {
-	if (!recipient)
-	    continue;
+    // Bystander text is the same for every onlooker; render it once and
+    // wrap it once per palette, keyed by the color sequences in use.
+    struct Variant {
+	const char* color;
+	const char* normal;
+	String out;
+    };
+    std::vector<Variant> variants;
+    String bystanderText;
+    bool bystanderBit = false;
+
+    auto deliver = [&](const InstancePtr& recipient) {
 	const bool isChar =
 		subjectInstance && recipient == subjectInstance;
 	const bool isVict =
@@ -347,38 +114,91 @@ void Game::Action(
 	const bool isOther = !isChar && !isVict;
 
 	if (isChar && !(targets & ACT_TOCHAR))
-	    continue;
+	    return;
 	if (isVict && !(targets & ACT_TOVICT))
-	    continue;
+	    return;
 	if (isOther && !(targets & ACT_TONOTVICT))
-	    continue;
+	    return;
 
-	auto d = recipient ? recipient->GetDescriptor() : DescriptorPtr();
+	auto d = recipient->GetDescriptor();
 	if (!d || d->Closed())
-	    continue;
+	    return;
 
 	if (isChar && (targets & ACT_NOREPEAT)) {
 	    auto player = recipient->GetPlayer();
-	    if (player && player->HasPreference("NoRepeat")) {
+	    if (player && player->HasPreference(NoRepeatPreference)) {
 		String out;
 		out += d->GetColor(Color::C_OKAY);
 		out += "OK.";
 		out += d->GetColor(Color::C_NORMAL);
 		out += "\r\n";
 		d->Print(out);
-		continue;
+		return;
 	    }
 	}
 
-	this->ActionPerform(
-		metacolor, message, subject, direct, indirect, extra,
-		recipient, *d);
+	// Slot instances see themselves as "you".
+	if (std::find(std::begin(slots), std::end(slots), recipient) !=
+		std::end(slots)) {
+	    this->ActionPerform(
+		    metacolor, *compiled, subject, direct, indirect, extra,
+		    recipient, *d);
+	    return;
+	}
+
+	if (!bystanderBit) {
+	    bystanderText = compiled->Expand(
+		    subject, direct, indirect, extra, recipient);
+	    Scratch::Algorithm::StringCapitalize(bystanderText);
+	    bystanderBit = true;
+	}
+	if (bystanderText.empty())
+	    return;
+
+	const char* color = d->GetColor(metacolor);
+	const char* normal = d->GetColor(Color::C_NORMAL);
+	auto variant = std::find_if(std::begin(variants), std::end(variants),
+	    [color, normal](const Variant& v) {
+		return v.color == color && v.normal == normal;
+	    });
+	if (variant == std::end(variants)) {
+	    String out;
+	    out.reserve(bystanderText.size() + 16);
+	    out += color;
+	    out += bystanderText;
+	    out += normal;
+	    out += "\r\n";
+	    variants.push_back(Variant{color, normal, std::move(out)});
+	    variant = std::prev(std::end(variants));
+	}
+	d->Print(variant->out, Scratch::Net::OUT_ACTION);
+    };
+
+    // Audience walk; a recipient may leave mid-walk and the last member
+    // is swapped into its slot, so only advance past one still there.
+    auto& audience = subjectInstance && subjectInstance->GetAudience() ?
+	    *subjectInstance->GetAudience() : audience_;
+    const auto& members = audience.GetMembers();
+    for (std::size_t n = 0; n < members.size(); ) {
+	auto recipient = members[n];
+	deliver(recipient);
+	if (n < members.size() && members[n] == recipient)
+	    ++n;
+    }
+
+    // Slot instances outside the audience.
+    for (auto it = std::begin(slots); it != std::end(slots); ++it) {
+	if (!*it || audience.Contains(*it))
+	    continue;
+	if (std::find(std::begin(slots), it, *it) != it)
+	    continue;
+	deliver(*it);
     }
 }
 
 //! Expands and prints one action message.
 //! \param metacolor the message metacolor
-//! \param message the message template
+//! \param compiled the compiled message template
 //! \param subject the subject slot
 //! \param direct the direct slot
 //! \param indirect the indirect slot
@@ -388,15 +208,15 @@ void Game::Action(
 //! \sa #Action
 void Game::ActionPerform(
 	const Color::ColorEnum metacolor,
-	const String& message,
+	const ActionTemplate& compiled,
 	const ActionParam& subject,
 	const ActionParam& direct,
 	const ActionParam& indirect,
 	const ActionParam& extra,
 	const InstancePtr& recipient,
 	Descriptor& to) {
-    auto expanded = ExpandMessage(
-	    message, subject, direct, indirect, extra, recipient);
+    auto expanded = compiled.Expand(
+	    subject, direct, indirect, extra, recipient);
     if (expanded.empty())
 	return;
     Scratch::Algorithm::StringCapitalize(expanded);
@@ -406,7 +226,32 @@ void Game::ActionPerform(
     out += expanded;
     out += to.GetColor(Color::C_NORMAL);
     out += "\r\n";
-    to.Print(out);
+
+    // Subject echo is a direct reply; others may shed it under backpressure.
+    const auto actor = subject.GetInstance();
+    to.Print(out, recipient && recipient == actor ?
+	Scratch::Net::OUT_REPLY : Scratch::Net::OUT_ACTION);
+}
+
+//! Compiles an action message template.
+//! \param message the message template
+//! \return the compiled template
+ActionTemplatePtr Game::CompileAction(const String& message) {
+    auto it = actionTemplatesIndex_.find(message);
+    if (it != std::end(actionTemplatesIndex_)) {
+	actionTemplates_.splice(std::begin(actionTemplates_),
+	    actionTemplates_, it->second);
+	return it->second->second;
+    }
+
+    auto compiled = std::make_shared<const ActionTemplate>(message);
+    actionTemplates_.emplace_front(message, compiled);
+    actionTemplatesIndex_[message] = std::begin(actionTemplates_);
+    if (actionTemplates_.size() > MaxActionTemplates) {
+	actionTemplatesIndex_.erase(actionTemplates_.back().first);
+	actionTemplates_.pop_back();
+    }
+    return compiled;
 }
 
 //! Finds a command.
@@ -414,54 +259,91 @@ void Game::ActionPerform(
 //! \param performer the performing instance
 //! \return the matched command, or \c nullptr
 //! \sa Command::Allows(const InstancePtr&) const
-//! \sa #GetCommandsIndex() const
+//! \sa #RebuildCommandIndex()
 CommandPtr Game::FindCommand(
 	const String& word,
 	const InstancePtr& performer) const noexcept {
-    if (word.empty())
-	return nullptr;
-
-    CommandPtr best;
-    std::size_t bestLen = static_cast<std::size_t>(-1);
-    for (auto it = commandsIndex_.lower_bound(word);
-	    it != std::end(commandsIndex_); ++it) {
-	if (!Scratch::Algorithm::StringStartsWithCi(it->first, word))
-	    break;
-	if (!it->second || !it->second->Allows(performer))
-	    continue;
-	if (it->first.size() < bestLen) {
-	    best = it->second;
-	    bestLen = it->first.size();
-	}
+    return commandsTrie_.Find(word, performer);
+}
+
+//! Finds a key of \p command that another command is indexed under.
+//! \param command the command to test
+//! \param owner the indexed command \p command would replace, if any
+//! \return the first conflicting name or keyword, or empty
+//! \sa #IndexCommand(const CommandPtr&)
+String Game::FindCommandConflict(
+	const Command& command,
+	const CommandPtr& owner) const {
+    for (const auto& key: CommandKeys(command)) {
+	auto found = commandsIndex_.find(key);
+	if (found != std::end(commandsIndex_) && found->second &&
+		found->second != owner)
+	    return key;
     }
-    return best;
+    return String();
 }
 
 //! Dispatches a command line.
 //! \param performer the performing instance
 //! \param line the raw input line
+//! \remark Each stage is timed into #GetCommandProfile(); invocations
+//!     over Config::GetSlowCommand() are logged to the Slow topic.
 void Game::DispatchCommand(
 	const InstancePtr& performer,
 	const String& line) {
     if (!performer)
 	return;
 
-    String argument;
-    const auto word = Scratch::Algorithm::StringChopCopy(line, argument);
-    if (word.empty())
+    CommandProfile::Sample sample;
+    auto mark = std::chrono::steady_clock::now();
+    const auto lap = [&mark, &sample](const CommandProfile::Stage stage) {
+	const auto now = std::chrono::steady_clock::now();
+	sample.stages[stage] =
+	    std::chrono::duration_cast<std::chrono::microseconds>(now - mark);
+	mark = now;
+    };
+
+    // Tokenize once; the hook and any social reuse the words.
+    Parser parser;
+    parser.Tokenize(line);
+    const auto token = parser.GetToken(0);
+    if (token.empty())
 	return;
+    const String word(token.data(), token.size());
+    parser.Skip(1);
+    lap(CommandProfile::STAGE_PARSE);
 
+    auto player = performer->GetPlayer();
     auto command = this->FindCommand(word, performer);
     if (!command) {
-	auto player = performer->GetPlayer();
-	if (player && player->HasPreference("AutoSay")) {
+	if (player && player->HasPreference(AutoSayPreference)) {
 	    command = this->GetCommands()->Get("Say");
-	    argument = line;
+	    parser.Tokenize(line);
 	}
     }
+    lap(CommandProfile::STAGE_FIND);
 
     if (command) {
-	this->RunCommandHook(command, performer, argument);
+	auto d = performer->GetDescriptor();
+	const auto outputBytes = d ? d->GetOutputBytes() : 0;
+	this->RunCommandHook(command, performer, parser);
+	lap(CommandProfile::STAGE_EXECUTE);
+	sample.outputBytes = d ? d->GetOutputBytes() - outputBytes : 0;
+
+	const auto name = command->GetName();
+	const auto elapsed = commandProfile_.Record(name, sample);
+	const auto slow = std::chrono::milliseconds(config_->GetSlowCommand());
+	if (slow.count() && elapsed >= slow) {
+	    LOGGER_SLOW() << name << " by "
+		<< (player ? player->GetName() : performer->GetName())
+		<< " took " << elapsed.count() << "us (parse "
+		<< sample.stages[CommandProfile::STAGE_PARSE].count()
+		<< "us, find "
+		<< sample.stages[CommandProfile::STAGE_FIND].count()
+		<< "us, execute "
+		<< sample.stages[CommandProfile::STAGE_EXECUTE].count()
+		<< "us, " << sample.outputBytes << " bytes): " << line;
+	}
 	return;
     }
 
@@ -480,16 +362,31 @@ void Game::DispatchCommand(
 //! \param command the command
 //! \param performer the performing instance
 //! \param line the remainder after the matched word
+//! \sa #RunCommandHook(const CommandPtr&, const InstancePtr&, Parser&)
 void Game::RunCommandHook(
 	const CommandPtr& command,
 	const InstancePtr& performer,
 	const String& line) {
+    Parser parser;
+    parser.Tokenize(line);
+    this->RunCommandHook(command, performer, parser);
+}
+
+//! Runs a command Action Lua hook on an already tokenized line.
+//! \param command the command
+//! \param performer the performing instance
+//! \param parser the line, with the matched word skipped
+//! \remark \c line is the parser's remainder; socials reuse its words.
+void Game::RunCommandHook(
+	const CommandPtr& command,
+	const InstancePtr& performer,
+	Parser& parser) {
     if (!command || !performer)
 	return;
     const auto action = command->GetAction();
     const auto social = command->GetSocial();
     if (action.empty() && social) {
-	this->RunSocial(performer, social, line);
+	this->RunSocial(performer, social, parser);
 	return;
     }
     if (action.empty())
@@ -506,7 +403,7 @@ void Game::RunCommandHook(
     Scripting::CommandBindings::Push(lua, command);
     lua.SetEnv("command");
 
-    lua.PushString(line);
+    lua.PushString(parser.GetRemainder());
     lua.SetEnv("line");
 
     if (auto d = performer->GetDescriptor())
@@ -519,11 +416,25 @@ void Game::RunCommandHook(
 //! \param actor the performing instance
 //! \param social the social templates
 //! \param line the remainder after the matched command word
-//! \sa #RunCommandHook(const CommandPtr&, const InstancePtr&, const String&)
+//! \sa #RunSocial(const InstancePtr&, const SocialPtr&, Parser&)
 void Game::RunSocial(
 	const InstancePtr& actor,
 	const SocialPtr& social,
 	const String& line) {
+    Parser parser;
+    parser.Tokenize(line);
+    this->RunSocial(actor, social, parser);
+}
+
+//! Runs social templates for \p actor on an already tokenized line.
+//! \param actor the performing instance
+//! \param social the social templates
+//! \param parser the line, with the matched word skipped
+//! \sa #RunCommandHook(const CommandPtr&, const InstancePtr&, Parser&)
+void Game::RunSocial(
+	const InstancePtr& actor,
+	const SocialPtr& social,
+	Parser& parser) {
     if (!actor || !social)
 	return;
 
@@ -539,8 +450,7 @@ void Game::RunSocial(
 	d->Print(out);
     };
 
-    Parser parser;
-    if (!parser.Parse(line)) {
+    if (!parser.ParsePhrases(StringSetCi())) {
 	printMiss();
 	return;
     }
@@ -577,11 +487,40 @@ void Game::RunSocial(
 	    direct);
 }
 
-//! Rebuilds the keyword command index.
-//! \throw std::runtime_error on keyword conflicts
+//! Indexes a command under its current name and keywords, replacing
+//! any keys it was indexed under before.
+//! \param command the command
+//! \return \c false on a conflict, leaving the index unchanged
+//! \remark Patches only the affected index and trie entries.
+//! \sa #UnindexCommand(const CommandPtr&)
+bool Game::IndexCommand(const CommandPtr& command) {
+    if (!command)
+	return false;
+    const auto conflict = this->FindCommandConflict(*command, command);
+    if (!conflict.empty()) {
+	LOGGER_ASSERT() << "Command index conflict on key: " << conflict;
+	return false;
+    }
+
+    this->UnindexCommand(command);
+    auto keys = CommandKeys(*command);
+    for (const auto& key: keys) {
+	commandsIndex_[key] = command;
+	commandsTrie_.Insert(key, command);
+    }
+    commandsKeys_[command.get()] = std::move(keys);
+    return true;
+}
+
+//! Rebuilds the keyword command index and abbreviation trie.
+//! \param strict whether a keyword conflict throws; otherwise the
+//!     first command by ID keeps the key and the conflict is logged
+//! \throw std::runtime_error on keyword conflicts when \p strict
 //! \sa #GetCommandsIndex() const
-void Game::RebuildCommandIndex() {
+void Game::RebuildCommandIndex(const bool strict) {
     commandsIndex_.clear();
+    commandsKeys_.clear();
+    commandsTrie_.Clear();
     if (!commands_)
 	return;
 
@@ -589,32 +528,59 @@ void Game::RebuildCommandIndex() {
 	auto command = commands_->Get(id);
 	if (!command)
 	    continue;
-	const auto name = command->GetName();
-	if (name.empty())
-	    continue;
-	auto& slot = commandsIndex_[name];
-	if (slot && slot != command) {
-	    throw std::runtime_error(
-		    "Command index conflict on name: " + name);
-	}
-	slot = command;
-    }
-
-    for (const auto& id: commands_->GetIds()) {
-	auto command = commands_->Get(id);
-	if (!command)
-	    continue;
-	for (const auto& keyword: command->GetKeywords()) {
-	    if (keyword.empty())
-		continue;
-	    auto& slot = commandsIndex_[keyword];
+	// Record only the keys this command holds.
+	StringSetCi keys;
+	for (const auto& key: CommandKeys(*command)) {
+	    auto& slot = commandsIndex_[key];
 	    if (slot && slot != command) {
-		throw std::runtime_error(
-			"Command index conflict on keyword: " + keyword);
+		if (strict) {
+		    throw std::runtime_error(
+			    "Command index conflict on key: " + key);
+		}
+		LOGGER_ASSERT() << "Command index conflict on key: " << key;
+		continue;
 	    }
 	    slot = command;
+	    keys.insert(key);
 	}
+	commandsKeys_[command.get()] = std::move(keys);
+    }
+
+    commandsTrie_.Build(commandsIndex_);
+}
+
+//! Refreshes an indexed command after its keys or permissions change.
+//! \param command the command
+//! \return \c false on a conflict, after rebuilding the index;
+//!     commands not in the index are ignored
+//! \sa #IndexCommand(const CommandPtr&)
+bool Game::ReindexCommand(const CommandPtr& command) {
+    if (!command || commandsKeys_.find(command.get()) == std::end(commandsKeys_))
+	return true;
+    if (this->IndexCommand(command))
+	return true;
+
+    // The command has already changed; rebuild so the index matches it.
+    this->RebuildCommandIndex(false);
+    return false;
+}
+
+//! Drops a command from the keyword index and abbreviation trie.
+//! \param command the command
+//! \sa #IndexCommand(const CommandPtr&)
+void Game::UnindexCommand(const CommandPtr& command) noexcept {
+    if (!command)
+	return;
+    auto found = commandsKeys_.find(command.get());
+    if (found == std::end(commandsKeys_))
+	return;
+    for (const auto& key: found->second) {
+	auto slot = commandsIndex_.find(key);
+	if (slot != std::end(commandsIndex_) && slot->second == command)
+	    commandsIndex_.erase(slot);
+	commandsTrie_.Erase(key, command);
     }
+    commandsKeys_.erase(found);
 }
 
 }; // namespace Core
@@ -19,7 +19,9 @@
 #include <scratch/lua.hpp>
 #include <scratch/player_bindings.hpp>
 #include <scratch/scratch.hpp>
+#include <scratch/server.hpp>
 #include <scratch/state_bindings.hpp>
+#include <scratch/storage_file_multi.hpp>
 #include <scratch/string.hpp>
 #include <scratch/user_bindings.hpp>
 
@@ -45,7 +47,7 @@ static int BroadcastProxy(lua_State* L) {
 
     for (auto& d: game.GetDescriptors()) {
 	if (d && !d->Closed())
-	    d->Print(message);
+	    d->Print(message, Scratch::Net::OUT_BROADCAST);
     }
     return 0;
 }
@@ -65,6 +67,73 @@ static int DescriptorNamesProxy(lua_State* L) {
     return 1;
 }
 
+//! Steps a lua descriptors_in iterator; upvalues are the snapshot of
+//! descriptor names, the position, and the state name.
+//! \param L the \c lua_State
+static int DescriptorsInNext(lua_State* L) {
+    auto& lua = Lua::CheckLua(L);
+    auto& game = Lua::CheckGame(L);
+    const auto stateName = Lua::CheckString(L, lua_upvalueindex(3));
+    auto n = lua_tointeger(L, lua_upvalueindex(2));
+    for (;;) {
+	lua_rawgeti(L, lua_upvalueindex(1), ++n);
+	if (lua_isnil(L, -1))
+	    return 1;
+	auto d = game.GetDescriptor(Lua::CheckString(L, -1));
+	lua_pop(L, 1);
+
+	// Skip descriptors closed or moved on since the snapshot.
+	if (!d || d->Closed() || !d->GetState() ||
+		Scratch::Algorithm::StringCompareCi(
+		    d->GetState()->GetName(), stateName))
+	    continue;
+	lua_pushinteger(L, n);
+	lua_replace(L, lua_upvalueindex(2));
+	DescriptorBindings::Push(lua, std::move(d));
+	return 1;
+    }
+}
+
+//! Handles lua descriptors_in(state); returns an iterator over the
+//! open descriptors in \c state, a State or its name, in name order.
+//! \param L the \c lua_State
+static int DescriptorsInProxy(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "descriptors_in expects 1 argument");
+    auto& lua = Lua::CheckLua(L);
+    auto& game = Lua::CheckGame(L);
+    auto state = lua_type(L, 1) == LUA_TSTRING ?
+	game.GetStates()->Get(Lua::CheckString(L, 1)) :
+	StateBindings::Check(L, 1);
+    if (!state)
+	return luaL_error(L, "descriptors_in expects a known state");
+
+    // Snapshot from the state index; the walk is O(members).
+    StringSetCi names;
+    for (auto& d: game.GetDescriptorsIn(state))
+	names.insert(d->GetName());
+    auto stateName = state->GetName();
+    state.reset();
+
+    lua.PushStringSet(std::move(names));
+    lua.PushInt(0);
+    lua.PushString(std::move(stateName));
+    lua_pushcclosure(L, DescriptorsInNext, 3);
+    return 1;
+}
+
+//! Handles lua get_command_profile; returns the per-command dispatch
+//! counters as a formatted table, or an empty string.
+//! \param L the \c lua_State
+static int GetCommandProfileProxy(lua_State* L) {
+    if (lua_gettop(L) != 0)
+	return luaL_error(L, "get_command_profile expects no arguments");
+
+    auto& lua = Lua::CheckLua(L);
+    lua.PushString(lua.GetGame().GetCommandProfile().Format());
+    return 1;
+}
+
 //! Handles lua get_config.
 //! \param L the \c lua_State
 static int GetConfigProxy(lua_State* L) {
@@ -150,6 +219,60 @@ static int GetUsersProxy(lua_State* L) {
     return 1;
 }
 
+//! Handles lua get_pulse; returns the pulse count, the last and worst
+//! lag in milliseconds, and the number of dropped pulses.
+//! \param L the \c lua_State
+static int GetPulseProxy(lua_State* L) {
+    if (lua_gettop(L) != 0)
+	return luaL_error(L, "get_pulse expects no arguments");
+
+    auto& lua = Lua::CheckLua(L);
+    const auto& pulse = Lua::CheckGame(L).GetPulse();
+    lua.PushInt(static_cast<lua_Integer>(pulse.GetCount()));
+    lua.PushNumber(pulse.GetLag().count() / 1000.0);
+    lua.PushNumber(pulse.GetMaxLag().count() / 1000.0);
+    lua.PushInt(static_cast<lua_Integer>(pulse.GetDropped()));
+    return 4;
+}
+
+//! Handles lua on_instance_pulse(name, every, source); an empty source
+//! erases. The source runs once per instance on a shard's worker state.
+//! \param L the \c lua_State
+static int OnInstancePulseProxy(lua_State* L) {
+    if (lua_gettop(L) != 3)
+	return luaL_error(L, "on_instance_pulse expects 3 arguments");
+    luaL_checktype(L, 1, LUA_TSTRING);
+    const auto every = luaL_checkinteger(L, 2);
+    luaL_checktype(L, 3, LUA_TSTRING);
+    if (every < 1 ||
+	    every > static_cast<lua_Integer>(std::numeric_limits<unsigned>::max()))
+	return luaL_error(L, "on_instance_pulse expects a positive interval");
+
+    const auto name = Lua::CheckString(L, 1);
+    const auto source = Lua::CheckString(L, 3);
+    Lua::CheckGame(L).SetInstancePulseHook(
+	name, static_cast<unsigned>(every), source);
+    return 0;
+}
+
+//! Handles lua on_pulse(name, every, source); an empty source erases.
+//! \param L the \c lua_State
+static int OnPulseProxy(lua_State* L) {
+    if (lua_gettop(L) != 3)
+	return luaL_error(L, "on_pulse expects 3 arguments");
+    luaL_checktype(L, 1, LUA_TSTRING);
+    const auto every = luaL_checkinteger(L, 2);
+    luaL_checktype(L, 3, LUA_TSTRING);
+    if (every < 1 ||
+	    every > static_cast<lua_Integer>(std::numeric_limits<unsigned>::max()))
+	return luaL_error(L, "on_pulse expects a positive interval");
+
+    const auto name = Lua::CheckString(L, 1);
+    const auto source = Lua::CheckString(L, 3);
+    Lua::CheckGame(L).SetPulseHook(name, static_cast<unsigned>(every), source);
+    return 0;
+}
+
 //! Handles lua print — writes to LOGGER_LUA.
 //! \param L the \c lua_State
 static int PrintProxy(lua_State* L) {
@@ -168,6 +291,30 @@ static int PrintProxy(lua_State* L) {
     return 0;
 }
 
+//! Handles lua reload_bans; returns whether the ban list loaded.
+//! \param L the \c lua_State
+static int ReloadBansProxy(lua_State* L) {
+    if (lua_gettop(L) != 0)
+	return luaL_error(L, "reload_bans expects no arguments");
+
+    auto& lua = Lua::CheckLua(L);
+    auto& admission = Lua::CheckGame(L).GetServer().GetAdmission();
+    const auto loaded = admission.LoadBans();
+    lua.PushBool(loaded);
+    lua.PushInt(static_cast<lua_Integer>(admission.GetBanCount()));
+    return 2;
+}
+
+//! Handles lua reset_command_profile.
+//! \param L the \c lua_State
+static int ResetCommandProfileProxy(lua_State* L) {
+    if (lua_gettop(L) != 0)
+	return luaL_error(L, "reset_command_profile expects no arguments");
+
+    Lua::CheckGame(L).GetCommandProfile().Clear();
+    return 0;
+}
+
 //! Handles lua shutdown.
 //! \param L the \c lua_State
 static int ShutdownProxy(lua_State* L) {
@@ -178,6 +325,16 @@ static int ShutdownProxy(lua_State* L) {
     return 0;
 }
 
+//! Handles lua copyover.
+//! \param L the \c lua_State
+static int CopyoverProxy(lua_State* L) {
+    if (lua_gettop(L) != 0)
+	return luaL_error(L, "copyover expects no arguments");
+
+    Lua::CheckGame(L).Copyover();
+    return 0;
+}
+
 //! Handles lua crypt(plaintext [, salt]).
 //! \param L the \c lua_State
 static int CryptProxy(lua_State* L) {
@@ -201,10 +358,16 @@ static int CryptProxy(lua_State* L) {
 void GameBindings::Register(Lua& lua) {
     lua.PushFunction(BroadcastProxy);
     lua.SetSafe("broadcast");
+    lua.PushFunction(CopyoverProxy);
+    lua.SetSafe("copyover");
     lua.PushFunction(CryptProxy);
     lua.SetSafe("crypt");
+    lua.PushFunction(DescriptorsInProxy);
+    lua.SetSafe("descriptors_in");
     lua.PushFunction(EraseInstanceProxy);
     lua.SetSafe("erase_instance");
+    lua.PushFunction(GetCommandProfileProxy);
+    lua.SetSafe("get_command_profile");
     lua.PushFunction(GetConfigProxy);
     lua.SetSafe("get_config");
     lua.PushFunction(GetDescriptorProxy);
@@ -217,12 +380,22 @@ void GameBindings::Register(Lua& lua) {
     lua.SetSafe("get_instance_for");
     lua.PushFunction(GetPlayersProxy);
     lua.SetSafe("get_players");
+    lua.PushFunction(GetPulseProxy);
+    lua.SetSafe("get_pulse");
     lua.PushFunction(GetStatesProxy);
     lua.SetSafe("get_states");
     lua.PushFunction(GetUsersProxy);
     lua.SetSafe("get_users");
+    lua.PushFunction(OnInstancePulseProxy);
+    lua.SetSafe("on_instance_pulse");
+    lua.PushFunction(OnPulseProxy);
+    lua.SetSafe("on_pulse");
     lua.PushFunction(PrintProxy);
     lua.SetSafe("print");
+    lua.PushFunction(ReloadBansProxy);
+    lua.SetSafe("reload_bans");
+    lua.PushFunction(ResetCommandProfileProxy);
+    lua.SetSafe("reset_command_profile");
     lua.PushFunction(ShutdownProxy);
     lua.SetSafe("shutdown");
 }
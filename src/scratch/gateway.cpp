@@ -0,0 +1,302 @@
+//! \file gateway.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_GATEWAY_CPP_
+
+#include <scratch/admission.hpp>
+#include <scratch/game.hpp>
+#include <scratch/gateway.hpp>
+#include <scratch/logger.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/transport_gateway.hpp>
+
+namespace Scratch {
+namespace Net {
+
+// Boost types.
+using ErrorCode = boost::system::error_code;
+using LocalEndpoint = boost::asio::local::stream_protocol::endpoint;
+
+//! Constructor.
+//! \param game the game state
+//! \param admission the connection admission control
+Gateway::Gateway(
+	Game& game,
+	Admission& admission) noexcept :
+	acceptor_(game.GetIoContext()),
+	admission_(admission),
+	channel_(game.GetIoContext()),
+	channelSerial_(0),
+	game_(game),
+	input_(),
+	output_(),
+	outputHandlers_(),
+	path_(),
+	reader_(),
+	sessions_(),
+	writePending_(false),
+	writing_(),
+	writingHandlers_() {
+    // Nothing.
+}
+
+//! Destructor.
+Gateway::~Gateway() noexcept {
+    this->Stop();
+}
+
+//! Drops a session from the session table.
+//! \param session the session ID
+void Gateway::EraseSession(const std::uint32_t session) noexcept {
+    sessions_.erase(session);
+}
+
+//! Queues frames for the gateway.
+//! \param type the frame type
+//! \param session the session ID
+//! \param data the payload
+//! \param nBytes the size of \p data
+//! \param handler called with \p nBytes once the frames reach the
+//!     channel, or with an error if the channel is lost first
+void Gateway::Send(
+	const GatewayFrameType type,
+	const std::uint32_t session,
+	const char* data,
+	const std::size_t nBytes,
+	Transport::Handler handler) {
+    if (!channel_.is_open()) {
+	if (handler) {
+	    boost::asio::post(game_.GetIoContext(), [handler]() {
+		handler(boost::asio::error::not_connected, 0);
+	    });
+	}
+	return;
+    }
+
+    AppendGatewayFrames(output_, type, session, data, nBytes);
+    if (handler)
+	outputHandlers_.emplace_back(std::move(handler), nBytes);
+    this->InitAsyncWrite();
+}
+
+//! Listens for the gateway.
+//! \param path the Unix socket path
+//! \remark Removes a stale socket file left at \p path.
+//! \sa #Stop()
+void Gateway::Start(const String& path) {
+    path_ = path;
+    ::unlink(path_.c_str());
+
+    // Configure acceptor.
+    const LocalEndpoint endpoint(path_);
+    acceptor_.open(endpoint.protocol());
+    acceptor_.bind(endpoint);
+    acceptor_.listen();
+
+    LOGGER_NETWORK() << "Server listening for the gateway on " << path_ << ".";
+
+    // Accept the gateway.
+    this->InitAsyncAccept();
+}
+
+//! Stops listening and closes the channel and every session.
+//! \sa #Start(const String&)
+void Gateway::Stop() {
+    if (acceptor_.is_open()) {
+	ErrorCode errorCode;
+	acceptor_.close(errorCode);
+	::unlink(path_.c_str());
+    }
+    this->CloseChannel();
+}
+
+//! Closes the channel and tells every session its client is gone.
+void Gateway::CloseChannel() {
+    // Completions still queued for the old channel see a new serial.
+    ++channelSerial_;
+    if (channel_.is_open()) {
+	ErrorCode errorCode;
+	channel_.close(errorCode);
+    }
+    reader_.Reset();
+
+    // The write in flight, if any, completes with operation_aborted.
+    output_.clear();
+    auto handlers = std::move(outputHandlers_);
+    outputHandlers_.clear();
+    for (auto& pending: handlers) {
+	auto& handler = pending.first;
+	boost::asio::post(game_.GetIoContext(), [handler]() {
+	    handler(boost::asio::error::operation_aborted, 0);
+	});
+    }
+
+    // Each descriptor reads eof and closes itself.
+    auto sessions = std::move(sessions_);
+    sessions_.clear();
+    for (auto& entry: sessions)
+	entry.second->ReceiveClose();
+}
+
+//! Configures an asynchronous accept.
+void Gateway::InitAsyncAccept() {
+    const auto self = this->shared_from_this();
+    acceptor_.async_accept([self](ErrorCode ec, LocalSocket&& s) {
+	if (ec || self->game_.GetShutdown()) {
+	    if (ec && ec != boost::asio::error::operation_aborted) {
+		LOGGER_NETWORK() << "Error accepting gateway.";
+		LOGGER_NETWORK() << " >> " << ec;
+		LOGGER_NETWORK() << " >> " << ec.message();
+	    }
+	    return;
+	}
+
+	// The gateway reopens its sessions on the new channel.
+	if (self->channel_.is_open()) {
+	    LOGGER_NETWORK() << "Gateway reconnected; dropping " << self->sessions_.size() << " session(s) on the old channel.";
+	    self->CloseChannel();
+	}
+	self->channel_ = std::move(s);
+	LOGGER_NETWORK() << "Gateway connected.";
+
+	self->InitAsyncRead();
+	self->InitAsyncAccept();
+    });
+}
+
+//! Configures an asynchronous channel read.
+void Gateway::InitAsyncRead() {
+    const auto self = this->shared_from_this();
+    const auto serial = channelSerial_;
+    channel_.async_read_some(boost::asio::buffer(input_),
+	[self, serial](const ErrorCode& errorCode, std::size_t nBytes) {
+	    if (serial != self->channelSerial_)
+		return;
+	    if (errorCode) {
+		if (errorCode != boost::asio::error::eof &&
+			errorCode != boost::asio::error::operation_aborted) {
+		    LOGGER_NETWORK() << "Error reading gateway.";
+		    LOGGER_NETWORK() << " >> " << errorCode;
+		    LOGGER_NETWORK() << " >> " << errorCode.message();
+		}
+		LOGGER_NETWORK() << "Gateway disconnected.";
+		self->CloseChannel();
+		return;
+	    }
+
+	    // Dispatch every complete frame.
+	    self->reader_.Feed(self->input_, nBytes);
+	    GatewayFrame frame;
+	    while (serial == self->channelSerial_ && self->reader_.Next(frame))
+		self->OnFrame(frame);
+	    if (serial != self->channelSerial_)
+		return;
+	    if (self->reader_.IsFailed()) {
+		LOGGER_NETWORK() << "Gateway sent a malformed frame; disconnecting.";
+		self->CloseChannel();
+		return;
+	    }
+
+	    // Configure asynchronous read.
+	    if (!self->game_.GetShutdown())
+		self->InitAsyncRead();
+	});
+}
+
+//! Configures an asynchronous channel write.
+void Gateway::InitAsyncWrite() {
+    if (writePending_ || output_.empty() || !channel_.is_open())
+	return;
+
+    writePending_ = true;
+    writing_.swap(output_);
+    writingHandlers_.swap(outputHandlers_);
+    const auto self = this->shared_from_this();
+    const auto serial = channelSerial_;
+    boost::asio::async_write(channel_, boost::asio::buffer(writing_),
+	[self, serial](const ErrorCode& errorCode, std::size_t) {
+	    self->writePending_ = false;
+	    self->writing_.clear();
+
+	    // Handlers may queue more frames; they land in output_.
+	    auto handlers = std::move(self->writingHandlers_);
+	    self->writingHandlers_.clear();
+	    for (auto& pending: handlers)
+		pending.first(errorCode, errorCode ? 0 : pending.second);
+
+	    if (errorCode && serial == self->channelSerial_) {
+		if (errorCode != boost::asio::error::operation_aborted) {
+		    LOGGER_NETWORK() << "Error writing gateway.";
+		    LOGGER_NETWORK() << " >> " << errorCode;
+		    LOGGER_NETWORK() << " >> " << errorCode.message();
+		}
+		self->CloseChannel();
+		return;
+	    }
+
+	    // Continue draining, possibly to a channel accepted since.
+	    self->InitAsyncWrite();
+	});
+}
+
+//! Dispatches one frame from the gateway.
+//! \param frame the frame
+void Gateway::OnFrame(const GatewayFrame& frame) {
+    switch (static_cast<int>(frame.type)) {
+    case GATEWAY_OPEN:
+	this->OpenSession(frame.session, frame.payload);
+	break;
+    case GATEWAY_DATA: {
+	auto it = sessions_.find(frame.session);
+	if (it != sessions_.end())
+	    it->second->Receive(frame.payload.data(), frame.payload.size());
+	break;
+    }
+    case GATEWAY_CLOSE: {
+	auto it = sessions_.find(frame.session);
+	if (it == sessions_.end())
+	    break;
+	auto* transport = it->second;
+	sessions_.erase(it);
+	transport->ReceiveClose();
+	break;
+    }
+    default:
+	LOGGER_NETWORK() << "Gateway sent unexpected frame type " << static_cast<unsigned>(frame.type) << ".";
+	break;
+    }
+}
+
+//! Screens a new session and builds its descriptor.
+//! \param session the session ID
+//! \param addressText the remote address reported by the gateway
+void Gateway::OpenSession(
+	const std::uint32_t session,
+	const String& addressText) {
+    if (sessions_.count(session)) {
+	LOGGER_NETWORK() << "Gateway reopened live session " << session << ".";
+	return;
+    }
+
+    // Screen session before building a descriptor.
+    ErrorCode errorCode;
+    const auto address = boost::asio::ip::make_address(addressText, errorCode);
+    if (errorCode || admission_.Admit(address) != Admission::ADMIT) {
+	this->Send(GATEWAY_CLOSE, session);
+	return;
+    }
+
+    LOGGER_NETWORK() << "Received gateway session " << session << " from " << address << ".";
+    auto transport = std::make_unique<GatewayTransport>(game_.GetIoContext(),
+	this->shared_from_this(), session, address);
+    sessions_[session] = transport.get();
+    game_.MakeDescriptor(std::move(transport));
+}
+
+}; // namespace Net
+}; // namespace Scratch
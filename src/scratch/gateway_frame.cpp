@@ -0,0 +1,124 @@
+//! \file gateway_frame.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_GATEWAY_FRAME_CPP_
+
+#include <scratch/gateway_frame.hpp>
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Net {
+
+namespace {
+
+//! Appends a big-endian 32-bit value.
+//! \param output the encoded stream
+//! \param value the value
+void PutUint32(
+	String& output,
+	const std::uint32_t value) {
+    output.push_back(static_cast<char>((value >> 24) & 0xff));
+    output.push_back(static_cast<char>((value >> 16) & 0xff));
+    output.push_back(static_cast<char>((value >> 8) & 0xff));
+    output.push_back(static_cast<char>(value & 0xff));
+}
+
+//! Reads a big-endian 32-bit value.
+//! \param data the first of four bytes
+std::uint32_t GetUint32(const char* data) noexcept {
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(data);
+    return (static_cast<std::uint32_t>(bytes[0]) << 24) |
+	(static_cast<std::uint32_t>(bytes[1]) << 16) |
+	(static_cast<std::uint32_t>(bytes[2]) << 8) |
+	static_cast<std::uint32_t>(bytes[3]);
+}
+
+} // namespace
+
+//! Appends frames carrying \p data to \p output, splitting \p data at
+//! #GatewayMaxPayload.
+//! \param output the encoded stream
+//! \param type the frame type
+//! \param session the session ID
+//! \param data the payload
+//! \param nBytes the size of \p data
+void AppendGatewayFrames(
+	String& output,
+	const GatewayFrameType type,
+	const std::uint32_t session,
+	const char* data,
+	const std::size_t nBytes) {
+    std::size_t offset = 0;
+    do {
+	const auto n = std::min(nBytes - offset, GatewayMaxPayload);
+	output.push_back(static_cast<char>(type));
+	PutUint32(output, session);
+	PutUint32(output, static_cast<std::uint32_t>(n));
+	if (n)
+	    output.append(data + offset, n);
+	offset += n;
+    } while (offset < nBytes);
+}
+
+//! Default constructor.
+GatewayFrameReader::GatewayFrameReader() noexcept :
+	buffer_(),
+	failed_(false),
+	position_(0) {
+    // Nothing.
+}
+
+//! Appends bytes read from the channel.
+//! \param data the bytes
+//! \param nBytes the number of bytes
+void GatewayFrameReader::Feed(
+	const char* data,
+	const std::size_t nBytes) {
+    // Drop decoded bytes before growing the buffer.
+    if (position_) {
+	buffer_.erase(0, position_);
+	position_ = 0;
+    }
+    buffer_.append(data, nBytes);
+}
+
+//! Decodes the next complete frame.
+//! \param frame set to the frame
+//! \return \c false if no complete frame is buffered or the stream is
+//!     malformed
+bool GatewayFrameReader::Next(GatewayFrame& frame) {
+    if (failed_ || buffer_.size() - position_ < GatewayHeaderSize)
+	return false;
+
+    const auto* header = buffer_.data() + position_;
+    const auto type = static_cast<std::uint8_t>(header[0]);
+    const auto length = GetUint32(header + 5);
+    if (type < GATEWAY_OPEN || type > GATEWAY_CORK ||
+	    length > GatewayMaxPayload) {
+	failed_ = true;
+	return false;
+    }
+    if (buffer_.size() - position_ - GatewayHeaderSize < length)
+	return false;
+
+    frame.type = static_cast<GatewayFrameType>(type);
+    frame.session = GetUint32(header + 1);
+    frame.payload.assign(header + GatewayHeaderSize, length);
+    position_ += GatewayHeaderSize + length;
+    return true;
+}
+
+//! Discards buffered bytes and clears the failure flag.
+void GatewayFrameReader::Reset() noexcept {
+    buffer_.clear();
+    failed_ = false;
+    position_ = 0;
+}
+
+}; // namespace Net
+}; // namespace Scratch
@@ -19,13 +19,13 @@ namespace Core {
 //! \param name the gender name
 //! \sa #ToString(GenderEnum)
 Gender::GenderEnum Gender::ByName(const String& name) noexcept {
-    static StringMapCi<GenderEnum> genders;
-    if (genders.empty()) {
-	genders["Common"] = GENDER_COMMON;
-	genders["Female"] = GENDER_FEMALE;
-	genders["Male"] = GENDER_MALE;
-	genders["Neuter"] = GENDER_NEUTER;
-    }
+    // Initialized once, so pulse worker threads may look genders up.
+    static const StringUnorderedMapCi<GenderEnum> genders = {
+	{"Common", GENDER_COMMON},
+	{"Female", GENDER_FEMALE},
+	{"Male", GENDER_MALE},
+	{"Neuter", GENDER_NEUTER},
+    };
 
     auto const found = genders.find(name);
     if (found != genders.end())
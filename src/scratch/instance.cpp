@@ -22,8 +22,12 @@ namespace Core {
 //! Default constructor.
 Instance::Instance() noexcept :
 	std::enable_shared_from_this<Instance>(),
+	audience_(nullptr),
+	audienceSlot_(0),
 	descriptor_(),
+	game_(nullptr),
 	gender_(Gender::GENDER_UNDEFINED),
+	handle_(0),
 	name_(),
 	player_() {
     // Nothing.
@@ -33,10 +37,14 @@ Instance::Instance() noexcept :
 //! \param other the \sa instance to copy
 Instance::Instance(const Instance& other) noexcept :
 	std::enable_shared_from_this<Instance>(),
+	audience_(nullptr),
+	audienceSlot_(0),
 	descriptor_(),
-	gender_(other.gender_),
-	name_(other.name_),
-	player_(other.player_) {
+	game_(nullptr),
+	gender_(other.GetGender()),
+	handle_(0),
+	name_(other.GetName()),
+	player_(other.GetPlayer()) {
     // Nothing.
 }
 
@@ -48,12 +56,52 @@ Instance::~Instance() noexcept {
 //! Default assignment.
 //! \param other the \sa instance to assign
 Instance& Instance::operator=(const Instance& other) noexcept {
-    gender_ = other.gender_;
-    name_ = other.name_;
-    player_ = other.player_;
+    if (this == &other)
+	return *this;
+    this->GetField(name_) = other.GetName();
+    this->SetPlayer(other.GetPlayer());
+    this->GetField(gender_) = other.GetGender();
     return *this;
 }
 
+//! Gets a field from its store column while registered.
+//! \param detached the member holding it while unregistered
+//! \return the column entry, or \p detached
+template <typename T>
+const T& Instance::GetField(const T& detached) const noexcept {
+    if (game_) {
+	if (auto field = game_->GetInstanceStore().Find<T>(handle_))
+	    return *field;
+    }
+    return detached;
+}
+
+//! Gets a field from its store column while registered.
+//! \param detached the member holding it while unregistered
+//! \return the column entry, or \p detached
+template <typename T>
+T& Instance::GetField(T& detached) noexcept {
+    if (game_) {
+	if (auto field = game_->GetInstanceStore().Find<T>(handle_))
+	    return *field;
+    }
+    return detached;
+}
+
+//! Moves the fields out of the store columns and unregisters.
+//! \remark Called by the game just before the store entry is erased.
+//! \sa Game::EraseInstance(const InstancePtr&)
+void Instance::Detach() noexcept {
+    if (!game_)
+	return;
+    descriptor_ = std::move(this->GetField(descriptor_));
+    gender_ = this->GetField(gender_);
+    name_ = std::move(this->GetField(name_));
+    player_ = std::move(this->GetField(player_));
+    game_ = nullptr;
+    handle_ = 0;
+}
+
 //! Finds an instance matching \p line.
 //! \param game the game state
 //! \param line the targeting line
@@ -80,40 +128,61 @@ InstancePtr Instance::Find(
 	return nullptr;
     const auto count = phrase.GetCount();
     const auto nth = phrase.GetNth();
-    const auto& words = phrase.GetWords();
-    if (!nth || words.empty())
+    if (!nth || !phrase.GetWordCount())
 	return nullptr;
 
+    // Short words fit in the string's inline buffer, so these copies
+    // of the phrase's views do not touch the heap.
+    boost::container::small_vector<String, 4> words;
+    for (std::size_t n = 0; n < phrase.GetWordCount(); ++n) {
+	const auto word = phrase.GetWord(n);
+	words.emplace_back(word.data(), word.size());
+    }
+
     auto seeker = std::const_pointer_cast<Instance>(this->shared_from_this());
 
-    // Shortcuts: one name, count 1, nth 1.
+    // Shortcut: one name, count 1, nth 1.
     if (words.size() == 1 && count == 1 && nth == 1) {
 	const auto& name = words.front();
 	if (!Scratch::Algorithm::StringCompareCi(name, "me") ||
 		!Scratch::Algorithm::StringCompareCi(name, "self")) {
 	    return seeker;
 	}
-	if (!name.empty() && name.front() == '%') {
-	    auto instance = game.GetInstance(name.substr(1));
-	    if (!instance || !instance->Matches(seeker, name))
-		return nullptr;
-	    return instance;
-	}
     }
 
-    unsigned found = 0;
-    for (auto& instance: game.GetInstances()) {
-	if (!instance)
-	    continue;
-	auto matched = true;
+    auto matches = [&seeker, &words](const InstancePtr& instance) {
 	for (const auto& name: words) {
-	    if (!instance->Matches(seeker, name)) {
-		matched = false;
-		break;
-	    }
+	    if (!instance->Matches(seeker, name))
+		return false;
 	}
-	if (matched && ++found == nth)
-	    return instance;
+	return true;
+    };
+
+    // Handle words name one instance directly.
+    for (const auto& name: words) {
+	if (name.empty() || name.front() != '%')
+	    continue;
+	auto instance = game.GetInstance(name.substr(1));
+	if (!instance || !matches(instance) || nth != 1)
+	    return nullptr;
+	return instance;
+    }
+
+    // Keyword words are name prefixes; walk the run for the longest.
+    const auto& longest = *std::max_element(std::begin(words), std::end(words),
+	[](const String& a, const String& b) {
+	    return a.size() < b.size();
+	});
+    if (longest.empty())
+	return nullptr;
+    const auto& index = game.GetInstancesIndex();
+    unsigned found = 0;
+    for (auto it = index.lower_bound(longest);
+	    it != std::end(index); ++it) {
+	if (!Scratch::Algorithm::StringStartsWithCi(it->first, longest))
+	    break;
+	if (matches(it->second) && ++found == nth)
+	    return it->second;
     }
     return nullptr;
 }
@@ -121,15 +190,34 @@ InstancePtr Instance::Find(
 //! Gets the controlling descriptor.
 //! \sa #SetDescriptor(const DescriptorPtr&)
 DescriptorPtr Instance::GetDescriptor() noexcept {
-    auto d = descriptor_.lock();
+    auto& descriptor = this->GetField(descriptor_);
+    auto d = descriptor.lock();
     if (!d || d->Closed() || d->GetCharacter().get() != this) {
 	// Stale control link.
-	descriptor_.reset();
+	descriptor.reset();
 	return nullptr;
     }
     return d;
 }
 
+//! Gets the gender.
+//! \sa #SetGender(Gender::GenderEnum)
+Gender::GenderEnum Instance::GetGender() const noexcept {
+    return this->GetField(gender_);
+}
+
+//! Gets the instance name.
+//! \sa #SetName(const String&)
+String Instance::GetName() const noexcept {
+    return this->GetField(name_);
+}
+
+//! Gets the player.
+//! \sa #SetPlayer(const PlayerPtr&)
+PlayerPtr Instance::GetPlayer() const noexcept {
+    return this->GetField(player_);
+}
+
 //! Matches \p name against this instance.
 //! \param seeker the searching instance, or null
 //! \param name the name
@@ -145,11 +233,11 @@ bool Instance::Matches(
 	const auto id = name.substr(1);
 	if (id.empty())
 	    return false;
-	return !Scratch::Algorithm::StringCompareCi(name_, id);
+	return !Scratch::Algorithm::StringCompareCi(this->GetField(name_), id);
     }
 
-    if (player_) {
-	const auto playerName = player_->GetName();
+    if (const auto& player = this->GetField(player_)) {
+	const auto playerName = player->GetName();
 	return Scratch::Algorithm::StringStartsWithCi(playerName, name);
     }
 
@@ -168,24 +256,36 @@ bool Instance::Matches(const String& name) const noexcept {
 //! \param descriptor the descriptor, or null to clear
 //! \sa #GetDescriptor()
 void Instance::SetDescriptor(const DescriptorPtr& descriptor) noexcept {
-    descriptor_ = descriptor;
+    this->GetField(descriptor_) = descriptor;
 }
 
 //! Sets the gender.
 //! \param gender the gender
 //! \sa #GetGender() const
 void Instance::SetGender(Gender::GenderEnum gender) noexcept {
-    gender_ = gender;
-    if (player_)
-	player_->SetGender(gender);
+    this->GetField(gender_) = gender;
+    if (const auto& player = this->GetField(player_))
+	player->SetGender(gender);
+}
+
+//! Sets the instance name.
+//! \param name the instance name
+//! \sa #GetName() const
+void Instance::SetName(const String& name) {
+    this->GetField(name_) = name;
 }
 
 //! Sets the player.
 //! \param player the player
 //! \sa #GetPlayer() const
 void Instance::SetPlayer(const PlayerPtr& player) noexcept {
-    player_ = player;
-    gender_ = player_ ? player_->GetGender() : Gender::GENDER_UNDEFINED;
+    auto& current = this->GetField(player_);
+    auto previous = current;
+    current = player;
+    this->GetField(gender_) =
+	player ? player->GetGender() : Gender::GENDER_UNDEFINED;
+    if (game_ && previous != player)
+	game_->ReindexPlayer(this->shared_from_this(), previous);
 }
 
 }; // namespace Core
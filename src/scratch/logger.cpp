@@ -14,6 +14,9 @@
 namespace Scratch {
 namespace Utility {
 
+//! Serializes output from pulse worker threads.
+static std::mutex loggerMutex;
+
 //! Default constructor.
 Logger::Logger() noexcept :
 	buffer_(),
@@ -25,6 +28,8 @@ Logger::Logger() noexcept :
 
 //! Destructor.
 Logger::~Logger() noexcept {
+    std::lock_guard<std::mutex> lock(loggerMutex);
+
     // Print current time.
     auto now = boost::chrono::system_clock::now();
     auto nowc = boost::chrono::system_clock::to_time_t(now);
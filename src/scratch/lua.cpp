@@ -23,6 +23,7 @@
 #include <scratch/parser_bindings.hpp>
 #include <scratch/player_bindings.hpp>
 #include <scratch/scratch.hpp>
+#include <scratch/shard_bindings.hpp>
 #include <scratch/state_bindings.hpp>
 #include <scratch/string.hpp>
 #include <scratch/user_bindings.hpp>
@@ -69,7 +70,10 @@ Lua::Caller::~Caller() {
 
 //! Constructor.
 //! \param game the game state
-Lua::Lua(Game& game) :
+//! \param bindings the binding set to register
+Lua::Lua(
+	Game& game,
+	const Bindings bindings) :
 	callers_(),
 	envs_(),
 	executeDepth_(32),
@@ -103,19 +107,24 @@ Lua::Lua(Game& game) :
 
     this->InitSafe();
 
-    ColorBindings::Register(*this);
-    CommandBindings::Register(*this);
-    ConfigBindings::Register(*this);
-    DescriptorBindings::Register(*this);
-    EditorBindings::Register(*this);
-    EnumerationBindings::Register(*this);
-    GameBindings::Register(*this);
-    GenderBindings::Register(*this);
-    InstanceBindings::Register(*this);
-    ParserBindings::Register(*this);
-    PlayerBindings::Register(*this);
-    StateBindings::Register(*this);
-    UserBindings::Register(*this);
+    if (bindings == BINDINGS_SHARD) {
+	// Nothing here may touch game state; effects are deferred.
+	ShardBindings::Register(*this);
+    } else {
+	ColorBindings::Register(*this);
+	CommandBindings::Register(*this);
+	ConfigBindings::Register(*this);
+	DescriptorBindings::Register(*this);
+	EditorBindings::Register(*this);
+	EnumerationBindings::Register(*this);
+	GameBindings::Register(*this);
+	GenderBindings::Register(*this);
+	InstanceBindings::Register(*this);
+	ParserBindings::Register(*this);
+	PlayerBindings::Register(*this);
+	StateBindings::Register(*this);
+	UserBindings::Register(*this);
+    }
 
     // Strip loaders from real _G.
     static const char* const denied[] = {
@@ -18,7 +18,8 @@ namespace Core {
 //! Default constructor.
 Parser::Phrase::Phrase() noexcept :
 	count_(1),
-	delimiter_(),
+	delimiter_{0, 0},
+	line_(nullptr),
 	nth_(1),
 	words_() {
     // Nothing.
@@ -29,6 +30,7 @@ Parser::Phrase::Phrase() noexcept :
 Parser::Phrase::Phrase(const Phrase& other) :
 	count_(other.count_),
 	delimiter_(other.delimiter_),
+	line_(other.line_),
 	nth_(other.nth_),
 	words_(other.words_) {
     // Nothing.
@@ -39,14 +41,46 @@ Parser::Phrase::Phrase(const Phrase& other) :
 Parser::Phrase& Parser::Phrase::operator=(const Phrase& other) {
     count_ = other.count_;
     delimiter_ = other.delimiter_;
+    line_ = other.line_;
     nth_ = other.nth_;
     words_ = other.words_;
     return *this;
 }
 
+//! Gets the delimiter that opened this phrase.
+//! \sa #delimiter_
+String Parser::Phrase::GetDelimiter() const {
+    if (!line_)
+	return String();
+    return String(line_ + delimiter_.offset, delimiter_.length);
+}
+
+//! Gets the name word at \p index.
+//! \param index the word index
+//! \return the word, or empty if \p index is out of range
+//! \sa #GetWordCount() const
+StringView Parser::Phrase::GetWord(const std::size_t index) const noexcept {
+    if (index >= words_.size())
+	return StringView();
+    return StringView(line_ + words_[index].offset, words_[index].length);
+}
+
+//! Gets copies of the name words.
+//! \sa #GetWord(const std::size_t) const
+std::vector<String> Parser::Phrase::GetWords() const {
+    std::vector<String> words;
+    words.reserve(words_.size());
+    for (const auto& word: words_)
+	words.emplace_back(line_ + word.offset, word.length);
+    return words;
+}
+
 //! Default constructor.
 Parser::Parser() noexcept :
-	phrases_() {
+	first_(0),
+	line_(nullptr),
+	phrases_(),
+	tokens_() {
     // Nothing.
 }
 
@@ -62,6 +96,27 @@ const Parser::Phrase& Parser::GetPhrase(const std::size_t index) const noexcept
     return phrases_[index];
 }
 
+//! Returns the text from the first unskipped word to the last.
+//! \sa #Skip(const std::size_t)
+String Parser::GetRemainder() const {
+    if (first_ >= tokens_.size())
+	return String();
+    const auto begin = tokens_[first_].offset;
+    const auto end = tokens_.back().offset + tokens_.back().length;
+    return String(line_ + begin, end - begin);
+}
+
+//! Returns the unskipped word at \p index.
+//! \param index the word index
+//! \return the word, or empty if \p index is out of range
+//! \sa #GetTokenCount() const
+StringView Parser::GetToken(const std::size_t index) const noexcept {
+    if (index >= this->GetTokenCount())
+	return StringView();
+    const auto& token = tokens_[first_ + index];
+    return StringView(line_ + token.offset, token.length);
+}
+
 //! Parses \p line with no delimiters.
 //! \param line the targeting line
 //! \return \c true if \p line is valid
@@ -78,103 +133,147 @@ bool Parser::Parse(const String& line) noexcept {
 bool Parser::Parse(
 	const String& line,
 	const StringSetCi& delimiters) noexcept {
-    auto valid = true;
-
-    // Split on whitespace.
-    std::vector<String> tokens;
-    const auto trimmed = boost::trim_copy(line);
-    if (!trimmed.empty())
-	boost::split(tokens, trimmed, boost::is_space(), boost::token_compress_on);
+    this->Tokenize(line);
+    return this->ParsePhrases(delimiters);
+}
 
-    // Accumulate phrases.
-    phrases_.clear();
-    if (!tokens.empty()) {
-	String delimiter;
-	std::vector<String> current;
-	for (const auto& token: tokens) {
-	    if (delimiters.find(token) != delimiters.end()) {
-		Phrase phrase;
-		if (current.empty() || !this->ParsePhrase(current, delimiter, phrase)) {
-		    valid = false;
-		    break;
-		}
-		phrases_.push_back(phrase);
-		current.clear();
-		delimiter = token;
-	    } else {
-		current.push_back(token);
-	    }
-	}
-	if (valid) {
-	    Phrase phrase;
-	    if (current.empty() || !this->ParsePhrase(current, delimiter, phrase)) {
-		valid = false;
-	    } else {
-		phrases_.push_back(phrase);
-	    }
-	}
+//! Reads \p word as a decimal count.
+//! \param word the word
+//! \param value the value read
+//! \return \c false unless \p word is all digits and fits
+bool Parser::ParseNumber(
+	const StringView& word,
+	unsigned& value) noexcept {
+    if (word.empty())
+	return false;
+    unsigned result = 0;
+    for (const auto c: word) {
+	if (c < '0' || c > '9')
+	    return false;
+	const unsigned digit = static_cast<unsigned>(c - '0');
+	if (result > (std::numeric_limits<unsigned>::max() - digit) / 10)
+	    return false;
+	result = result * 10 + digit;
     }
-    if (!valid)
-	phrases_.clear();
-
-    return valid;
+    value = result;
+    return true;
 }
 
-//! Fills \p phrase from \p tokens.
-//! \param tokens the phrase tokens
+//! Fills \p phrase from the unskipped words \p begin to \p end.
+//! \param begin the first word
+//! \param end one past the last word
 //! \param delimiter the delimiter that opened this phrase
 //! \param phrase the phrase to fill
-//! \return \c false if the tokens are illegal
+//! \return \c false if the words are illegal
 bool Parser::ParsePhrase(
-	const std::vector<String>& tokens,
-	const String& delimiter,
-	Phrase& phrase) noexcept {
-    phrase = Phrase();
+	std::size_t begin,
+	std::size_t end,
+	const Span& delimiter,
+	Phrase& phrase) const noexcept {
     phrase.delimiter_ = delimiter;
-    if (tokens.empty())
+    phrase.line_ = line_;
+    if (begin >= end)
 	return false;
 
-    // Lone token is name word, including numeric token.
-    if (tokens.size() == 1) {
-	phrase.words_ = tokens;
+    // Lone word is name word, including numeric word.
+    if (end - begin == 1) {
+	phrase.words_.push_back(tokens_[first_ + begin]);
 	return true;
     }
 
-    auto words = tokens;
-
     // Leading count.
     unsigned value = 0;
-    if (boost::conversion::try_lexical_convert(words.front(), value)) {
+    if (ParseNumber(this->GetToken(begin), value)) {
 	if (!value)
 	    return false;
 	phrase.count_ = value;
-	words.erase(words.begin());
+	++begin;
     }
 
     // Trailing nth. Need name word before ordinal.
-    if (words.size() >= 2 &&
-	    boost::conversion::try_lexical_convert(words.back(), value)) {
+    if (end - begin >= 2 && ParseNumber(this->GetToken(end - 1), value)) {
 	if (!value)
 	    return false;
 	phrase.nth_ = value;
-	words.pop_back();
+	--end;
     }
 
     if (phrase.count_ != 1 && phrase.nth_ != 1)
 	return false;
-    if (words.empty())
+    if (begin >= end)
 	return false;
 
-    // Interior all-digit tokens.
-    for (const auto& word: words) {
-	value = 0;
-	if (boost::conversion::try_lexical_convert(word, value))
+    // Interior all-digit words.
+    for (auto n = begin; n < end; ++n) {
+	if (ParseNumber(this->GetToken(n), value))
 	    return false;
+	phrase.words_.push_back(tokens_[first_ + n]);
     }
+    return true;
+}
 
-    phrase.words_ = std::move(words);
+//! Groups the unskipped words into phrases split by \p delimiters.
+//! \param delimiters caller-supplied function words
+//! \return \c true if the words are valid
+//! \sa #Tokenize(const String&)
+bool Parser::ParsePhrases(const StringSetCi& delimiters) noexcept {
+    phrases_.clear();
+    const auto count = this->GetTokenCount();
+    if (!count)
+	return true;
+
+    // Delimiters are looked up by view, without a key string.
+    Span delimiter{0, 0};
+    std::size_t begin = 0;
+    for (std::size_t n = 0; n < count && !delimiters.empty(); ++n) {
+	if (delimiters.find(this->GetToken(n)) == delimiters.end())
+	    continue;
+	phrases_.emplace_back();
+	if (!this->ParsePhrase(begin, n, delimiter, phrases_.back())) {
+	    phrases_.clear();
+	    return false;
+	}
+	delimiter = tokens_[first_ + n];
+	begin = n + 1;
+    }
+    phrases_.emplace_back();
+    if (!this->ParsePhrase(begin, count, delimiter, phrases_.back())) {
+	phrases_.clear();
+	return false;
+    }
     return true;
 }
 
+//! Skips the next \p n words, such as a command word already matched.
+//! \param n the number of words
+//! \sa #GetRemainder() const
+void Parser::Skip(const std::size_t n) noexcept {
+    first_ = std::min(first_ + n, tokens_.size());
+    phrases_.clear();
+}
+
+//! Splits \p line into words without grouping phrases.
+//! \param line the line to borrow
+//! \sa #ParsePhrases(const StringSetCi&)
+void Parser::Tokenize(const String& line) noexcept {
+    first_ = 0;
+    line_ = line.data();
+    phrases_.clear();
+    tokens_.clear();
+
+    const auto size = line.size();
+    std::size_t n = 0;
+    for (;;) {
+	while (n < size && std::isspace(static_cast<unsigned char>(line[n])))
+	    ++n;
+	if (n == size)
+	    break;
+	const auto offset = n;
+	while (n < size && !std::isspace(static_cast<unsigned char>(line[n])))
+	    ++n;
+	tokens_.push_back(Span{offset, n - offset});
+    }
+}
+
 }; // namespace Core
 }; // namespace Scratch
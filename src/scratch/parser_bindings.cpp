@@ -21,6 +21,27 @@ const char ParserBindings::MetaName[] = "Scratch.Parser";
 //! Metatable name for Parser::Phrase userdata.
 const char ParserBindings::PhraseMetaName[] = "Scratch.ParserPhrase";
 
+//! Parser userdata; owns the line its parser borrows. \{
+struct ParsedLine {
+    //! The parsed line.
+    String line;
+
+    //! The parser over #line.
+    Parser parser;
+};
+//! \}
+
+//! Returns Parser userdata at \p index.
+//! \param L the \c lua_State
+//! \param index the stack index of the userdata
+//! \return the parsed line
+static ParsedLine* CheckParsedLine(
+	lua_State* L,
+	const int index) {
+    return static_cast<ParsedLine*>(
+	luaL_checkudata(L, index, ParserBindings::MetaName));
+}
+
 //! Returns Parser userdata at \p index.
 //! \param L the \c lua_State
 //! \param index the stack index of the userdata
@@ -28,8 +49,7 @@ const char ParserBindings::PhraseMetaName[] = "Scratch.ParserPhrase";
 static Parser* CheckParser(
 	lua_State* L,
 	const int index) {
-    return static_cast<Parser*>(
-	luaL_checkudata(L, index, ParserBindings::MetaName));
+    return &CheckParsedLine(L, index)->parser;
 }
 
 //! Returns Parser::Phrase userdata at \p index.
@@ -45,7 +65,7 @@ static Parser::Phrase* CheckPhrase(
 
 //! Handles Parser userdata garbage collection.
 static int ParserGc(lua_State* L) {
-    CheckParser(L, 1)->~Parser();
+    CheckParsedLine(L, 1)->~ParsedLine();
     return 0;
 }
 
@@ -68,6 +88,10 @@ static int ParserGetPhrase(lua_State* L) {
     void* memory = lua_newuserdata(L, sizeof(Parser::Phrase));
     new (memory) Parser::Phrase(phrase);
     luaL_setmetatable(L, ParserBindings::PhraseMetaName);
+
+    // The phrase borrows the parser's line; keep the parser alive.
+    lua_pushvalue(L, 1);
+    lua_setuservalue(L, -2);
     return 1;
 }
 
@@ -112,12 +136,13 @@ static int PhraseGetWords(lua_State* L) {
 	return luaL_error(L, "get_words expects no arguments");
 
     auto& lua = Lua::CheckLua(L);
-    const auto& words = CheckPhrase(L, 1)->GetWords();
-    lua_createtable(L, static_cast<int>(words.size()), 0);
-    int index = 1;
-    for (const auto& word: words) {
-	lua.PushString(word);
-	lua_rawseti(L, -2, index++);
+    const auto* phrase = CheckPhrase(L, 1);
+    const auto size = phrase->GetWordCount();
+    lua_createtable(L, static_cast<int>(size), 0);
+    for (std::size_t n = 0; n < size; ++n) {
+	const auto word = phrase->GetWord(n);
+	lua.PushString(String(word.data(), word.size()));
+	lua_rawseti(L, -2, static_cast<lua_Integer>(n + 1));
     }
     return 1;
 }
@@ -128,7 +153,7 @@ static int ParseProxy(lua_State* L) {
     if (argc != 1 && argc != 2)
 	return luaL_error(L, "parse expects 1 or 2 arguments");
     luaL_checktype(L, 1, LUA_TSTRING);
-    const auto line = Lua::CheckString(L, 1);
+    auto line = Lua::CheckString(L, 1);
 
     StringSetCi delimiters;
     if (argc == 2) {
@@ -146,14 +171,14 @@ static int ParseProxy(lua_State* L) {
 	}
     }
 
-    void* memory = lua_newuserdata(L, sizeof(Parser));
-    auto* parser = new (memory) Parser();
+    void* memory = lua_newuserdata(L, sizeof(ParsedLine));
+    auto* parsed = new (memory) ParsedLine{std::move(line), Parser()};
     const bool valid = argc == 1
-	? parser->Parse(line)
-	: parser->Parse(line, delimiters);
+	? parsed->parser.Parse(parsed->line)
+	: parsed->parser.Parse(parsed->line, delimiters);
     delimiters.clear();
     if (!valid) {
-	parser->~Parser();
+	parsed->~ParsedLine();
 	lua_pop(L, 1);
 	lua_pushnil(L);
 	return 1;
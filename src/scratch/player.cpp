@@ -21,7 +21,9 @@ Player::Player() noexcept :
 	gender_(Gender::GENDER_UNDEFINED),
 	owner_(),
 	permissions_(),
-	preferences_() {
+	permissionBits_(),
+	preferences_(),
+	preferenceBits_() {
     // Nothing.
 }
 
@@ -32,7 +34,9 @@ Player::Player(const Player& other) noexcept :
 	gender_(other.gender_),
 	owner_(other.owner_),
 	permissions_(other.permissions_),
-	preferences_(other.preferences_) {
+	permissionBits_(other.permissionBits_),
+	preferences_(other.preferences_),
+	preferenceBits_(other.preferenceBits_) {
     // Nothing.
 }
 
@@ -48,7 +52,9 @@ Player& Player::operator=(const Player& other) noexcept {
     gender_ = other.gender_;
     owner_ = other.owner_;
     permissions_ = other.permissions_;
+    permissionBits_ = other.permissionBits_;
     preferences_ = other.preferences_;
+    preferenceBits_ = other.preferenceBits_;
     return *this;
 }
 
@@ -90,6 +96,7 @@ void Player::ReadPermissionsData(const DataPtr& data) noexcept {
 	if (!permission.empty())
 	    permissions_.insert(permission);
     }
+    SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
 }
 
 //! Reads preferences from a data node.
@@ -103,6 +110,7 @@ void Player::ReadPreferencesData(const DataPtr& data) noexcept {
 	if (!preference.empty())
 	    preferences_.insert(preference);
     }
+    SymbolTable::Preferences().MakeBits(preferences_, preferenceBits_);
 }
 
 //! Writes this player to a data node.
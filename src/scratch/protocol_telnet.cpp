@@ -11,7 +11,9 @@
 #define TELCMDS
 #define TELOPTS
 
+#include <scratch/data.hpp>
 #include <scratch/descriptor.hpp>
+#include <scratch/game.hpp>
 #include <scratch/logger.hpp>
 #include <scratch/protocol_telnet.hpp>
 #include <scratch/string.hpp>
@@ -19,6 +21,14 @@
 namespace Scratch {
 namespace Net {
 
+// ScratchMUD types.
+using Data = Scratch::Utility::Data;
+
+#ifndef TELOPT_GMCP
+//! The GMCP TELNET option; not assigned in <arpa/telnet.h>.
+#define TELOPT_GMCP 201
+#endif // TELOPT_GMCP
+
 //! Returns a printable TELNET command name.
 //! \param cmd the TELNET command byte
 static String GetTelcmdName(const std::uint8_t cmd) {
@@ -39,6 +49,8 @@ static String GetTeloptName(const std::uint8_t opt) {
 //! \param descriptor the descriptor
 TelnetProtocol::TelnetProtocol(Descriptor& descriptor) noexcept :
 	descriptor_(descriptor),
+	linemodeMask_(0),
+	negotiationTimer_(),
 	optionState_(),
 	telnetCommand_(/* None */ 0),
 	telnetOption_(/* None */ 0),
@@ -53,6 +65,25 @@ TelnetProtocol::~TelnetProtocol() noexcept {
     // Nothing.
 }
 
+//! Restores negotiated options after a hot reboot.
+//! \param data the handoff record
+//! \sa #SaveHandoff(const DataPtr&) const
+void TelnetProtocol::LoadHandoff(const DataPtr& data) {
+    linemodeMask_ = static_cast<std::uint8_t>(data->GetNumber("Linemode"));
+    auto options = data->Get("Options");
+    if (!options)
+	return;
+    for (const auto& entry: options->GetEntries()) {
+	unsigned option = 0, us = 0, him = 0;
+	if (options->GetFormatted(entry.first, "%u %u %u", &option, &us, &him) != 3 ||
+		option > 255)
+	    continue;
+	auto& state = optionState_[option];
+	state.us = us ? TelnetOptionState::Q_YES : TelnetOptionState::Q_NO;
+	state.him = him ? TelnetOptionState::Q_YES : TelnetOptionState::Q_NO;
+    }
+}
+
 //! Called after an application prompt is written.
 void TelnetProtocol::OnPrompt() {
     // Without Suppress-Go-Ahead, signal end-of-output with GA.
@@ -65,11 +96,15 @@ void TelnetProtocol::OnStart() {
     // Offer SGA on both sides and NAWS/TTYPE from him. Announce WONT ECHO so
     // clients keep local echo; WantUs(ECHO) later for password hiding.
     // NAWS is RFC 1073 (window size); TTYPE is RFC 1091; SGA is orthogonal to app prompts.
+    // LINEMODE is RFC 1184; capable clients then edit locally and send whole lines.
+    // GMCP carries structured data out of band to clients that answer DO.
     this->PutCommand(WONT, TELOPT_ECHO);
     this->WantUs(TELOPT_SGA, true);
+    this->WantUs(TELOPT_GMCP, true);
     this->WantHim(TELOPT_SGA, true);
     this->WantHim(TELOPT_NAWS, true);
     this->WantHim(TELOPT_TTYPE, true);
+    this->WantHim(TELOPT_LINEMODE, true);
 }
 
 //! Enables or disables Quiet (server echo / hidden client local echo).
@@ -116,6 +151,51 @@ void TelnetProtocol::Receive(const std::uint8_t byteReceived) {
     }
 }
 
+//! Processes a run of wire input.
+//! \param bytesReceived the bytes to process
+//! \param nBytes the number of bytes to process
+//! \remark Delivers runs of application data without TELNET state.
+void TelnetProtocol::ReceiveBytes(
+	const std::uint8_t* bytesReceived,
+	const std::size_t nBytes) {
+    std::size_t n = 0;
+    while (n < nBytes && !descriptor_.Closed()) {
+	// Outside IAC and SB, hand the run up to the next IAC over at once.
+	if (telnetCommand_ == /* None */ 0 && !telnetSbBit_) {
+	    const auto* iac = static_cast<const std::uint8_t*>(
+		std::memchr(bytesReceived + n, IAC, nBytes - n));
+	    const auto runN = iac ?
+		static_cast<std::size_t>(iac - bytesReceived) - n : nBytes - n;
+	    if (runN) {
+		descriptor_.DeliverBytes(bytesReceived + n, runN);
+		n += runN;
+		continue;
+	    }
+	}
+	this->Receive(bytesReceived[n++]);
+    }
+}
+
+//! Records negotiated options for a hot reboot.
+//! \param data the handoff record
+//! \remark Options still negotiating are recorded as refused.
+//! \sa #LoadHandoff(const DataPtr&)
+void TelnetProtocol::SaveHandoff(const DataPtr& data) const {
+    data->PutNumber("Linemode", linemodeMask_);
+
+    // Write settled options.
+    auto optionsData = std::make_shared<Data>();
+    for (unsigned option = 0; option < 256; ++option) {
+	const auto& state = optionState_[option];
+	const bool us = state.us == TelnetOptionState::Q_YES;
+	const bool him = state.him == TelnetOptionState::Q_YES;
+	if (us || him)
+	    optionsData->PutFormatted("%", "%u %u %u", option, us ? 1u : 0u, him ? 1u : 0u);
+    }
+    if (optionsData->Size())
+	data->Put("Options", optionsData);
+}
+
 //! Sends application output toward the wire.
 //! \param message the message to send
 void TelnetProtocol::Send(const String& message) {
@@ -129,10 +209,40 @@ void TelnetProtocol::Send(const String& message) {
     descriptor_.WriteRaw(escaped);
 }
 
+//! Sends a GMCP message out of band.
+//! \param package the GMCP package and message name
+//! \param json the JSON payload, or empty
+//! \return \c true if the client accepted GMCP
+bool TelnetProtocol::SendGmcp(const String& package, const String& json) {
+    if (!this->Us(TELOPT_GMCP))
+	return false;
+
+    // IAC SB GMCP package [SP json] IAC SE
+    String frame;
+    frame.reserve(package.size() + json.size() + 6);
+    frame.push_back(static_cast<char>(IAC));
+    frame.push_back(static_cast<char>(SB));
+    frame.push_back(static_cast<char>(TELOPT_GMCP));
+    frame.append(package);
+    if (!json.empty()) {
+	frame.push_back(' ');
+	for (const unsigned char ch: json) {
+	    frame.push_back(static_cast<char>(ch));
+	    if (ch == IAC)
+		frame.push_back(static_cast<char>(IAC));
+	}
+    }
+    frame.push_back(static_cast<char>(IAC));
+    frame.push_back(static_cast<char>(SE));
+    descriptor_.WriteRaw(frame);
+    return true;
+}
+
 //! Returns whether we support enabling an option on his side.
 //! \param option the TELNET option
 bool TelnetProtocol::SupportsHim(const std::uint8_t option) const noexcept {
     switch (option) {
+    case TELOPT_LINEMODE:
     case TELOPT_NAWS:
     case TELOPT_SGA:
     case TELOPT_TTYPE:
@@ -148,6 +258,7 @@ bool TelnetProtocol::SupportsHim(const std::uint8_t option) const noexcept {
 //!         accepting an unsolicited DO ECHO.
 bool TelnetProtocol::SupportsUs(const std::uint8_t option) const noexcept {
     switch (option) {
+    case TELOPT_GMCP:
     case TELOPT_SGA:
 	return true;
     default:
@@ -177,6 +288,7 @@ void TelnetProtocol::WantHim(const std::uint8_t option, const bool enable) {
 	case TelnetOptionState::Q_NO:
 	    state.him = TelnetOptionState::Q_WANTYES;
 	    this->PutCommand(DO, option);
+	    this->InitNegotiationTimer();
 	    break;
 	case TelnetOptionState::Q_YES:
 	    // Nothing.
@@ -201,6 +313,7 @@ void TelnetProtocol::WantHim(const std::uint8_t option, const bool enable) {
 	case TelnetOptionState::Q_YES:
 	    state.him = TelnetOptionState::Q_WANTNO;
 	    this->PutCommand(DONT, option);
+	    this->InitNegotiationTimer();
 	    break;
 	case TelnetOptionState::Q_WANTNO:
 	    if (state.himOpposite)
@@ -227,6 +340,7 @@ void TelnetProtocol::WantUs(const std::uint8_t option, const bool enable) {
 	case TelnetOptionState::Q_NO:
 	    state.us = TelnetOptionState::Q_WANTYES;
 	    this->PutCommand(WILL, option);
+	    this->InitNegotiationTimer();
 	    break;
 	case TelnetOptionState::Q_YES:
 	    // Nothing.
@@ -251,6 +365,7 @@ void TelnetProtocol::WantUs(const std::uint8_t option, const bool enable) {
 	case TelnetOptionState::Q_YES:
 	    state.us = TelnetOptionState::Q_WANTNO;
 	    this->PutCommand(WONT, option);
+	    this->InitNegotiationTimer();
 	    break;
 	case TelnetOptionState::Q_WANTNO:
 	    if (state.usOpposite)
@@ -385,6 +500,8 @@ void TelnetProtocol::RecvWill(const std::uint8_t option) {
 //! \param option the TELNET option
 void TelnetProtocol::RecvWont(const std::uint8_t option) {
     auto& state = optionState_[option];
+    if (option == TELOPT_LINEMODE)
+	linemodeMask_ = 0;
     switch (state.him) {
     case TelnetOptionState::Q_NO:
 	// Nothing.
@@ -447,6 +564,55 @@ void TelnetProtocol::ClearTelnetSb() {
     telnetOption_ = /* None */ 0;
 }
 
+//! Settles options still negotiating once the timer expires.
+//! \remark Pending requests are treated as refused (\c Q_NO).
+//! \sa #InitNegotiationTimer()
+void TelnetProtocol::ExpireNegotiation() {
+    for (unsigned option = 0; option < 256; ++option) {
+	auto& state = optionState_[option];
+	if (state.him == TelnetOptionState::Q_WANTYES ||
+	    state.him == TelnetOptionState::Q_WANTNO) {
+	    LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " did not answer " << GetTeloptName(static_cast<std::uint8_t>(option)) << " from him.";
+	    state.him = TelnetOptionState::Q_NO;
+	    state.himOpposite = false;
+	}
+	if (state.us == TelnetOptionState::Q_WANTYES ||
+	    state.us == TelnetOptionState::Q_WANTNO) {
+	    LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " did not answer " << GetTeloptName(static_cast<std::uint8_t>(option)) << " from us.";
+	    state.us = TelnetOptionState::Q_NO;
+	    state.usOpposite = false;
+	}
+    }
+}
+
+//! Arms the option negotiation timer.
+//! \remark Called after a request is sent. Requests already
+//!     outstanding keep their deadline; later ones share it.
+//! \sa #ExpireNegotiation()
+void TelnetProtocol::InitNegotiationTimer() {
+    // Count outstanding requests, including the one just sent.
+    if (negotiationTimer_.IsArmed()) {
+	unsigned pending = 0;
+	for (const auto& state: optionState_) {
+	    if (state.him == TelnetOptionState::Q_WANTYES ||
+		state.him == TelnetOptionState::Q_WANTNO)
+		++pending;
+	    if (state.us == TelnetOptionState::Q_WANTYES ||
+		state.us == TelnetOptionState::Q_WANTNO)
+		++pending;
+	}
+	if (pending > 1)
+	    return;
+    }
+
+    // The timer is a member, so it cannot outlive this protocol.
+    descriptor_.GetGame().GetTimers().Arm(negotiationTimer_,
+	std::chrono::seconds(MaxNegotiation), [this]() {
+	    if (!descriptor_.Closed())
+		this->ExpireNegotiation();
+	});
+}
+
 //! Processes TELNET-IAC input.
 //! \param byteReceived the byte to process
 void TelnetProtocol::ReceiveTelnetIac(const std::uint8_t byteReceived) {
@@ -541,6 +707,19 @@ void TelnetProtocol::ReceiveTelnetSb(
 	const std::uint8_t option,
 	const String& sbReceived) {
     switch (option) {
+    case TELOPT_GMCP:
+	// Nothing. Client messages (Core.Hello, Core.Supports) are not used yet.
+	if (!this->Us(TELOPT_GMCP)) {
+	    LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " ignored GMCP SB; option not enabled.";
+	}
+	break;
+    case TELOPT_LINEMODE:
+	if (this->Him(TELOPT_LINEMODE)) {
+	    this->ReceiveLinemode(sbReceived);
+	} else {
+	    LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " ignored LINEMODE SB; option not enabled.";
+	}
+	break;
     case TELOPT_NAWS:
 	if (this->Him(TELOPT_NAWS)) {
 	    this->ReceiveNaws(sbReceived);
@@ -579,6 +758,86 @@ void TelnetProtocol::ReceiveTelnetSbByte(const std::uint8_t sbByteReceived) {
     telnetSb_ << static_cast<char>(sbByteReceived);
 }
 
+//! Processes a LINEMODE subnegotiation.
+//! \param sbReceived the TELNET-SB payload
+void TelnetProtocol::ReceiveLinemode(const String& sbReceived) {
+    if (sbReceived.empty()) {
+	LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " sent empty LINEMODE payload.";
+	return;
+    }
+
+    const auto suboption = static_cast<std::uint8_t>(sbReceived[0]);
+    switch (suboption) {
+    case LM_MODE:
+	// IAC SB LINEMODE MODE mask IAC SE
+	if (sbReceived.size() != 2) {
+	    LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " sent LINEMODE MODE payload length " << sbReceived.size() << " (expected 2); discarded.";
+	} else {
+	    const auto mask = static_cast<std::uint8_t>(sbReceived[1]);
+	    const auto modeMask = static_cast<std::uint8_t>(mask & MODE_MASK & ~MODE_ACK);
+	    if (!(mask & MODE_ACK)) {
+		// Unsolicited mode; accept it with ACK (RFC 1184 section 2.2).
+		this->SendLinemodeMode(static_cast<std::uint8_t>(modeMask | MODE_ACK));
+	    }
+	    if (modeMask != linemodeMask_) {
+		linemodeMask_ = modeMask;
+		LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " LINEMODE" << ((modeMask & MODE_EDIT) ? " EDIT" : "") << ((modeMask & MODE_TRAPSIG) ? " TRAPSIG" : "") << ".";
+	    }
+	}
+	break;
+    case DO:
+    case WILL:
+	// IAC SB LINEMODE DO|WILL FORWARDMASK IAC SE; refuse forward masks.
+	if (sbReceived.size() >= 2) {
+	    this->SendLinemodeNegotiate(
+		static_cast<std::uint8_t>(suboption == DO ? WONT : DONT),
+		static_cast<std::uint8_t>(sbReceived[1]));
+	}
+	break;
+    case DONT:
+    case WONT:
+    case LM_SLC:
+	// Nothing. Client-side special characters stay at their defaults.
+	break;
+    default:
+	LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " sent unknown LINEMODE suboption " << static_cast<unsigned>(suboption) << ".";
+	break;
+    }
+}
+
+//! Sends a LINEMODE \c MODE subnegotiation.
+//! \param mask the mode mask to send
+void TelnetProtocol::SendLinemodeMode(const std::uint8_t mask) {
+    const char bytes[] = {
+	static_cast<char>(IAC),
+	static_cast<char>(SB),
+	static_cast<char>(TELOPT_LINEMODE),
+	static_cast<char>(LM_MODE),
+	static_cast<char>(mask),
+	static_cast<char>(IAC),
+	static_cast<char>(SE)
+    };
+    descriptor_.WriteRaw(String(bytes, sizeof(bytes)));
+}
+
+//! Sends a LINEMODE option subnegotiation (RFC 1184 section 2.2).
+//! \param command the negotiation command
+//! \param option the LINEMODE suboption
+void TelnetProtocol::SendLinemodeNegotiate(
+	const std::uint8_t command,
+	const std::uint8_t option) {
+    const char bytes[] = {
+	static_cast<char>(IAC),
+	static_cast<char>(SB),
+	static_cast<char>(TELOPT_LINEMODE),
+	static_cast<char>(command),
+	static_cast<char>(option),
+	static_cast<char>(IAC),
+	static_cast<char>(SE)
+    };
+    descriptor_.WriteRaw(String(bytes, sizeof(bytes)));
+}
+
 //! Processes a NAWS subnegotiation.
 //! \param sbReceived the TELNET-SB payload
 void TelnetProtocol::ReceiveNaws(const String& sbReceived) {
@@ -607,6 +866,10 @@ void TelnetProtocol::ReceiveNaws(const String& sbReceived) {
 //! \param option the TELNET option
 void TelnetProtocol::OnHimEnabled(const std::uint8_t option) {
     switch (option) {
+    case TELOPT_LINEMODE:
+	// Client-side editing; whole lines arrive per packet.
+	this->SendLinemodeMode(MODE_EDIT);
+	break;
     case TELOPT_TTYPE:
 	this->RequestTtype();
 	break;
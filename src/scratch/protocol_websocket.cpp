@@ -0,0 +1,712 @@
+//! \file protocol_websocket.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_PROTOCOL_WEBSOCKET_CPP_
+
+#include <scratch/data.hpp>
+#include <scratch/descriptor.hpp>
+#include <scratch/logger.hpp>
+#include <scratch/protocol_websocket.hpp>
+#include <scratch/string.hpp>
+
+namespace Scratch {
+namespace Net {
+
+//! The GUID appended to Sec-WebSocket-Key (RFC 6455 section 1.3).
+static const char webSocketGuid[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+//! The empty stored block that ends a flushed deflate message.
+static const char deflateTail[] = { '\x00', '\x00', '\xff', '\xff' };
+
+//! Returns \p value rotated left by \p bits.
+static std::uint32_t RotateLeft(
+	const std::uint32_t value,
+	const unsigned bits) noexcept {
+    return (value << bits) | (value >> (32 - bits));
+}
+
+//! Returns the SHA-1 digest of \p input.
+//! \param input the bytes to hash
+//! \remark Used only for the upgrade handshake, not for security.
+static String Sha1(const String& input) {
+    std::uint32_t h[5] = {
+	0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0
+    };
+
+    // Pad to a whole number of 64-byte blocks.
+    String message = input;
+    const std::uint64_t bitLength = static_cast<std::uint64_t>(input.size()) * 8;
+    message.push_back(static_cast<char>(0x80));
+    while (message.size() % 64 != 56)
+	message.push_back('\0');
+    for (int shift = 56; shift >= 0; shift -= 8)
+	message.push_back(static_cast<char>((bitLength >> shift) & 0xff));
+
+    for (std::size_t block = 0; block < message.size(); block += 64) {
+	std::uint32_t w[80];
+	for (unsigned t = 0; t < 16; ++t) {
+	    const auto* bytes = reinterpret_cast<const std::uint8_t*>(
+		message.data() + block + t * 4);
+	    w[t] = (static_cast<std::uint32_t>(bytes[0]) << 24) |
+		(static_cast<std::uint32_t>(bytes[1]) << 16) |
+		(static_cast<std::uint32_t>(bytes[2]) << 8) |
+		static_cast<std::uint32_t>(bytes[3]);
+	}
+	for (unsigned t = 16; t < 80; ++t)
+	    w[t] = RotateLeft(w[t - 3] ^ w[t - 8] ^ w[t - 14] ^ w[t - 16], 1);
+
+	std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+	for (unsigned t = 0; t < 80; ++t) {
+	    std::uint32_t f = 0, k = 0;
+	    if (t < 20) {
+		f = (b & c) | (~b & d);
+		k = 0x5A827999;
+	    } else if (t < 40) {
+		f = b ^ c ^ d;
+		k = 0x6ED9EBA1;
+	    } else if (t < 60) {
+		f = (b & c) | (b & d) | (c & d);
+		k = 0x8F1BBCDC;
+	    } else {
+		f = b ^ c ^ d;
+		k = 0xCA62C1D6;
+	    }
+	    const auto temp = RotateLeft(a, 5) + f + e + k + w[t];
+	    e = d;
+	    d = c;
+	    c = RotateLeft(b, 30);
+	    b = a;
+	    a = temp;
+	}
+	h[0] += a;
+	h[1] += b;
+	h[2] += c;
+	h[3] += d;
+	h[4] += e;
+    }
+
+    String digest;
+    for (const auto word: h) {
+	for (int shift = 24; shift >= 0; shift -= 8)
+	    digest.push_back(static_cast<char>((word >> shift) & 0xff));
+    }
+    return digest;
+}
+
+//! Returns \p input in base64.
+//! \param input the bytes to encode
+static String Base64(const String& input) {
+    static const char alphabet[] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    String output;
+    output.reserve((input.size() + 2) / 3 * 4);
+    for (std::size_t n = 0; n < input.size(); n += 3) {
+	const auto remaining = input.size() - n;
+	std::uint32_t group = static_cast<std::uint8_t>(input[n]) << 16;
+	if (remaining > 1)
+	    group |= static_cast<std::uint8_t>(input[n + 1]) << 8;
+	if (remaining > 2)
+	    group |= static_cast<std::uint8_t>(input[n + 2]);
+	output.push_back(alphabet[(group >> 18) & 0x3f]);
+	output.push_back(alphabet[(group >> 12) & 0x3f]);
+	output.push_back(remaining > 1 ? alphabet[(group >> 6) & 0x3f] : '=');
+	output.push_back(remaining > 2 ? alphabet[group & 0x3f] : '=');
+    }
+    return output;
+}
+
+//! Constructor.
+//! \param descriptor the descriptor
+WebSocketProtocol::WebSocketProtocol(Descriptor& descriptor) noexcept :
+	descriptor_(descriptor),
+	deflateBit_(false),
+	deflateWindowBits_(15),
+#ifdef HAVE_LIBZ
+	deflater_(),
+	deflaterBit_(false),
+	inflater_(),
+	inflaterBit_(false),
+#endif // HAVE_LIBZ
+	frameInput_(),
+	handshake_(),
+	message_(),
+	messageCompressedBit_(false),
+	messageBit_(false),
+	openBit_(false),
+	pending_() {
+    // Nothing.
+}
+
+//! Destructor.
+WebSocketProtocol::~WebSocketProtocol() noexcept {
+#ifdef HAVE_LIBZ
+    if (deflaterBit_)
+	deflateEnd(&deflater_);
+    if (inflaterBit_)
+	inflateEnd(&inflater_);
+#endif // HAVE_LIBZ
+}
+
+//! Restores the open connection after a hot reboot.
+//! \param data the handoff record
+//! \sa #SaveHandoff(const DataPtr&) const
+void WebSocketProtocol::LoadHandoff(const DataPtr& data) {
+    openBit_ = data->GetYesNo("Open", false);
+    if (!openBit_ || !data->GetYesNo("Deflate", false))
+	return;
+
+    deflateWindowBits_ = static_cast<int>(data->GetNumber("DeflateWindowBits", 15));
+    deflateWindowBits_ = std::min(std::max(deflateWindowBits_, 9), 15);
+    deflateBit_ = this->InitDeflate();
+    if (!deflateBit_) {
+	LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " lost permessage-deflate across hot reboot.";
+    }
+}
+
+//! Processes one byte of wire input.
+//! \param byteReceived the byte to process
+void WebSocketProtocol::Receive(const std::uint8_t byteReceived) {
+    this->ReceiveBytes(&byteReceived, 1);
+}
+
+//! Processes a run of wire input.
+//! \param bytesReceived the bytes to process
+//! \param nBytes the number of bytes to process
+void WebSocketProtocol::ReceiveBytes(
+	const std::uint8_t* bytesReceived,
+	const std::size_t nBytes) {
+    if (descriptor_.Closed())
+	return;
+
+    const auto* bytes = reinterpret_cast<const char*>(bytesReceived);
+    if (!openBit_) {
+	handshake_.append(bytes, nBytes);
+	this->ReceiveHandshake();
+    } else {
+	frameInput_.append(bytes, nBytes);
+	this->ReceiveFrames();
+    }
+}
+
+//! Records the open connection for a hot reboot.
+//! \param data the handoff record
+//! \remark Deflate keeps no history between messages, so only the
+//!     negotiated parameters are recorded.
+//! \sa #LoadHandoff(const DataPtr&)
+void WebSocketProtocol::SaveHandoff(const DataPtr& data) const {
+    data->PutYesNo("Open", openBit_);
+    if (deflateBit_) {
+	data->PutYesNo("Deflate", true);
+	data->PutNumber("DeflateWindowBits", deflateWindowBits_);
+    }
+}
+
+//! Sends application output as one text message.
+//! \param message the message to send
+void WebSocketProtocol::Send(const String& message) {
+    if (message.empty())
+	return;
+
+    // Hold output until the upgrade is answered.
+    if (!openBit_) {
+	pending_.append(message);
+	return;
+    }
+
+    String compressed;
+    if (deflateBit_ && this->Deflate(message, compressed))
+	this->SendFrame(OP_TEXT, compressed, true);
+    else
+	this->SendFrame(OP_TEXT, message);
+}
+
+//! Answers a valid upgrade request and flushes held output.
+//! \param request the HTTP request head
+//! \return \c false if \p request is not a WebSocket upgrade
+bool WebSocketProtocol::Accept(const String& request) {
+    std::vector<String> lines;
+    boost::split(lines, request, boost::is_any_of("\n"));
+    for (auto& line: lines) {
+	if (!line.empty() && line.back() == '\r')
+	    line.pop_back();
+    }
+
+    // Request line.
+    std::vector<String> requestLine;
+    boost::split(requestLine, lines.front(), boost::is_any_of(" "),
+	boost::token_compress_on);
+    if (requestLine.size() != 3 || requestLine[0] != "GET" ||
+	    !Scratch::Algorithm::StringStartsWith(requestLine[2], "HTTP/1."))
+	return false;
+
+    // Header fields; repeated fields join with commas.
+    String connection, extensions, key, upgrade, version;
+    for (std::size_t n = 1; n < lines.size(); ++n) {
+	const auto colon = lines[n].find(':');
+	if (colon == String::npos)
+	    continue;
+	const auto name = boost::trim_copy(lines[n].substr(0, colon));
+	const auto value = boost::trim_copy(lines[n].substr(colon + 1));
+	String* field = nullptr;
+	if (!Scratch::Algorithm::StringCompareCi(name, "Connection"))
+	    field = &connection;
+	else if (!Scratch::Algorithm::StringCompareCi(name, "Sec-WebSocket-Extensions"))
+	    field = &extensions;
+	else if (!Scratch::Algorithm::StringCompareCi(name, "Sec-WebSocket-Key"))
+	    field = &key;
+	else if (!Scratch::Algorithm::StringCompareCi(name, "Sec-WebSocket-Version"))
+	    field = &version;
+	else if (!Scratch::Algorithm::StringCompareCi(name, "Upgrade"))
+	    field = &upgrade;
+	if (field)
+	    *field = field->empty() ? value : *field + ", " + value;
+    }
+
+    std::vector<String> connectionTokens;
+    boost::split(connectionTokens, connection, boost::is_any_of(","));
+    const bool connectionUpgrade = std::any_of(
+	std::begin(connectionTokens), std::end(connectionTokens),
+	[](const String& token) {
+	    return !Scratch::Algorithm::StringCompareCi(boost::trim_copy(token), "Upgrade");
+	});
+    if (!connectionUpgrade || key.empty() || version != "13" ||
+	    Scratch::Algorithm::StringCompareCi(upgrade, "websocket"))
+	return false;
+
+    // Answer upgrade.
+    auto extensionResponse = this->NegotiateDeflate(extensions);
+    if (!extensionResponse.empty() && !this->InitDeflate()) {
+	deflateBit_ = false;
+	extensionResponse.clear();
+    }
+    String response =
+	"HTTP/1.1 101 Switching Protocols\r\n"
+	"Upgrade: websocket\r\n"
+	"Connection: Upgrade\r\n"
+	"Sec-WebSocket-Accept: " + Base64(Sha1(key + webSocketGuid)) + "\r\n";
+    if (!extensionResponse.empty())
+	response += "Sec-WebSocket-Extensions: " + extensionResponse + "\r\n";
+    response += "\r\n";
+    descriptor_.WriteRaw(response);
+    openBit_ = true;
+
+    LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " opened WebSocket" << (deflateBit_ ? " with permessage-deflate" : "") << ".";
+
+    // Flush held output as one message.
+    if (!pending_.empty()) {
+	String held;
+	held.swap(pending_);
+	this->Send(held);
+    }
+    return true;
+}
+
+//! Sends a close frame and closes the descriptor.
+//! \param status the close status code
+//! \param reason the reason for the log
+void WebSocketProtocol::Fail(
+	const CloseStatus status,
+	const String& reason) {
+    LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " WebSocket error: " << reason << ".";
+    if (descriptor_.Closed())
+	return;
+
+    const char payload[] = {
+	static_cast<char>(status >> 8),
+	static_cast<char>(status & 0xff)
+    };
+    this->SendFrame(OP_CLOSE, String(payload, sizeof(payload)));
+    descriptor_.Close();
+}
+
+//! Processes one complete frame.
+//! \param header the first header byte
+//! \param payload the unmasked payload
+void WebSocketProtocol::ReceiveFrame(
+	const std::uint8_t header,
+	const String& payload) {
+    const bool fin = (header & 0x80) != 0;
+    const bool rsv1 = (header & 0x40) != 0;
+    const auto opcode = static_cast<std::uint8_t>(header & 0x0f);
+    if (header & 0x30) {
+	this->Fail(CLOSE_PROTOCOL_ERROR, "reserved bits set");
+	return;
+    }
+
+    // Control frames may arrive between fragments.
+    if (opcode & 0x08) {
+	if (!fin || rsv1 || payload.size() > 125) {
+	    this->Fail(CLOSE_PROTOCOL_ERROR, "invalid control frame");
+	    return;
+	}
+	switch (opcode) {
+	case OP_CLOSE:
+	    // Echo the status, then close.
+	    this->SendFrame(OP_CLOSE, payload.substr(0, 2));
+	    descriptor_.Close();
+	    break;
+	case OP_PING:
+	    this->SendFrame(OP_PONG, payload);
+	    break;
+	case OP_PONG:
+	    // Nothing.
+	    break;
+	default:
+	    this->Fail(CLOSE_PROTOCOL_ERROR, "unknown control opcode");
+	    break;
+	}
+	return;
+    }
+
+    switch (opcode) {
+    case OP_CONTINUATION:
+	if (!messageBit_ || rsv1) {
+	    this->Fail(CLOSE_PROTOCOL_ERROR, "unexpected continuation");
+	    return;
+	}
+	break;
+    case OP_TEXT:
+    case OP_BINARY:
+	if (messageBit_ || (rsv1 && !deflateBit_)) {
+	    this->Fail(CLOSE_PROTOCOL_ERROR, "unexpected data frame");
+	    return;
+	}
+	message_.clear();
+	messageBit_ = true;
+	messageCompressedBit_ = rsv1;
+	break;
+    default:
+	this->Fail(CLOSE_PROTOCOL_ERROR, "unknown data opcode");
+	return;
+    }
+
+    if (message_.size() + payload.size() > MaxString) {
+	this->Fail(CLOSE_TOO_BIG, "message too big");
+	return;
+    }
+    message_.append(payload);
+    if (!fin)
+	return;
+
+    String completed;
+    completed.swap(message_);
+    messageBit_ = false;
+    this->ReceiveMessage(completed, messageCompressedBit_);
+}
+
+//! Processes buffered frame input.
+void WebSocketProtocol::ReceiveFrames() {
+    std::size_t offset = 0;
+    while (!descriptor_.Closed()) {
+	const auto available = frameInput_.size() - offset;
+	if (available < 2)
+	    break;
+	const auto* bytes = reinterpret_cast<const std::uint8_t*>(
+	    frameInput_.data() + offset);
+
+	// Decode header.
+	std::uint64_t length = bytes[1] & 0x7f;
+	std::size_t headerN = 2;
+	if (length == 126) {
+	    if (available < 4)
+		break;
+	    length = (static_cast<std::uint64_t>(bytes[2]) << 8) | bytes[3];
+	    headerN = 4;
+	} else if (length == 127) {
+	    if (available < 10)
+		break;
+	    length = 0;
+	    for (std::size_t n = 2; n < 10; ++n)
+		length = (length << 8) | bytes[n];
+	    headerN = 10;
+	}
+	if (!(bytes[1] & 0x80)) {
+	    this->Fail(CLOSE_PROTOCOL_ERROR, "unmasked client frame");
+	    break;
+	}
+	if (length > MaxString) {
+	    this->Fail(CLOSE_TOO_BIG, "frame too big");
+	    break;
+	}
+	const auto frameN = headerN + 4 + static_cast<std::size_t>(length);
+	if (available < frameN)
+	    break;
+
+	// Unmask payload.
+	const auto* mask = bytes + headerN;
+	String payload(reinterpret_cast<const char*>(mask + 4),
+	    static_cast<std::size_t>(length));
+	for (std::size_t n = 0; n < payload.size(); ++n)
+	    payload[n] = static_cast<char>(payload[n] ^ mask[n % 4]);
+
+	const auto header = bytes[0];
+	offset += frameN;
+	this->ReceiveFrame(header, payload);
+    }
+    frameInput_.erase(0, std::min(offset, frameInput_.size()));
+}
+
+//! Processes buffered upgrade input.
+void WebSocketProtocol::ReceiveHandshake() {
+    const auto end = handshake_.find("\r\n\r\n");
+    if (end == String::npos) {
+	if (handshake_.size() > MaxString) {
+	    LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " WebSocket upgrade exceeded " << MaxString << " bytes.";
+	    descriptor_.Close();
+	}
+	return;
+    }
+
+    // Frames may follow the request head directly.
+    const auto request = handshake_.substr(0, end + 2);
+    frameInput_ = handshake_.substr(end + 4);
+    handshake_.clear();
+    handshake_.shrink_to_fit();
+
+    if (!this->Accept(request)) {
+	LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " sent an invalid WebSocket upgrade.";
+	descriptor_.WriteRaw(
+	    "HTTP/1.1 400 Bad Request\r\n"
+	    "Sec-WebSocket-Version: 13\r\n"
+	    "Connection: close\r\n"
+	    "Content-Length: 0\r\n"
+	    "\r\n");
+	descriptor_.Close();
+	return;
+    }
+    if (!frameInput_.empty())
+	this->ReceiveFrames();
+}
+
+//! Processes one complete data message.
+//! \param payload the message payload
+//! \param compressed whether \p payload is deflated
+void WebSocketProtocol::ReceiveMessage(
+	const String& payload,
+	const bool compressed) {
+    String text;
+    if (!compressed) {
+	text = payload;
+    } else if (!this->Inflate(payload, text)) {
+	this->Fail(CLOSE_INVALID_DATA, "invalid deflate data");
+	return;
+    }
+
+    // Each message is one line.
+    if (text.empty() || text.back() != '\n')
+	text.push_back('\n');
+    descriptor_.DeliverBytes(
+	reinterpret_cast<const std::uint8_t*>(text.data()), text.size());
+}
+
+//! Writes one unfragmented frame.
+//! \param opcode the frame opcode
+//! \param payload the frame payload
+//! \param compressed whether to set RSV1 for a deflated payload
+void WebSocketProtocol::SendFrame(
+	const Opcode opcode,
+	const String& payload,
+	const bool compressed) {
+    String frame;
+    frame.reserve(payload.size() + 10);
+    frame.push_back(static_cast<char>(0x80 | (compressed ? 0x40 : 0) | opcode));
+
+    // Server frames are never masked.
+    const auto length = static_cast<std::uint64_t>(payload.size());
+    if (length < 126) {
+	frame.push_back(static_cast<char>(length));
+    } else if (length <= 0xffff) {
+	frame.push_back(static_cast<char>(126));
+	frame.push_back(static_cast<char>((length >> 8) & 0xff));
+	frame.push_back(static_cast<char>(length & 0xff));
+    } else {
+	frame.push_back(static_cast<char>(127));
+	for (int shift = 56; shift >= 0; shift -= 8)
+	    frame.push_back(static_cast<char>((length >> shift) & 0xff));
+    }
+    frame.append(payload);
+    descriptor_.WriteRaw(frame);
+}
+
+//! Parses a permessage-deflate offer.
+//! \param offers the Sec-WebSocket-Extensions value
+//! \return the extension response, or empty to decline
+String WebSocketProtocol::NegotiateDeflate(const String& offers) {
+#ifdef HAVE_LIBZ
+    std::vector<String> offerList;
+    boost::split(offerList, offers, boost::is_any_of(","));
+    for (const auto& offer: offerList) {
+	std::vector<String> params;
+	boost::split(params, offer, boost::is_any_of(";"));
+	if (Scratch::Algorithm::StringCompareCi(
+		boost::trim_copy(params.front()), "permessage-deflate"))
+	    continue;
+
+	// Accept the first offer whose parameters we can honor.
+	bool accepted = true;
+	int windowBits = 15;
+	for (std::size_t n = 1; n < params.size() && accepted; ++n) {
+	    const auto equals = params[n].find('=');
+	    const auto name = boost::trim_copy(params[n].substr(0, equals));
+	    auto value = equals == String::npos ?
+		String() : boost::trim_copy(params[n].substr(equals + 1));
+	    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+		value = value.substr(1, value.size() - 2);
+	    const bool bitsValue = !value.empty() && value.size() <= 2 &&
+		std::all_of(std::begin(value), std::end(value), ::isdigit);
+
+	    if (name == "server_no_context_takeover") {
+		accepted = value.empty();
+	    } else if (name == "client_no_context_takeover") {
+		accepted = value.empty();
+	    } else if (name == "server_max_window_bits") {
+		// zlib cannot produce raw deflate with an 8-bit window.
+		accepted = bitsValue && std::stoi(value) >= 9 && std::stoi(value) <= 15;
+		if (accepted)
+		    windowBits = std::stoi(value);
+	    } else if (name == "client_max_window_bits") {
+		// Our inflater always uses the largest window.
+		accepted = value.empty() ||
+		    (bitsValue && std::stoi(value) >= 8 && std::stoi(value) <= 15);
+	    } else {
+		accepted = false;
+	    }
+	}
+	if (!accepted)
+	    continue;
+
+	deflateBit_ = true;
+	deflateWindowBits_ = windowBits;
+
+	// Both directions reset per message, so no state needs a handoff
+	// and output dropped under backpressure never leaves the client's
+	// window behind ours.
+	String response = "permessage-deflate; client_no_context_takeover"
+	    "; server_no_context_takeover";
+	if (windowBits != 15)
+	    response += "; server_max_window_bits=" + std::to_string(windowBits);
+	return response;
+    }
+#endif // HAVE_LIBZ
+    return String();
+}
+
+//! Creates the zlib streams for a negotiated deflate.
+//! \return \c false if zlib could not be initialized
+bool WebSocketProtocol::InitDeflate() {
+#ifdef HAVE_LIBZ
+    if (!deflaterBit_) {
+	std::memset(&deflater_, 0, sizeof(deflater_));
+	if (deflateInit2(&deflater_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+		-deflateWindowBits_, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+	    LOGGER_NETWORK() << "Error initializing deflate.";
+	    return false;
+	}
+	deflaterBit_ = true;
+    }
+    if (!inflaterBit_) {
+	std::memset(&inflater_, 0, sizeof(inflater_));
+	if (inflateInit2(&inflater_, -15) != Z_OK) {
+	    LOGGER_NETWORK() << "Error initializing inflate.";
+	    return false;
+	}
+	inflaterBit_ = true;
+    }
+    return true;
+#else
+    return false;
+#endif // HAVE_LIBZ
+}
+
+//! Compresses one outbound message.
+//! \param message the message
+//! \param compressed the deflated message, sans trailing flush block
+//! \return \c false on a zlib error
+bool WebSocketProtocol::Deflate(
+	const String& message,
+	String& compressed) {
+#ifdef HAVE_LIBZ
+    if (!deflaterBit_)
+	return false;
+
+    compressed.clear();
+    deflater_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(message.data()));
+    deflater_.avail_in = static_cast<uInt>(message.size());
+    char chunk[1024];
+    do {
+	deflater_.next_out = reinterpret_cast<Bytef*>(chunk);
+	deflater_.avail_out = sizeof(chunk);
+	const auto result = deflate(&deflater_, Z_SYNC_FLUSH);
+	if (result != Z_OK && result != Z_BUF_ERROR) {
+	    // Fall back to uncompressed messages.
+	    LOGGER_NETWORK() << "Descriptor " << descriptor_.GetName() << " deflate error " << result << ".";
+	    deflateEnd(&deflater_);
+	    deflaterBit_ = false;
+	    return false;
+	}
+	compressed.append(chunk, sizeof(chunk) - deflater_.avail_out);
+    } while (deflater_.avail_out == 0);
+
+    // The client restores the empty stored block (RFC 7692 section 7.2.1).
+    const auto tailN = sizeof(deflateTail);
+    if (compressed.size() >= tailN &&
+	    !compressed.compare(compressed.size() - tailN, tailN, deflateTail, tailN))
+	compressed.resize(compressed.size() - tailN);
+    deflateReset(&deflater_);
+    return true;
+#else
+    return false;
+#endif // HAVE_LIBZ
+}
+
+//! Decompresses one inbound message.
+//! \param compressed the deflated message
+//! \param message the inflated message
+//! \return \c false on a zlib error or if \p message would exceed
+//!     MaxString
+bool WebSocketProtocol::Inflate(
+	const String& compressed,
+	String& message) {
+#ifdef HAVE_LIBZ
+    if (!inflaterBit_)
+	return false;
+
+    String input = compressed;
+    input.append(deflateTail, sizeof(deflateTail));
+    inflater_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    inflater_.avail_in = static_cast<uInt>(input.size());
+    message.clear();
+
+    char chunk[1024];
+    bool ok = true;
+    int result = Z_OK;
+    do {
+	inflater_.next_out = reinterpret_cast<Bytef*>(chunk);
+	inflater_.avail_out = sizeof(chunk);
+	result = inflate(&inflater_, Z_SYNC_FLUSH);
+	if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+	    ok = false;
+	    break;
+	}
+	message.append(chunk, sizeof(chunk) - inflater_.avail_out);
+	if (message.size() > MaxString) {
+	    ok = false;
+	    break;
+	}
+    } while (inflater_.avail_out == 0 && result != Z_STREAM_END);
+
+    // We negotiated client_no_context_takeover.
+    inflateReset(&inflater_);
+    return ok;
+#else
+    return false;
+#endif // HAVE_LIBZ
+}
+
+}; // namespace Net
+}; // namespace Scratch
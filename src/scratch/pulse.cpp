@@ -0,0 +1,163 @@
+//! \file pulse.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_PULSE_CPP_
+
+#include <scratch/logger.hpp>
+#include <scratch/pulse.hpp>
+#include <scratch/scratch.hpp>
+
+namespace Scratch {
+namespace Utility {
+
+//! Constructor.
+//! \param ioContext the IO context
+Pulse::Pulse(IoContext& ioContext) :
+	count_(0),
+	deadline_(),
+	dispatching_(false),
+	dropped_(0),
+	entries_(),
+	lag_(0),
+	maxLag_(0),
+	nextId_(1),
+	period_(0),
+	running_(false),
+	steadyTimer_(ioContext) {
+    // Nothing.
+}
+
+//! Destructor.
+Pulse::~Pulse() noexcept {
+    this->Stop();
+}
+
+//! Registers a handler.
+//! \param every the pulse interval, at least one
+//! \param handler the handler, run once every \p every pulses
+//! \return the registration, for #Unregister(const std::size_t)
+std::size_t Pulse::Register(
+	const unsigned every,
+	Handler handler) {
+    Entry entry;
+    entry.id = nextId_++;
+    entry.every = std::max(every, 1u);
+    entry.handler = std::move(handler);
+    entries_.push_back(std::move(entry));
+    return entries_.back().id;
+}
+
+//! Starts pulsing.
+//! \param period the pulse period, at least one millisecond
+//! \sa #Stop()
+void Pulse::Start(const std::chrono::milliseconds period) {
+    this->Stop();
+    period_ = std::max(period, std::chrono::milliseconds(1));
+    deadline_ = std::chrono::steady_clock::now() + period_;
+    running_ = true;
+    this->InitAsyncWait();
+}
+
+//! Stops pulsing; handlers stay registered.
+//! \sa #Start(const std::chrono::milliseconds)
+void Pulse::Stop() noexcept {
+    if (!running_)
+	return;
+    ErrorCode errorCode;
+    steadyTimer_.cancel(errorCode);
+    running_ = false;
+}
+
+//! Unregisters a handler.
+//! \param id the registration
+//! \remark Safe to call from a running handler.
+//! \sa #Register(const unsigned, Handler)
+void Pulse::Unregister(const std::size_t id) noexcept {
+    for (auto it = std::begin(entries_); it != std::end(entries_); ++it) {
+	if (it->id != id)
+	    continue;
+	// Dispatch() sweeps empty entries once handlers return.
+	if (dispatching_)
+	    it->handler = nullptr;
+	else
+	    entries_.erase(it);
+	return;
+    }
+}
+
+//! Runs one pulse.
+//! \remark A handler that throws is logged; the others still run.
+void Pulse::Dispatch() {
+    ++count_;
+    dispatching_ = true;
+    for (auto& entry: entries_) {
+	if (!entry.handler || count_ % entry.every != 0)
+	    continue;
+	try {
+	    entry.handler(count_);
+	} catch (const std::exception& ex) {
+	    LOGGER_SYSTEM() << "Pulse handler failed: " << ex.what();
+	} catch (...) {
+	    LOGGER_SYSTEM() << "Pulse handler failed.";
+	}
+    }
+    dispatching_ = false;
+    entries_.remove_if([](const Entry& entry) {
+	return !entry.handler;
+    });
+}
+
+//! Begins waiting for the next deadline.
+void Pulse::InitAsyncWait() {
+    steadyTimer_.expires_at(deadline_);
+    steadyTimer_.async_wait(std::function<void(const ErrorCode&)>(
+	[this](const ErrorCode& errorCode) {
+	    if (errorCode == boost::asio::error::operation_aborted) {
+		// Stop() owns the running bit.
+		return;
+	    } else if (errorCode) {
+		LOGGER_SYSTEM() << "Error waiting for pulse.";
+		LOGGER_SYSTEM() << " >> " << errorCode;
+		LOGGER_SYSTEM() << " >> " << errorCode.message();
+		running_ = false;
+		return;
+	    }
+
+	    this->Wake();
+	    if (running_)
+		this->InitAsyncWait();
+	}));
+}
+
+//! Runs the pulses now due.
+void Pulse::Wake() {
+    const auto now = std::chrono::steady_clock::now();
+    lag_ = std::chrono::duration_cast<std::chrono::microseconds>(
+	std::max(now - deadline_, std::chrono::steady_clock::duration(0)));
+    maxLag_ = std::max(maxLag_, lag_);
+
+    // Deadlines missed since; drop those past the catch-up allowance.
+    auto missed = static_cast<std::uint64_t>(lag_ / period_);
+    if (missed > MaxCatchUp) {
+	const auto skipped = missed - MaxCatchUp;
+	LOGGER_MAIN() << "Pulse overran by " << lag_.count() / 1000
+	    << "ms; dropped " << skipped << " pulse(s).";
+	dropped_ += skipped;
+	deadline_ += period_ * static_cast<std::chrono::milliseconds::rep>(
+	    skipped);
+	missed = MaxCatchUp;
+    }
+
+    for (std::uint64_t n = 0; n <= missed && running_; ++n) {
+	this->Dispatch();
+	deadline_ += period_;
+    }
+}
+
+}; // namespace Utility
+}; // namespace Scratch
@@ -8,7 +8,10 @@
 
 #define _SCRATCH_SERVER_CPP_
 
+#include <scratch/config.hpp>
+#include <scratch/data.hpp>
 #include <scratch/game.hpp>
+#include <scratch/gateway.hpp>
 #include <scratch/logger.hpp>
 #include <scratch/scratch.hpp>
 #include <scratch/server.hpp>
@@ -24,11 +27,17 @@ using ResolverQuery = boost::asio::ip::tcp::resolver::query;
 using Socket = boost::asio::ip::tcp::socket;
 using Tcp = boost::asio::ip::tcp;
 
+// ScratchMUD types.
+using Data = Scratch::Utility::Data;
+
 //! Constructor.
 //! \param game the game state
 Server::Server(Game& game) noexcept :
 	game_(game),
-	acceptor_(game.GetIoContext()) {
+	acceptor_(game.GetIoContext()),
+	admission_(),
+	gateway_(),
+	webSocketAcceptor_(game.GetIoContext()) {
     // Nothing.
 }
 
@@ -37,14 +46,73 @@ Server::~Server() noexcept {
     this->StopAcceptor();
 }
 
-//! Starts the acceptor and begins to accept connections.
+//! Returns whether the listener for a protocol is open.
+//! \param protocolType the wire protocol
+bool Server::IsListening(const ProtocolType protocolType) const noexcept {
+    if (protocolType == PROTOCOL_WEBSOCKET)
+	return webSocketAcceptor_.is_open();
+    return acceptor_.is_open();
+}
+
+//! Adopts handed-off listening sockets and begins to accept
+//! connections.
+//! \param data the handoff record
+//! \return \c true if the TELNET listening socket was adopted
+//! \sa #SaveHandoff(const DataPtr&)
+bool Server::ResumeAcceptor(const DataPtr& data) {
+    if (!this->AdoptAcceptor(acceptor_, data))
+	return false;
+    this->InitAdmission();
+
+    ErrorCode errorCode;
+    LOGGER_NETWORK() << "Server resumed listening on " << acceptor_.local_endpoint(errorCode) << ".";
+
+    // Accept connections.
+    this->InitAsyncAccept(PROTOCOL_TELNET);
+
+    // Adopt WebSocket listener.
+    auto webSocketData = data->Get("WebSocket");
+    if (webSocketData && this->AdoptAcceptor(webSocketAcceptor_, webSocketData)) {
+	LOGGER_NETWORK() << "Server resumed listening for WebSocket on " << webSocketAcceptor_.local_endpoint(errorCode) << ".";
+	this->InitAsyncAccept(PROTOCOL_WEBSOCKET);
+    }
+    return true;
+}
+
+//! Records the listening sockets for a hot reboot.
+//! \param data the handoff record
+//! \remark The WebSocket listener, if open, is nested under
+//!     \c WebSocket.
+//! \sa #ResumeAcceptor(const DataPtr&)
+void Server::SaveHandoff(const DataPtr& data) {
+    if (!acceptor_.is_open())
+	return;
+
+    ErrorCode errorCode;
+    const auto endpoint = acceptor_.local_endpoint(errorCode);
+    data->PutNumber("Socket", acceptor_.native_handle());
+    data->PutYesNo("V6", !errorCode && endpoint.address().is_v6());
+
+    // Write WebSocket listener.
+    if (webSocketAcceptor_.is_open()) {
+	auto webSocketData = std::make_shared<Data>();
+	const auto webSocketEndpoint = webSocketAcceptor_.local_endpoint(errorCode);
+	webSocketData->PutNumber("Socket", webSocketAcceptor_.native_handle());
+	webSocketData->PutYesNo("V6", !errorCode && webSocketEndpoint.address().is_v6());
+	data->Put("WebSocket", webSocketData);
+    }
+}
+
+//! Starts an acceptor and begins to accept connections.
 //! \param port the network port upon which to listen
 //! \param address the network address to bind
-//! \sa #StartAcceptor(const Endpoint&)
+//! \param protocolType the wire protocol for accepted connections
+//! \sa #StartAcceptor(const Endpoint&, const ProtocolType)
 //! \sa #StopAcceptor()
 void Server::StartAcceptor(
 	const std::uint16_t port,
-	const String& address) {
+	const String& address,
+	const ProtocolType protocolType) {
     Endpoint endpoint(Tcp::v4(), port);
     if (!address.empty()) {
 	Resolver resolver(game_.GetIoContext());
@@ -55,47 +123,129 @@ void Server::StartAcceptor(
 		break;
 	}
     }
-    this->StartAcceptor(endpoint);
+    this->StartAcceptor(endpoint, protocolType);
 }
 
-//! Starts the acceptor and begins to accept connections.
+//! Starts an acceptor and begins to accept connections.
 //! \param endpoint the network endpoint
-//! \sa #StartAcceptor(const std::uint16_t, const String&)
+//! \param protocolType the wire protocol for accepted connections
+//! \sa #StartAcceptor(const std::uint16_t, const String&, const ProtocolType)
 //! \sa #StopAcceptor()
-void Server::StartAcceptor(const Endpoint& endpoint) {
+void Server::StartAcceptor(
+	const Endpoint& endpoint,
+	const ProtocolType protocolType) {
+    // Listeners share one admission table; configure it once.
+    if (!this->IsAnyListening())
+	this->InitAdmission();
+
     // Configure acceptor.
-    acceptor_.open(endpoint.protocol());
-    acceptor_.bind(endpoint);
-    acceptor_.listen();
+    auto& acceptor = this->GetAcceptor(protocolType);
+    acceptor.open(endpoint.protocol());
+    acceptor.bind(endpoint);
+    acceptor.listen();
 
-    LOGGER_NETWORK() << "Server listening on " << acceptor_.local_endpoint() << ".";
+    LOGGER_NETWORK() << "Server listening"
+	<< (protocolType == PROTOCOL_WEBSOCKET ? " for WebSocket" : "")
+	<< " on " << acceptor.local_endpoint() << ".";
 
     // Accept connections.
-    this->InitAsyncAccept();
+    this->InitAsyncAccept(protocolType);
 }
 
-//! Stops the acceptor.
-//! \sa #StartAcceptor(const std::uint16_t, const String&)
-//! \sa #StartAcceptor(const Endpoint&)
+//! Listens for \c scratch-gateway on a Unix socket.
+//! \param path the Unix socket path
+//! \sa #StopAcceptor()
+void Server::StartGateway(const String& path) {
+    if (!this->IsAnyListening())
+	this->InitAdmission();
+
+    gateway_ = std::make_shared<Gateway>(game_, admission_);
+    gateway_->Start(path);
+}
+
+//! Stops every acceptor and the gateway channel.
+//! \sa #StartAcceptor(const std::uint16_t, const String&, const ProtocolType)
+//! \sa #StartAcceptor(const Endpoint&, const ProtocolType)
+//! \sa #StartGateway(const String&)
 void Server::StopAcceptor() {
-    if (!acceptor_.is_open())
+    if (!this->IsAnyListening())
 	return;
 
-    // Closing the acceptor cancels any pending async_accept.
+    // Gateway sessions read eof and close.
+    if (gateway_) {
+	gateway_->Stop();
+	gateway_.reset();
+    }
+
+    // Closing an acceptor cancels any pending async_accept.
+    for (auto* acceptor: {&acceptor_, &webSocketAcceptor_}) {
+	if (!acceptor->is_open())
+	    continue;
+	ErrorCode errorCode;
+	acceptor->close(errorCode);
+	if (errorCode) {
+	    LOGGER_NETWORK() << "Error closing acceptor.";
+	    LOGGER_NETWORK() << " >> " << errorCode;
+	    LOGGER_NETWORK() << " >> " << errorCode.message();
+	}
+    }
+    LOGGER_NETWORK() << "Server stopped accepting connections.";
+}
+
+//! Adopts one handed-off listening socket.
+//! \param acceptor the acceptor to assign
+//! \param data the handoff record
+//! \return \c true if the listening socket was adopted
+bool Server::AdoptAcceptor(
+	Acceptor& acceptor,
+	const DataPtr& data) {
+    const auto handle = static_cast<int>(data->GetNumber("Socket", -1));
+    if (handle < 0)
+	return false;
+
     ErrorCode errorCode;
-    acceptor_.close(errorCode);
+    acceptor.assign(data->GetYesNo("V6", false) ? Tcp::v6() : Tcp::v4(),
+	handle, errorCode);
     if (errorCode) {
-	LOGGER_NETWORK() << "Error closing acceptor.";
+	LOGGER_NETWORK() << "Error adopting acceptor.";
 	LOGGER_NETWORK() << " >> " << errorCode;
 	LOGGER_NETWORK() << " >> " << errorCode.message();
-    } else {
-	LOGGER_NETWORK() << "Server stopped accepting connections.";
+	::close(handle);
+	return false;
     }
+    return true;
+}
+
+//! Returns the acceptor for a protocol.
+//! \param protocolType the wire protocol
+Acceptor& Server::GetAcceptor(const ProtocolType protocolType) noexcept {
+    if (protocolType == PROTOCOL_WEBSOCKET)
+	return webSocketAcceptor_;
+    return acceptor_;
+}
+
+//! Returns whether any acceptor or the gateway channel is listening.
+bool Server::IsAnyListening() const noexcept {
+    return acceptor_.is_open() || webSocketAcceptor_.is_open() ||
+	(gateway_ && gateway_->IsListening());
+}
+
+//! Applies configured limits and loads the ban list.
+void Server::InitAdmission() {
+    if (auto config = game_.GetConfig()) {
+	admission_.SetLimits(
+	    config->GetConnectRate(),
+	    config->GetConnectBurst(),
+	    config->GetConnectLimit());
+    }
+    admission_.LoadBans();
 }
 
 //! Configures an asynchronous accept.
-void Server::InitAsyncAccept() {
-    acceptor_.async_accept([this](ErrorCode ec, Socket&& s) {
+//! \param protocolType the wire protocol for accepted connections
+void Server::InitAsyncAccept(const ProtocolType protocolType) {
+    auto& acceptor = this->GetAcceptor(protocolType);
+    acceptor.async_accept([this, protocolType](ErrorCode ec, Socket&& s) {
 	if (ec || game_.GetShutdown()) {
 	    if (ec && ec != boost::asio::error::operation_aborted) {
 		LOGGER_NETWORK() << "Error accepting connection.";
@@ -105,9 +255,19 @@ void Server::InitAsyncAccept() {
 	    return;
 	}
 
-	LOGGER_NETWORK() << "Received connection from " << s.remote_endpoint() << ".";
-	game_.MakeDescriptor(std::move(s));
-	this->InitAsyncAccept();
+	// Screen connection before building a descriptor.
+	ErrorCode errorCode;
+	const auto remote = s.remote_endpoint(errorCode);
+	if (errorCode ||
+		admission_.Admit(remote.address()) != Admission::ADMIT) {
+	    s.close(errorCode);
+	    this->InitAsyncAccept(protocolType);
+	    return;
+	}
+
+	LOGGER_NETWORK() << "Received connection from " << remote << ".";
+	game_.MakeDescriptor(std::move(s), protocolType);
+	this->InitAsyncAccept(protocolType);
     });
 }
 
@@ -0,0 +1,107 @@
+//! \file shard.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_SHARD_CPP_
+
+#include <scratch/game.hpp>
+#include <scratch/lua.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/shard.hpp>
+#include <scratch/shard_bindings.hpp>
+#include <scratch/string.hpp>
+
+namespace Scratch {
+namespace Core {
+
+// ScratchMUD types.
+using ShardBindings = Scratch::Scripting::ShardBindings;
+
+//! Constructor.
+//! \param game the game state
+Shard::Shard(Game& game) :
+	buffer_(),
+	game_(game),
+	instance_(),
+	lua_(new Lua(game, Lua::BINDINGS_SHARD)) {
+    ShardBindings::Bind(*lua_, *this);
+}
+
+//! Destructor.
+Shard::~Shard() noexcept {
+    // Nothing.
+}
+
+//! Replays and clears the command buffer.
+//! \remark Game thread only. Effects for instances erased since
+//!     they were recorded are dropped.
+void Shard::Apply() {
+    // Swap first so the buffer is left empty even if an effect throws.
+    std::vector<Deferred> buffer;
+    buffer.swap(buffer_);
+    for (auto& deferred: buffer) {
+	const auto& actor = deferred.actor;
+	if (!actor || game_.GetInstance(actor->GetName()) != actor)
+	    continue;
+	if (deferred.metacolor == Color::C_UNDEFINED) {
+	    game_.DispatchCommand(actor, deferred.text);
+	} else {
+	    game_.Action(deferred.metacolor, deferred.targets, deferred.text,
+		actor, deferred.params[0], deferred.params[1],
+		deferred.params[2]);
+	}
+    }
+}
+
+//! Records an effect of the running hook.
+//! \param deferred the effect
+void Shard::Defer(Deferred deferred) {
+    buffer_.push_back(std::move(deferred));
+}
+
+//! Runs instance pulse hooks on this shard's Lua state.
+//! \param pulse the pulse number
+//! \param hooks the hooks due on \p pulse
+//! \param store the instance registry
+//! \param positions the dense positions of this shard's instances
+//! \remark Safe on a pool thread while the game thread waits.
+//!     Names and players are read from the store columns.
+void Shard::Run(
+	const std::uint64_t pulse,
+	const std::vector<Hook>& hooks,
+	const InstanceStore& store,
+	const std::vector<std::size_t>& positions) {
+    auto& lua = *lua_;
+    const auto& instances = store.GetColumn<InstancePtr>();
+    const auto& names = store.GetColumn<String>();
+    const auto& players = store.GetColumn<PlayerPtr>();
+    for (const auto n: positions) {
+	instance_ = instances[n];
+	if (!instance_)
+	    continue;
+	const auto& name = names[n];
+	const auto& player = players[n];
+	for (auto& hook: hooks) {
+	    Lua::Caller caller(lua, hook.name + ":Pulse");
+	    if (!caller.IsActive())
+		continue;
+	    lua.PushInt(static_cast<lua_Integer>(pulse));
+	    lua.SetEnv("pulse");
+	    lua.PushString(name);
+	    lua.SetEnv("name");
+	    if (player) {
+		lua.PushString(player->GetName());
+		lua.SetEnv("player");
+	    }
+	    lua.Execute(hook.source);
+	}
+    }
+    instance_.reset();
+}
+
+}; // namespace Core
+}; // namespace Scratch
@@ -0,0 +1,154 @@
+//! \file shard_bindings.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_SHARD_BINDINGS_CPP_
+
+#include <scratch/color.hpp>
+#include <scratch/command_bindings.hpp>
+#include <scratch/logger.hpp>
+#include <scratch/lua.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/shard.hpp>
+#include <scratch/shard_bindings.hpp>
+#include <scratch/string.hpp>
+
+namespace Scratch {
+namespace Scripting {
+
+// ScratchMUD types.
+using ActionParam = Scratch::Core::ActionParam;
+using Color = Scratch::Net::Color;
+
+//! Registry key for the owning shard pointer.
+static char shardRegistryKey;
+
+//! Resolves a text or number action slot at \p index.
+//! \param L the \c lua_State
+//! \param index the stack index of the slot
+//! \remark Instances live in other shards, so they cannot be slots here.
+static ActionParam CheckActionParam(
+	lua_State* L,
+	const int index) {
+    if (lua_isnoneornil(L, index))
+	return ActionParam();
+    const int type = lua_type(L, index);
+    if (type == LUA_TNUMBER)
+	return ActionParam(lua_tonumber(L, index));
+    if (type == LUA_TSTRING)
+	return ActionParam(Lua::CheckString(L, index));
+    luaL_argerror(L, index, "expected string or number");
+    return ActionParam();
+}
+
+//! Handles lua action(color, targets, message, ...) for the running
+//! instance; deferred to the end of the pulse.
+//! \param L the \c lua_State
+static int ActionProxy(lua_State* L) {
+    const int argc = lua_gettop(L);
+    if (argc < 3 || argc > 6)
+	return luaL_error(L, "action expects 3 to 6 arguments");
+    luaL_checktype(L, 1, LUA_TSTRING);
+    luaL_checktype(L, 2, LUA_TNUMBER);
+    luaL_checktype(L, 3, LUA_TSTRING);
+
+    const auto metacolor = Color::ByName(Lua::CheckString(L, 1));
+    if (!Color::IsMeta(metacolor) && !Color::IsReal(metacolor))
+	return luaL_argerror(L, 1, "invalid color");
+    auto& shard = ShardBindings::Check(L);
+    if (!shard.GetInstance())
+	return luaL_error(L, "action expects a running instance");
+
+    Shard::Deferred deferred;
+    deferred.actor = shard.GetInstance();
+    deferred.metacolor = metacolor;
+    deferred.targets = static_cast<unsigned>(lua_tointeger(L, 2));
+    deferred.text = Lua::CheckString(L, 3);
+    for (int n = 0; n < 3; ++n)
+	deferred.params[n] = CheckActionParam(L, 4 + n);
+    shard.Defer(std::move(deferred));
+    return 0;
+}
+
+//! Handles lua dispatch_command(line) for the running instance;
+//! deferred to the end of the pulse.
+//! \param L the \c lua_State
+static int DispatchCommandProxy(lua_State* L) {
+    if (lua_gettop(L) != 1)
+	return luaL_error(L, "dispatch_command expects 1 argument");
+    luaL_checktype(L, 1, LUA_TSTRING);
+    auto& shard = ShardBindings::Check(L);
+    if (!shard.GetInstance())
+	return luaL_error(L, "dispatch_command expects a running instance");
+
+    Shard::Deferred deferred;
+    deferred.actor = shard.GetInstance();
+    deferred.metacolor = Color::C_UNDEFINED;
+    deferred.targets = 0;
+    deferred.text = Lua::CheckString(L, 1);
+    shard.Defer(std::move(deferred));
+    return 0;
+}
+
+//! Handles lua print — writes to LOGGER_LUA.
+//! \param L the \c lua_State
+static int PrintProxy(lua_State* L) {
+    const int howMany = lua_gettop(L);
+    luaL_Buffer buffer;
+    luaL_buffinit(L, &buffer);
+    for (auto n = 1; n <= howMany; ++n) {
+	if (n > 1)
+	    luaL_addchar(&buffer, '\t');
+	luaL_tolstring(L, n, nullptr);
+	luaL_addvalue(&buffer);
+    }
+    luaL_pushresult(&buffer);
+    LOGGER_LUA() << Lua::CheckString(L, -1);
+    lua_pop(L, 1);
+    return 0;
+}
+
+//! Attaches \p shard to its worker Lua state.
+//! \param lua the Lua facade
+//! \param shard the shard that owns \p lua
+void ShardBindings::Bind(
+	Lua& lua,
+	Shard& shard) {
+    auto* L = lua.GetState();
+    lua_pushlightuserdata(L, &shardRegistryKey);
+    lua_pushlightuserdata(L, &shard);
+    lua_settable(L, LUA_REGISTRYINDEX);
+}
+
+//! Resolves the shard that owns a worker Lua state.
+//! \param L the \c lua_State
+//! \return the shard
+Shard& ShardBindings::Check(lua_State* L) {
+    lua_pushlightuserdata(L, &shardRegistryKey);
+    lua_gettable(L, LUA_REGISTRYINDEX);
+    auto shard = static_cast<Shard*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+    if (!shard)
+	luaL_error(L, "Shard not found in registry");
+    return *shard;
+}
+
+//! Registers shard free functions on \p lua.
+//! \param lua the Lua facade
+void ShardBindings::Register(Lua& lua) {
+    lua.PushFunction(ActionProxy);
+    lua.SetSafe("action");
+    lua.PushFunction(DispatchCommandProxy);
+    lua.SetSafe("dispatch_command");
+    lua.PushFunction(PrintProxy);
+    lua.SetSafe("print");
+
+    CommandBindings::RegisterTargets(lua);
+}
+
+}; // namespace Scripting
+}; // namespace Scratch
@@ -15,6 +15,97 @@
 namespace Scratch {
 namespace Algorithm {
 
+namespace {
+
+//! Folds an ASCII letter to lower case.
+//! \param c the character to fold
+//! \remark Matches \c std::tolower in the "C" locale without a table
+//!     lookup; other bytes are returned unchanged.
+inline char FoldCi(const char c) noexcept {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c | 0x20) : c;
+}
+
+#if defined(HAVE_IMMINTRIN_H) && defined(__AVX2__)
+//! Folds thirty-two ASCII letters to lower case.
+//! \param v the characters to fold
+inline __m256i FoldCi(const __m256i v) noexcept {
+    // Bytes above 0x7f compare negative and are never letters.
+    const auto upper = _mm256_and_si256(
+	    _mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+	    _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+    return _mm256_or_si256(v,
+	    _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+#endif // HAVE_IMMINTRIN_H && __AVX2__
+
+#if defined(HAVE_IMMINTRIN_H) && defined(__SSE2__)
+//! Folds sixteen ASCII letters to lower case.
+//! \param v the characters to fold
+inline __m128i FoldCi(const __m128i v) noexcept {
+    // Bytes above 0x7f compare negative and are never letters.
+    const auto upper = _mm_and_si128(
+	    _mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+	    _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+#endif // HAVE_IMMINTRIN_H && __SSE2__
+
+//! Finds the first case-insensitive mismatch.
+//! \param left the first range
+//! \param right the second range
+//! \param size the length of both ranges
+//! \return the index of the first mismatch, or \p size if none
+std::size_t MismatchCi(
+	const char* left,
+	const char* right,
+	const std::size_t size) noexcept {
+    std::size_t n = 0;
+#if defined(HAVE_IMMINTRIN_H) && defined(__AVX2__)
+    for (; n + 32 <= size; n += 32) {
+	const auto l = FoldCi(_mm256_loadu_si256(
+		reinterpret_cast<const __m256i*>(left + n)));
+	const auto r = FoldCi(_mm256_loadu_si256(
+		reinterpret_cast<const __m256i*>(right + n)));
+	const auto same = static_cast<std::uint32_t>(
+		_mm256_movemask_epi8(_mm256_cmpeq_epi8(l, r)));
+	if (same != 0xffffffffu)
+	    return n + __builtin_ctz(~same);
+    }
+#endif // HAVE_IMMINTRIN_H && __AVX2__
+#if defined(HAVE_IMMINTRIN_H) && defined(__SSE2__)
+    for (; n + 16 <= size; n += 16) {
+	const auto l = FoldCi(_mm_loadu_si128(
+		reinterpret_cast<const __m128i*>(left + n)));
+	const auto r = FoldCi(_mm_loadu_si128(
+		reinterpret_cast<const __m128i*>(right + n)));
+	const auto same = static_cast<std::uint32_t>(
+		_mm_movemask_epi8(_mm_cmpeq_epi8(l, r)));
+	if (same != 0xffffu)
+	    return n + __builtin_ctz(~same);
+    }
+#endif // HAVE_IMMINTRIN_H && __SSE2__
+    while (n < size && FoldCi(left[n]) == FoldCi(right[n]))
+	++n;
+    return n;
+}
+
+//! Folds eight ASCII letters to lower case.
+//! \param word the characters to fold
+inline std::uint64_t FoldCi(const std::uint64_t word) noexcept {
+    const std::uint64_t ones = 0x0101010101010101ull;
+    const std::uint64_t highs = 0x8080808080808080ull;
+
+    // Per byte, the high bit of low7 + 0x80 - c is set iff low7 >= c;
+    // low7 is at most 0x7f so no byte carries into the next.
+    const auto low7 = word & ~highs;
+    const auto aboveA = low7 + (0x80 - 'A') * ones;
+    const auto aboveZ = low7 + (0x80 - 'Z' - 1) * ones;
+    const auto upper = aboveA & ~aboveZ & ~word & highs;
+    return word | (upper >> 2);
+}
+
+} // namespace
+
 //! Capitalizes the first non-space letter.
 //! \param str the string to capitalize
 //! \sa StringCapitalizeCopy(const String&)
@@ -73,26 +164,39 @@ String StringChopCopy(
 int StringCompareCi(
 	const String& left,
 	const String& right) {
-    // Comparison result.
-    auto cmp = 0;
+    return StringCompareCi(left.data(), left.size(),
+	right.data(), right.size());
+}
 
+//! Compares character ranges.
+//! \param left the first range to compare
+//! \param leftSize the length of \p left
+//! \param right the second range to compare
+//! \param rightSize the length of \p right
+//! \return < 0 if \a left is less than \a right;
+//!         > 0 if \a left is greater than \a right;
+//!           0 if the specified ranges are equal
+int StringCompareCi(
+	const char* left,
+	const std::size_t leftSize,
+	const char* right,
+	const std::size_t rightSize) noexcept {
     // Search for first non-same character.
-    auto leftIt = std::begin(left), leftEnd = std::end(left);
-    auto rightIt = std::begin(right), rightEnd = std::end(right);
-    for (; !cmp && leftIt != leftEnd && rightIt != rightEnd; ++leftIt, ++rightIt) {
-	cmp = std::tolower(*leftIt) - std::tolower(*rightIt);
-    }
+    const auto size = std::min(leftSize, rightSize);
+    const auto n = MismatchCi(left, right, size);
 
-    // Return if non-same character found.
-    if (cmp)
-	return cmp;
+    // Return if non-same character found; bytes order as unsigned.
+    if (n < size) {
+	return static_cast<unsigned char>(FoldCi(left[n])) -
+	    static_cast<unsigned char>(FoldCi(right[n]));
+    }
 
     // Left string shorter.
-    if (leftIt == leftEnd && rightIt != rightEnd)
+    if (leftSize < rightSize)
 	return -1;
 
     // Right string shorter.
-    if (leftIt != leftEnd && rightIt == rightEnd)
+    if (leftSize > rightSize)
 	return +1;
 
     // Equal strings.
@@ -120,8 +224,8 @@ bool StringEndsWithCi(
 	const String& suffix) {
     if (suffix.size() > str.size())
 	return false;
-    return StringCompareCi(
-	    str.substr(str.size() - suffix.size()), suffix) == 0;
+    return MismatchCi(str.data() + str.size() - suffix.size(),
+	suffix.data(), suffix.size()) == suffix.size();
 }
 
 //! Hashes a plaintext string.
@@ -217,6 +321,31 @@ String StringGenerateCopy() {
     return StringGenerate(str);
 }
 
+//! Hashes \p str case-insensitively.
+//! \param str the string to hash
+std::size_t StringHashCi::operator()(const StringView& str) const noexcept {
+    const std::uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+    std::uint64_t hash = str.size() * multiplier;
+
+    // Whole words, then the zero-padded tail.
+    const auto data = str.data();
+    const auto size = str.size();
+    std::size_t n = 0;
+    for (; n + 8 <= size; n += 8) {
+	std::uint64_t word;
+	std::memcpy(&word, data + n, 8);
+	hash = (hash ^ FoldCi(word)) * multiplier;
+	hash ^= hash >> 32;
+    }
+    if (n < size) {
+	std::uint64_t word = 0;
+	std::memcpy(&word, data + n, size - n);
+	hash = (hash ^ FoldCi(word)) * multiplier;
+	hash ^= hash >> 32;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
 //! Joins strings with a separator.
 //! \param sep the separator inserted between elements
 //! \param parts the strings to join
@@ -321,7 +450,8 @@ bool StringStartsWithCi(
 	const String& prefix) {
     if (prefix.size() > str.size())
 	return false;
-    return StringCompareCi(str.substr(0, prefix.size()), prefix) == 0;
+    return MismatchCi(str.data(), prefix.data(), prefix.size()) ==
+	prefix.size();
 }
 
 //! Removes color codes from a string.
@@ -0,0 +1,83 @@
+//! \file symbol_table.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_SYMBOL_TABLE_CPP_
+
+#include <scratch/scratch.hpp>
+#include <scratch/string.hpp>
+#include <scratch/symbol_table.hpp>
+
+namespace Scratch {
+namespace Core {
+
+//! Default constructor.
+SymbolTable::SymbolTable() noexcept :
+	symbols_() {
+    // Nothing.
+}
+
+//! Destructor.
+SymbolTable::~SymbolTable() noexcept {
+    // Nothing.
+}
+
+//! Interns \p name.
+//! \param name the name
+//! \return the symbol, or #NoSymbol if the table is full
+unsigned SymbolTable::Intern(const String& name) {
+    auto it = symbols_.find(name);
+    if (it != std::end(symbols_))
+	return it->second;
+    if (symbols_.size() >= MaxSymbols)
+	return NoSymbol;
+    const auto symbol = static_cast<unsigned>(symbols_.size());
+    symbols_.emplace(name, symbol);
+    return symbol;
+}
+
+//! Looks up \p name without interning it.
+//! \param name the name
+//! \return the symbol, or #NoSymbol
+unsigned SymbolTable::Lookup(const String& name) const noexcept {
+    auto it = symbols_.find(name);
+    return it != std::end(symbols_) ? it->second : NoSymbol;
+}
+
+//! Interns every name in \p names.
+//! \param names the names
+//! \param bits receives the symbols
+//! \return \c false if a name could not be interned
+bool SymbolTable::MakeBits(
+	const StringSetCi& names,
+	Bits& bits) {
+    bool complete = true;
+    bits.reset();
+    for (const auto& name: names) {
+	const auto symbol = this->Intern(name);
+	if (symbol == NoSymbol)
+	    complete = false;
+	else
+	    bits.set(symbol);
+    }
+    return complete;
+}
+
+//! Gets the permission table.
+SymbolTable& SymbolTable::Permissions() noexcept {
+    static SymbolTable permissions;
+    return permissions;
+}
+
+//! Gets the preference table.
+SymbolTable& SymbolTable::Preferences() noexcept {
+    static SymbolTable preferences;
+    return preferences;
+}
+
+}; // namespace Core
+}; // namespace Scratch
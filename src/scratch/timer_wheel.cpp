@@ -0,0 +1,224 @@
+//! \file timer_wheel.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_TIMER_WHEEL_CPP_
+
+#include <scratch/logger.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/timer_wheel.hpp>
+
+namespace Scratch {
+namespace Utility {
+
+//! The tick duration.
+const std::chrono::milliseconds TimerWheel::Tick(100);
+
+//! Default constructor.
+TimerWheel::Timer::Timer() noexcept :
+	expiry_(0),
+	handler_(),
+	next_(nullptr),
+	prev_(nullptr),
+	wheel_(nullptr) {
+    // Nothing.
+}
+
+//! Destructor.
+TimerWheel::Timer::~Timer() noexcept {
+    this->Cancel();
+}
+
+//! Cancels the timer if armed.
+//! \sa #IsArmed() const
+void TimerWheel::Timer::Cancel() noexcept {
+    if (wheel_)
+	wheel_->Cancel(*this);
+}
+
+//! Constructor.
+//! \param ioContext the IO context
+TimerWheel::TimerWheel(IoContext& ioContext) :
+	current_(0),
+	origin_(std::chrono::steady_clock::now()),
+	size_(0),
+	slots_(),
+	steadyTimer_(ioContext),
+	ticking_(false) {
+    // Nothing.
+}
+
+//! Destructor.
+//! \remark Disarms every timer still in the wheel.
+TimerWheel::~TimerWheel() noexcept {
+    this->Clear();
+}
+
+//! Arms a timer, re-arming it if already armed.
+//! \param timer the timer to arm
+//! \param delay the delay before \p handler runs
+//! \param handler the expiry handler
+//! \remark Delays round up to whole ticks and clamp to the wheel span.
+//! \sa #Cancel(Timer&)
+void TimerWheel::Arm(
+	Timer& timer,
+	const std::chrono::milliseconds delay,
+	Handler handler) noexcept {
+    if (timer.wheel_)
+	timer.wheel_->Cancel(timer);
+
+    // Idle wheel; skip the ticks nobody waited for.
+    if (!size_ && !ticking_) {
+	current_ = static_cast<std::uint64_t>(
+	    (std::chrono::steady_clock::now() - origin_) / Tick);
+    }
+
+    // Round up to whole ticks, at least one, within the wheel span.
+    const std::uint64_t maxTicks = (std::uint64_t(1) << (SlotBits * Levels)) - 1;
+    auto ticks = static_cast<std::uint64_t>(
+	std::max<std::chrono::milliseconds::rep>(1,
+	    (delay.count() + Tick.count() - 1) / Tick.count()));
+    ticks = std::min(ticks, maxTicks);
+
+    timer.expiry_ = current_ + ticks;
+    timer.handler_ = std::move(handler);
+    this->Link(timer);
+
+    if (!ticking_)
+	this->InitAsyncWait();
+}
+
+//! Cancels a timer.
+//! \param timer the timer to cancel
+//! \sa #Arm(Timer&, const std::chrono::milliseconds, Handler)
+void TimerWheel::Cancel(Timer& timer) noexcept {
+    if (timer.wheel_ != this)
+	return;
+    this->Unlink(timer);
+    timer.handler_ = nullptr;
+}
+
+//! Cancels every timer and stops the steady timer.
+void TimerWheel::Clear() noexcept {
+    for (auto& level: slots_) {
+	for (auto& slot: level) {
+	    while (slot) {
+		auto& timer = *slot;
+		this->Unlink(timer);
+		timer.handler_ = nullptr;
+	    }
+	}
+    }
+
+    ErrorCode errorCode;
+    steadyTimer_.cancel(errorCode);
+    ticking_ = false;
+}
+
+//! Advances the wheel to the present, running expired timers.
+void TimerWheel::Advance() noexcept {
+    const auto now = static_cast<std::uint64_t>(
+	(std::chrono::steady_clock::now() - origin_) / Tick);
+
+    // Catch up one tick at a time; cascade when a level wraps.
+    while (size_ && current_ <= now) {
+	const unsigned index = current_ & (Slots - 1);
+	if (!index) {
+	    for (unsigned level = 1; level < Levels; ++level) {
+		if (this->Cascade(level))
+		    break;
+	    }
+	}
+
+	// Disarm before running; the handler may re-arm or free the timer.
+	while (auto timer = slots_[0][index]) {
+	    this->Unlink(*timer);
+	    auto handler = std::move(timer->handler_);
+	    timer->handler_ = nullptr;
+	    if (handler)
+		handler();
+	}
+	++current_;
+    }
+}
+
+//! Re-inserts the timers of a higher-level slot.
+//! \param level the level to cascade
+//! \return the cascaded slot index
+unsigned TimerWheel::Cascade(const unsigned level) noexcept {
+    const unsigned index = (current_ >> (SlotBits * level)) & (Slots - 1);
+    auto timer = slots_[level][index];
+    slots_[level][index] = nullptr;
+    while (timer) {
+	auto next = timer->next_;
+	--size_;
+	this->Link(*timer);
+	timer = next;
+    }
+    return index;
+}
+
+//! Begins waiting for the next tick.
+void TimerWheel::InitAsyncWait() {
+    ticking_ = true;
+    steadyTimer_.expires_at(origin_ +
+	Tick * static_cast<std::chrono::milliseconds::rep>(current_));
+    steadyTimer_.async_wait(std::function<void(const ErrorCode&)>(
+	[this](const ErrorCode& errorCode) {
+	    if (errorCode == boost::asio::error::operation_aborted) {
+		// Clear() owns the ticking bit.
+		return;
+	    } else if (errorCode) {
+		LOGGER_SYSTEM() << "Error waiting for timer wheel tick.";
+		LOGGER_SYSTEM() << " >> " << errorCode;
+		LOGGER_SYSTEM() << " >> " << errorCode.message();
+		ticking_ = false;
+		return;
+	    }
+
+	    this->Advance();
+	    ticking_ = false;
+	    if (size_)
+		this->InitAsyncWait();
+	}));
+}
+
+//! Links a timer into the slot for its expiry.
+//! \param timer the timer to link
+void TimerWheel::Link(Timer& timer) noexcept {
+    // Lowest level whose span covers the remaining ticks.
+    const auto delta = timer.expiry_ > current_ ? timer.expiry_ - current_ : 0;
+    const auto expiry = timer.expiry_ > current_ ? timer.expiry_ : current_;
+    unsigned level = 0;
+    while (level + 1 < Levels &&
+	    delta >= (std::uint64_t(1) << (SlotBits * (level + 1))))
+	++level;
+
+    auto& head = slots_[level][(expiry >> (SlotBits * level)) & (Slots - 1)];
+    timer.next_ = head;
+    if (head)
+	head->prev_ = &timer.next_;
+    timer.prev_ = &head;
+    head = &timer;
+    timer.wheel_ = this;
+    ++size_;
+}
+
+//! Unlinks a timer from its slot.
+//! \param timer the timer to unlink
+void TimerWheel::Unlink(Timer& timer) noexcept {
+    *timer.prev_ = timer.next_;
+    if (timer.next_)
+	timer.next_->prev_ = timer.prev_;
+    timer.next_ = nullptr;
+    timer.prev_ = nullptr;
+    timer.wheel_ = nullptr;
+    --size_;
+}
+
+}; // namespace Utility
+}; // namespace Scratch
@@ -0,0 +1,164 @@
+//! \file transport_gateway.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_TRANSPORT_GATEWAY_CPP_
+
+#include <scratch/gateway.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/transport_gateway.hpp>
+
+namespace Scratch {
+namespace Net {
+
+//! Constructor.
+//! \param ioContext the I/O context that runs completions
+//! \param gateway the channel multiplexer
+//! \param session the session ID
+//! \param address the remote address reported by the gateway
+GatewayTransport::GatewayTransport(
+	IoContext& ioContext,
+	const GatewayWeakPtr& gateway,
+	const std::uint32_t session,
+	const Address& address) noexcept :
+	address_(address),
+	gateway_(gateway),
+	input_(),
+	ioContext_(ioContext),
+	open_(true),
+	readBuffer_(),
+	readHandler_(),
+	remoteClosed_(false),
+	session_(session) {
+    // Nothing.
+}
+
+//! Destructor.
+GatewayTransport::~GatewayTransport() noexcept {
+    ErrorCode errorCode;
+    this->Close(errorCode);
+}
+
+//! Reads some bytes.
+//! \param buffer the buffer to fill
+//! \param handler the completion handler
+void GatewayTransport::AsyncRead(
+	const MutableBuffer& buffer,
+	Handler handler) {
+    readBuffer_ = buffer;
+    readHandler_ = std::move(handler);
+    this->CompleteRead();
+}
+
+//! Writes every byte of \p buffers.
+//! \param buffers the bytes to write
+//! \param handler the completion handler
+void GatewayTransport::AsyncWrite(
+	const ConstBuffersType& buffers,
+	Handler handler) {
+    auto gateway = gateway_.lock();
+    if (!open_ || !gateway) {
+	boost::asio::post(ioContext_, [handler]() {
+	    handler(boost::asio::error::operation_aborted, 0);
+	});
+	return;
+    }
+
+    // Frames are copied into the channel queue, so flatten once here.
+    String payload(boost::asio::buffer_size(buffers), '\0');
+    if (!payload.empty())
+	boost::asio::buffer_copy(boost::asio::buffer(&payload[0], payload.size()), buffers);
+    gateway->Send(GATEWAY_DATA, session_, payload.data(), payload.size(),
+	std::move(handler));
+}
+
+//! Closes the session and tells the gateway to drop the client.
+//! \param errorCode set on failure
+void GatewayTransport::Close(ErrorCode& errorCode) noexcept {
+    errorCode.clear();
+    if (!open_)
+	return;
+
+    open_ = false;
+    if (auto gateway = gateway_.lock()) {
+	if (!remoteClosed_)
+	    gateway->Send(GATEWAY_CLOSE, session_);
+	gateway->EraseSession(session_);
+    }
+    this->CompleteRead();
+}
+
+//! Returns the remote address.
+Address GatewayTransport::GetAddress() const noexcept {
+    return address_;
+}
+
+//! Returns whether the session is open.
+bool GatewayTransport::IsOpen() const noexcept {
+    return open_;
+}
+
+//! Relays \c TCP_CORK to the gateway.
+//! \param cork whether to cork
+//! \return \c true if the gateway was told
+bool GatewayTransport::SetCork(const bool cork) noexcept {
+    auto gateway = gateway_.lock();
+    if (!open_ || remoteClosed_ || !gateway)
+	return false;
+
+    const char value = cork ? 1 : 0;
+    gateway->Send(GATEWAY_CORK, session_, &value, 1);
+    return true;
+}
+
+//! Queues bytes the gateway received from the client.
+//! \param data the bytes
+//! \param nBytes the number of bytes
+void GatewayTransport::Receive(
+	const char* data,
+	const std::size_t nBytes) {
+    if (!open_ || remoteClosed_)
+	return;
+    input_.append(data, nBytes);
+    this->CompleteRead();
+}
+
+//! Marks the client gone; the pending read completes with \c eof.
+void GatewayTransport::ReceiveClose() noexcept {
+    remoteClosed_ = true;
+    this->CompleteRead();
+}
+
+//! Completes the pending read if input, \c eof, or a close is due.
+void GatewayTransport::CompleteRead() {
+    if (!readHandler_)
+	return;
+
+    ErrorCode errorCode;
+    std::size_t nBytes = 0;
+    if (!open_) {
+	errorCode = boost::asio::error::operation_aborted;
+    } else if (!input_.empty()) {
+	nBytes = std::min(input_.size(), readBuffer_.size());
+	std::memcpy(readBuffer_.data(), input_.data(), nBytes);
+	input_.erase(0, nBytes);
+    } else if (remoteClosed_) {
+	errorCode = boost::asio::error::eof;
+    } else {
+	return;
+    }
+
+    // Complete from the I/O context, as a socket would.
+    auto handler = std::move(readHandler_);
+    readHandler_ = Handler();
+    boost::asio::post(ioContext_, [handler, errorCode, nBytes]() {
+	handler(errorCode, nBytes);
+    });
+}
+
+}; // namespace Net
+}; // namespace Scratch
@@ -0,0 +1,101 @@
+//! \file transport_tcp.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_TRANSPORT_TCP_CPP_
+
+#include <scratch/logger.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/transport_tcp.hpp>
+
+namespace Scratch {
+namespace Net {
+
+//! Constructor.
+//! \param socket the Boost socket
+TcpTransport::TcpTransport(Socket&& socket) noexcept :
+	socket_(std::move(socket)) {
+    // Nothing.
+}
+
+//! Destructor.
+TcpTransport::~TcpTransport() noexcept {
+    // Nothing.
+}
+
+//! Reads some bytes.
+//! \param buffer the buffer to fill
+//! \param handler the completion handler
+void TcpTransport::AsyncRead(
+	const MutableBuffer& buffer,
+	Handler handler) {
+    socket_.async_read_some(boost::asio::buffer(buffer), std::move(handler));
+}
+
+//! Writes every byte of \p buffers.
+//! \param buffers the bytes to write
+//! \param handler the completion handler
+void TcpTransport::AsyncWrite(
+	const ConstBuffersType& buffers,
+	Handler handler) {
+    boost::asio::async_write(socket_, buffers, std::move(handler));
+}
+
+//! Closes the socket.
+//! \param errorCode set on failure
+void TcpTransport::Close(ErrorCode& errorCode) noexcept {
+    socket_.close(errorCode);
+}
+
+//! Returns the remote address.
+Address TcpTransport::GetAddress() const noexcept {
+    ErrorCode errorCode;
+    return socket_.remote_endpoint(errorCode).address();
+}
+
+//! Returns the socket handle.
+int TcpTransport::GetNativeHandle() noexcept {
+    return socket_.native_handle();
+}
+
+//! Returns whether the socket is open.
+bool TcpTransport::IsOpen() const noexcept {
+    return socket_.is_open();
+}
+
+//! Disables Nagle; corking, not Nagle, batches replies.
+void TcpTransport::OnStart() {
+    ErrorCode errorCode;
+    socket_.set_option(boost::asio::ip::tcp::no_delay(true), errorCode);
+    if (errorCode) {
+	LOGGER_NETWORK() << "Error setting TCP_NODELAY.";
+	LOGGER_NETWORK() << " >> " << errorCode;
+	LOGGER_NETWORK() << " >> " << errorCode.message();
+    }
+}
+
+//! Sets or clears \c TCP_CORK.
+//! \param cork whether to cork
+//! \return \c true if the setting took effect
+//! \remark Clearing \c TCP_CORK pushes any partial frame immediately.
+bool TcpTransport::SetCork(const bool cork) noexcept {
+#ifdef TCP_CORK
+    const int value = cork ? 1 : 0;
+    if (::setsockopt(socket_.native_handle(), IPPROTO_TCP, TCP_CORK,
+	    &value, sizeof(value)) != 0) {
+	LOGGER_NETWORK() << "Error setting TCP_CORK.";
+	LOGGER_NETWORK() << " >> errno=" << errno;
+	return false;
+    }
+    return true;
+#else
+    return false;
+#endif // TCP_CORK
+}
+
+}; // namespace Net
+}; // namespace Scratch
@@ -26,8 +26,10 @@ User::User() noexcept :
 	metaColors_(),
 	password_(),
 	permissions_(),
+	permissionBits_(),
 	players_(),
-	preferences_() {
+	preferences_(),
+	preferenceBits_() {
     // Nothing.
 }
 
@@ -42,8 +44,10 @@ User::User(const User& other) noexcept :
 	metaColors_(other.metaColors_),
 	password_(other.password_),
 	permissions_(other.permissions_),
+	permissionBits_(other.permissionBits_),
 	players_(other.players_),
-	preferences_(other.preferences_) {
+	preferences_(other.preferences_),
+	preferenceBits_(other.preferenceBits_) {
     // Nothing.
 }
 
@@ -63,8 +67,10 @@ User& User::operator=(const User& other) noexcept {
     metaColors_ = other.metaColors_;
     password_ = other.password_;
     permissions_ = other.permissions_;
+    permissionBits_ = other.permissionBits_;
     players_ = other.players_;
     preferences_ = other.preferences_;
+    preferenceBits_ = other.preferenceBits_;
     return *this;
 }
 
@@ -148,6 +154,7 @@ void User::ReadPermissionsData(const DataPtr& data) noexcept {
 	if (!permission.empty())
 	    permissions_.insert(permission);
     }
+    SymbolTable::Permissions().MakeBits(permissions_, permissionBits_);
 }
 
 //! Reads players from a data node.
@@ -174,6 +181,7 @@ void User::ReadPreferencesData(const DataPtr& data) noexcept {
 	if (!preference.empty())
 	    preferences_.insert(preference);
     }
+    SymbolTable::Preferences().MakeBits(preferences_, preferenceBits_);
 }
 
 //! Reads time from a data node.
@@ -0,0 +1,142 @@
+//! \file work_pool.cpp
+//!
+//! \par Copyright
+//! Copyright (C) 1999-2026 scratchmud.org
+//! All rights reserved.
+//!
+//! \author Geoffrey Davis (gdavis@scratchmud.org)
+
+#define _SCRATCH_WORK_POOL_CPP_
+
+#include <scratch/logger.hpp>
+#include <scratch/scratch.hpp>
+#include <scratch/work_pool.hpp>
+
+namespace Scratch {
+namespace Utility {
+
+//! Constructor.
+//! \param threads the number of worker threads besides the caller;
+//!     zero runs every batch on the calling thread
+WorkPool::WorkPool(const std::size_t threads) :
+	done_(),
+	generation_(0),
+	mutex_(),
+	pending_(0),
+	queues_(),
+	steals_(0),
+	stopping_(false),
+	threads_(),
+	wake_() {
+    for (std::size_t n = 0; n <= threads; ++n)
+	queues_.emplace_back(new Queue());
+    for (std::size_t n = 1; n <= threads; ++n)
+	threads_.emplace_back(&WorkPool::Work, this, n);
+}
+
+//! Destructor.
+//! \remark Joins the worker threads.
+WorkPool::~WorkPool() noexcept {
+    {
+	std::lock_guard<std::mutex> lock(mutex_);
+	stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread: threads_)
+	thread.join();
+}
+
+//! Runs a batch of tasks.
+//! \param tasks the tasks, consumed
+//! \remark Blocks until every task has finished. Not reentrant.
+void WorkPool::Run(std::vector<Task>& tasks) {
+    if (tasks.empty())
+	return;
+
+    // Count first: a worker still draining the last batch may take a
+    // task as soon as it is queued.
+    {
+	std::lock_guard<std::mutex> lock(mutex_);
+	pending_ = tasks.size();
+    }
+
+    // Deal round-robin, starting with the caller's own queue.
+    for (std::size_t n = 0; n < tasks.size(); ++n) {
+	auto& queue = *queues_[n % queues_.size()];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	queue.tasks.push_back(std::move(tasks[n]));
+    }
+
+    // Start the batch once every task is queued, so a woken worker
+    // cannot find the queues empty and miss it.
+    {
+	std::lock_guard<std::mutex> lock(mutex_);
+	++generation_;
+    }
+    tasks.clear();
+    wake_.notify_all();
+
+    // Help out, then wait for tasks still running elsewhere.
+    while (this->RunOne(0))
+	continue;
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+}
+
+//! Runs one task from \p self's queue or, failing that, a stolen one.
+//! \param self the queue of the running thread
+//! \return \c false if every queue was empty
+bool WorkPool::RunOne(const std::size_t self) noexcept {
+    Task task;
+    for (std::size_t n = 0; n < queues_.size() && !task; ++n) {
+	auto& queue = *queues_[(self + n) % queues_.size()];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+	if (queue.tasks.empty())
+	    continue;
+	if (n == 0) {
+	    task = std::move(queue.tasks.back());
+	    queue.tasks.pop_back();
+	} else {
+	    task = std::move(queue.tasks.front());
+	    queue.tasks.pop_front();
+	    ++steals_;
+	}
+    }
+    if (!task)
+	return false;
+
+    try {
+	task();
+    } catch (const std::exception& ex) {
+	LOGGER_SYSTEM() << "Work pool task failed: " << ex.what();
+    } catch (...) {
+	LOGGER_SYSTEM() << "Work pool task failed.";
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0)
+	done_.notify_all();
+    return true;
+}
+
+//! The worker thread loop.
+//! \param self the queue of this thread
+void WorkPool::Work(const std::size_t self) noexcept {
+    std::uint64_t seen = 0;
+    for (;;) {
+	{
+	    std::unique_lock<std::mutex> lock(mutex_);
+	    wake_.wait(lock, [this, seen] {
+		return stopping_ || generation_ != seen;
+	    });
+	    if (stopping_)
+		return;
+	    seen = generation_;
+	}
+	while (this->RunOne(self))
+	    continue;
+    }
+}
+
+}; // namespace Utility
+}; // namespace Scratch